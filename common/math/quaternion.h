@@ -78,6 +78,8 @@ namespace embree
   template<typename T> __forceinline QuaternionT<T> rcp       ( const QuaternionT<T>& a ) { return conj(a)*rcp(a.r*a.r + a.i*a.i + a.j*a.j + a.k*a.k); }
   template<typename T> __forceinline QuaternionT<T> normalize ( const QuaternionT<T>& a ) { return a*rsqrt(a.r*a.r + a.i*a.i + a.j*a.j + a.k*a.k); }
 
+  template<typename T> __forceinline T dot( const QuaternionT<T>& a, const QuaternionT<T>& b ) { return a.r*b.r + a.i*b.i + a.j*b.j + a.k*b.k; }
+
   ////////////////////////////////////////////////////////////////
   // Binary Operators
   ////////////////////////////////////////////////////////////////
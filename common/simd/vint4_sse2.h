@@ -92,11 +92,13 @@ namespace embree
     static __forceinline void storeu( const vboolf4& mask, void* ptr, const vint4& i ) { storeu(ptr,select(mask,i,loadu(ptr))); }
 #endif
 
-    #if defined(__SSE4_1__)
     static __forceinline vint4 load( const unsigned char* const ptr ) {
+#if defined(__SSE4_1__)
       return _mm_cvtepu8_epi32(_mm_load_si128((__m128i*)ptr));
-    }
+#else
+      return vint4(ptr[0],ptr[1],ptr[2],ptr[3]);
 #endif
+    }
 
     static __forceinline vint4 load(const unsigned short* const ptr) {
 #if defined (__SSE4_1__)
@@ -68,6 +68,43 @@ namespace embree
     if (bytes == 0) return;
     VirtualFree(ptr,0,MEM_RELEASE);
   }
+
+  void os_numa_policy(void* ptr, size_t bytes, NumaPolicy policy) {
+  }
+
+  size_t os_numa_nodes() {
+    ULONG highestNode = 0;
+    if (!GetNumaHighestNodeNumber(&highestNode)) return 1;
+    return highestNode+1;
+  }
+
+  void* os_map_file(const char* fileName, size_t& bytes)
+  {
+    HANDLE file = CreateFileA(fileName,GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file,&size) || size.QuadPart == 0) { CloseHandle(file); return nullptr; }
+    bytes = (size_t) size.QuadPart;
+
+    HANDLE mapping = CreateFileMappingA(file,nullptr,PAGE_WRITECOPY,0,0,nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) return nullptr;
+
+    void* ptr = MapViewOfFile(mapping,FILE_MAP_COPY,0,0,bytes);
+    CloseHandle(mapping);
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes) {
+    if (ptr) UnmapViewOfFile(ptr);
+  }
+
+  void os_release_file_pages(void* ptr, size_t bytes) 
+  {
+    /* unlocking pages that are not locked removes them from the working set */
+    if (ptr && bytes) VirtualUnlock(ptr,bytes);
+  }
 }
 #endif
 
@@ -78,9 +115,16 @@ namespace embree
 #if defined(__UNIX__)
 
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
+#if defined(__LINUX__)
+#include <sys/syscall.h>
+#include <dirent.h>
+#endif
 
 /* hint for transparent huge pages (THP) */
 #if defined(__MACOSX__)
@@ -208,6 +252,91 @@ namespace embree
     if (munmap(ptr,bytes) == -1)
       throw std::bad_alloc();
   }
+
+#if defined(__LINUX__)
+
+  /* memory policies of the mbind system call, we call the kernel
+   * directly to not depend on libnuma */
+#define EMBREE_MPOL_DEFAULT    0
+#define EMBREE_MPOL_INTERLEAVE 3
+#define EMBREE_MPOL_LOCAL      4
+
+  size_t os_numa_nodes()
+  {
+    static ssize_t numNodes = -1;
+    if (numNodes != -1) return numNodes;
+
+    /* count node directories in sysfs */
+    ssize_t N = 0;
+    if (DIR* dir = opendir("/sys/devices/system/node")) {
+      while (struct dirent* entry = readdir(dir)) 
+        if (strncmp(entry->d_name,"node",4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9') N++;
+      closedir(dir);
+    }
+    return numNodes = N > 0 ? N : 1;
+  }
+
+  void os_numa_policy(void* ptr, size_t bytes, NumaPolicy policy)
+  {
+    if (policy == NUMA_DEFAULT || bytes == 0) return;
+    const size_t numNodes = os_numa_nodes();
+    if (numNodes <= 1) return;
+
+    if (policy == NUMA_INTERLEAVE) 
+    {
+      unsigned long nodemask[4] = { 0, 0, 0, 0 };
+      const size_t N = numNodes < 8*sizeof(nodemask) ? numNodes : 8*sizeof(nodemask);
+      for (size_t i=0; i<N; i++) nodemask[i/(8*sizeof(unsigned long))] |= 1ul << (i%(8*sizeof(unsigned long)));
+      syscall(SYS_mbind,ptr,bytes,EMBREE_MPOL_INTERLEAVE,nodemask,N+1,0);
+    }
+    else if (policy == NUMA_LOCAL)
+      syscall(SYS_mbind,ptr,bytes,EMBREE_MPOL_LOCAL,nullptr,0,0);
+  }
+
+#else
+
+  size_t os_numa_nodes() {
+    return 1;
+  }
+
+  void os_numa_policy(void* ptr, size_t bytes, NumaPolicy policy) {
+  }
+
+#endif
+
+  void* os_map_file(const char* fileName, size_t& bytes)
+  {
+    int fd = open(fileName,O_RDONLY);
+    if (fd == -1) return nullptr;
+
+    struct stat st;
+    if (fstat(fd,&st) == -1 || st.st_size == 0) { close(fd); return nullptr; }
+    bytes = (size_t) st.st_size;
+
+    /* private mapping, pages are only loaded when touched and modified pages get copied */
+    void* ptr = mmap(nullptr,bytes,PROT_READ|PROT_WRITE,MAP_PRIVATE,fd,0);
+    close(fd);
+    if (ptr == MAP_FAILED) return nullptr;
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes) 
+  {
+    if (ptr == nullptr) return;
+    if (munmap(ptr,bytes) == -1)
+      throw std::bad_alloc();
+  }
+
+  void os_release_file_pages(void* ptr, size_t bytes) 
+  {
+    if (ptr == nullptr || bytes == 0) return;
+
+    /* pages at the borders may be shared with neighbouring data, these are simply read again when touched */
+    const size_t pageSize = sysconf(_SC_PAGESIZE);
+    const size_t begin = size_t(ptr) & ~(pageSize-1);
+    const size_t end   = (size_t(ptr)+bytes+pageSize-1) & ~(pageSize-1);
+    madvise((void*)begin,end-begin,MADV_DONTNEED);
+  }
 }
 
 #endif
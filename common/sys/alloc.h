@@ -91,6 +91,26 @@ namespace embree
   size_t os_shrink (void* ptr, size_t bytesNew, size_t bytesOld);
   void  os_free   (void* ptr, size_t bytes);
 
+  /*! NUMA placement policies for OS allocations */
+  enum NumaPolicy {
+    NUMA_DEFAULT = 0,    //!< keeps the placement policy of the process
+    NUMA_INTERLEAVE = 1, //!< interleaves pages across all NUMA nodes
+    NUMA_LOCAL = 2,      //!< places pages on the node of the thread touching them first
+  };
+
+  /*! applies NUMA placement policy to pages that are not touched yet */
+  void os_numa_policy(void* ptr, size_t bytes, NumaPolicy policy);
+
+  /*! returns the number of NUMA nodes of the system */
+  size_t os_numa_nodes();
+
+  /*! maps a file copy-on-write into memory, returns nullptr if the file cannot get opened */
+  void* os_map_file  (const char* fileName, size_t& bytes);
+  void  os_unmap_file(void* ptr, size_t bytes);
+
+  /*! drops the resident pages of some unmodified range of a mapped file, touching the range again reads it back from the file */
+  void os_release_file_pages(void* ptr, size_t bytes);
+
   /*! allocator that performs OS allocations */
   template<typename T>
     struct os_allocator
@@ -355,6 +355,7 @@ namespace embree
 
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
+#include <vector>
 
 namespace embree
 {
@@ -392,6 +393,44 @@ namespace embree
     return nThreads;
   }
 
+  size_t getCurrentSocket()
+  {
+    typedef BOOL (WINAPI *GetLogicalProcessorInformationExFunc)(LOGICAL_PROCESSOR_RELATIONSHIP, PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX, PDWORD);
+    typedef VOID (WINAPI *GetCurrentProcessorNumberExFunc)(PPROCESSOR_NUMBER);
+    static HMODULE hlib = LoadLibrary("Kernel32");
+    static GetLogicalProcessorInformationExFunc pGetLogicalProcessorInformationEx = (GetLogicalProcessorInformationExFunc)GetProcAddress(hlib, "GetLogicalProcessorInformationEx");
+    static GetCurrentProcessorNumberExFunc      pGetCurrentProcessorNumberEx      = (GetCurrentProcessorNumberExFunc)     GetProcAddress(hlib, "GetCurrentProcessorNumberEx");
+    if (!pGetLogicalProcessorInformationEx || !pGetCurrentProcessorNumberEx) return 0;
+
+    /* read the processors of each physical package only once, a package may span several processor groups */
+    static const std::vector<std::vector<GROUP_AFFINITY>> packages = [] ()
+    {
+      std::vector<std::vector<GROUP_AFFINITY>> packages;
+      DWORD bytes = 0;
+      pGetLogicalProcessorInformationEx(RelationProcessorPackage,nullptr,&bytes);
+      if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) return packages;
+      std::vector<char> buffer(bytes);
+      if (!pGetLogicalProcessorInformationEx(RelationProcessorPackage,(PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer.data(),&bytes)) return packages;
+      
+      for (DWORD ofs=0; ofs<bytes; )
+      {
+        PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)&buffer[ofs];
+        if (info->Relationship == RelationProcessorPackage) 
+          packages.push_back(std::vector<GROUP_AFFINITY>(info->Processor.GroupMask,info->Processor.GroupMask+info->Processor.GroupCount));
+        ofs += info->Size;
+      }
+      return packages;
+    }();
+
+    PROCESSOR_NUMBER processor;
+    pGetCurrentProcessorNumberEx(&processor);
+    for (size_t i=0; i<packages.size(); i++)
+      for (size_t j=0; j<packages[i].size(); j++)
+        if (packages[i][j].Group == processor.Group && (packages[i][j].Mask & (KAFFINITY(1) << processor.Number)))
+          return i;
+    return 0;
+  }
+
   int getTerminalWidth() 
   {
     HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -423,6 +462,8 @@ namespace embree
 
 #include <stdio.h>
 #include <unistd.h>
+#include <sched.h>
+#include <vector>
 
 namespace embree
 {
@@ -434,6 +475,29 @@ namespace embree
     if (bytes != -1) buf[bytes] = '\0';
     return std::string(buf);
   }
+
+  size_t getCurrentSocket()
+  {
+    /* read the physical package of each processor only once */
+    static const std::vector<size_t> sockets = [] () 
+    {
+      std::vector<size_t> sockets(getNumberOfLogicalThreads(),0);
+      for (size_t i=0; i<sockets.size(); i++) 
+      {
+        char path[128]; sprintf(path, "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", int(i));
+        FILE* file = fopen(path,"r");
+        if (!file) continue;
+        int id = 0;
+        if (fscanf(file,"%d",&id) == 1 && id >= 0) sockets[i] = id;
+        fclose(file);
+      }
+      return sockets;
+    }();
+
+    const int cpu = sched_getcpu();
+    if (cpu < 0 || size_t(cpu) >= sockets.size()) return 0;
+    return sockets[cpu];
+  }
 }
 
 #endif
@@ -455,6 +519,10 @@ namespace embree
     if (_NSGetExecutablePath(buf, &size) != 0) return std::string();
     return std::string(buf);
   }
+
+  size_t getCurrentSocket() {
+    return 0;
+  }
 }
 
 #endif
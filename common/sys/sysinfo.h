@@ -167,6 +167,9 @@ namespace embree
 
   /*! return the number of logical threads of the system */
   size_t getNumberOfLogicalThreads();
+
+  /*! returns the socket of the processor the calling thread currently runs on */
+  size_t getCurrentSocket();
   
   /*! returns the size of the terminal window in characters */
   int getTerminalWidth();
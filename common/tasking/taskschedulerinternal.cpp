@@ -29,23 +29,27 @@ namespace embree
   template<typename Predicate, typename Body>
   __forceinline void TaskScheduler::steal_loop(Thread& thread, const Predicate& pred, const Body& body)
   {
+    /* exponential backoff when stealing fails: spin first, then yield, and finally sleep */
+    size_t spins = 1, yields = 0;
     while (true)
     {
-      /*! some rounds that yield */
-      for (size_t i=0; i<32; i++)
-      {
-        /*! some spinning rounds */
-        const size_t threadCount = thread.threadCount();
-        for (size_t j=0; j<1024; j+=threadCount)
-        {
-          if (!pred()) return;
-          if (thread.scheduler->steal_from_other_threads(thread)) {
-            i=j=0;
-            body();
-          }
-        }
+      if (!pred()) return;
+      if (thread.scheduler->steal_from_other_threads(thread)) {
+        spins = 1; yields = 0;
+        body();
+        continue;
+      }
+      
+      if (spins <= 1024) {
+        for (size_t i=0; i<spins; i++) __pause_cpu();
+        spins *= 2;
+      }
+      else if (yields < 64) {
+        yields++;
         yield();
       }
+      else
+        sleepSeconds(50E-6);
     }
   }
 
@@ -78,23 +82,70 @@ namespace embree
       parent->add_dependencies(-1);
   }
 
+  __dllexport TaskScheduler::TaskQueue::TaskQueue ()
+    : numBlocks(0), left(0), right(0), numClosureBlocks(0), stackPtr(0) 
+  {
+    for (size_t i=0; i<MAX_TASK_BLOCKS; i++) blocks[i].store(nullptr);
+    for (size_t i=0; i<MAX_CLOSURE_BLOCKS; i++) closureBlocks[i] = nullptr;
+    grow();
+    growClosures(0,0);
+  }
+
+  __dllexport TaskScheduler::TaskQueue::~TaskQueue () 
+  {
+    for (size_t i=0; i<numBlocks; i++)
+      alignedFree(blocks[i].load());
+    for (size_t i=0; i<numClosureBlocks; i++)
+      alignedFree(closureBlocks[i]);
+  }
+
+  __dllexport void TaskScheduler::TaskQueue::grow()
+  {
+    if (numBlocks >= MAX_TASK_BLOCKS)
+      THROW_RUNTIME_ERROR("task stack overflow");
+
+    /* the new block has to be visible to stealing threads before the right pointer moves into it */
+    Task* block = (Task*) alignedMalloc(TASK_BLOCK_SIZE*sizeof(Task),64);
+    for (size_t i=0; i<TASK_BLOCK_SIZE; i++) new (&block[i]) Task;
+    blocks[numBlocks].store(block);
+    numBlocks++;
+  }
+
+  __dllexport size_t TaskScheduler::TaskQueue::growClosures(size_t ofs, size_t bytes)
+  {
+    if (bytes > CLOSURE_BLOCK_SIZE)
+      THROW_RUNTIME_ERROR("task closure too large");
+
+    /* skip the rest of the current block if the closure does not fit into it anymore */
+    if (bytes && ofs/CLOSURE_BLOCK_SIZE != (ofs+bytes-1)/CLOSURE_BLOCK_SIZE)
+      ofs = (ofs/CLOSURE_BLOCK_SIZE+1)*CLOSURE_BLOCK_SIZE;
+
+    /* blocks stay allocated when the stack shrinks again, so we only allocate when we reach a new block */
+    const size_t requiredBlocks = (ofs+max(bytes,size_t(1))+CLOSURE_BLOCK_SIZE-1)/CLOSURE_BLOCK_SIZE;
+    if (requiredBlocks > MAX_CLOSURE_BLOCKS)
+      THROW_RUNTIME_ERROR("task closure stack overflow");
+    while (numClosureBlocks < requiredBlocks)
+      closureBlocks[numClosureBlocks++] = (char*) alignedMalloc(CLOSURE_BLOCK_SIZE,64);
+    return ofs;
+  }
+
   __dllexport bool TaskScheduler::TaskQueue::execute_local(Thread& thread, Task* parent)
   {
     /* stop if we run out of local tasks or reach the waiting task */
-    if (right == 0 || &tasks[right-1] == parent)
+    if (right == 0 || &task(right-1) == parent)
       return false;
     
     /* execute task */
     size_t oldRight = right;
-    tasks[right-1].run(thread);
+    task(right-1).run(thread);
     if (right != oldRight) {
       THROW_RUNTIME_ERROR("you have to wait for spawned subtasks");
     }
     
     /* pop task and closure from stack */
     right--;
-    if (tasks[right].stackPtr != -1)
-      stackPtr = tasks[right].stackPtr;
+    if (task(right).stackPtr != -1)
+      stackPtr = task(right).stackPtr;
     
     /* also move left pointer */
     if (left >= right) left.store(right.load());
@@ -110,7 +161,8 @@ namespace embree
     else 
       return false;
     
-    if (!tasks[l].try_steal(thread.tasks.tasks[thread.tasks.right]))
+    thread.tasks.reserve();
+    if (!task(l).try_steal(thread.tasks.task(thread.tasks.right)))
       return false;
     
     thread.tasks.right++;
@@ -121,7 +173,7 @@ namespace embree
   size_t TaskScheduler::TaskQueue::getTaskSizeAtLeft() 
   {	
     if (left >= right) return 0;
-    return tasks[left].N;
+    return task(left).N;
   }
 
   static MutexSys g_mutex;
@@ -136,7 +188,7 @@ namespace embree
   }
 
   TaskScheduler::ThreadPool::ThreadPool(bool set_affinity)
-    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false) {}
+    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false), generation(0) {}
 
   __dllexport void TaskScheduler::ThreadPool::startThreads()
   {
@@ -195,6 +247,7 @@ namespace embree
   {
     mutex.lock();
     schedulers.push_back(scheduler);
+    generation++; // lets busy worker threads reconsider which scheduler to work for
     mutex.unlock();
     condition.notify_all();
   }
@@ -220,17 +273,49 @@ namespace embree
         Lock<MutexSys> lock(mutex);
         condition.wait(mutex, [&] () { return globalThreadIndex >= numThreadsRunning || !schedulers.empty(); });
         if (globalThreadIndex >= numThreadsRunning) break;
-        scheduler = schedulers.front();
+        scheduler = select_scheduler();
         threadIndex = scheduler->allocThreadIndex();
       }
-      scheduler->thread_loop(threadIndex);
+      scheduler->thread_loop(threadIndex,true);
     }
   }
   
-  TaskScheduler::TaskScheduler()
-    : threadCounter(0), anyTasksRunning(0), hasRootTask(false) 
+  Ref<TaskScheduler> TaskScheduler::ThreadPool::select_scheduler()
   {
-    threadLocal.resize(2*getNumberOfLogicalThreads()); // FIXME: this has to be 2x as in the join mode the worker threads also join
+    /* join the scheduler of highest priority, and share the threads
+     * equally among schedulers of the same priority */
+    Ref<TaskScheduler> best = schedulers.front();
+    for (std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin(); it != schedulers.end(); it++) 
+    {
+      const Ref<TaskScheduler>& scheduler = *it;
+      if (scheduler->anyTasksRunning == 0) continue;
+      if (best->anyTasksRunning == 0 ||
+          scheduler->priority > best->priority ||
+          (scheduler->priority == best->priority && scheduler->activeThreads < best->activeThreads))
+        best = scheduler;
+    }
+    return best;
+  }
+
+  bool TaskScheduler::ThreadPool::should_leave(TaskScheduler* scheduler)
+  {
+    Lock<MutexSys> lock(mutex);
+    if (schedulers.empty()) return false;
+    Ref<TaskScheduler> best = select_scheduler();
+    if (best.ptr == scheduler || best->anyTasksRunning == 0) return false;
+    if (best->priority != scheduler->priority) return best->priority > scheduler->priority;
+
+    /* only move between schedulers of the same priority if this balances the threads */
+    return best->activeThreads+1 < scheduler->activeThreads;
+  }
+  
+  TaskScheduler::TaskScheduler(int priority)
+    : threadCounter(0), activeThreads(0), anyTasksRunning(0), hasRootTask(false), priority(priority)
+  {
+    /* the thread pool may have more threads than the machine, and in the join mode the worker threads also join */
+    size_t numThreads = getNumberOfLogicalThreads();
+    if (threadPool) numThreads = max(numThreads,threadPool->size());
+    threadLocal.resize(2*numThreads);
     for (size_t i=0; i<threadLocal.size(); i++)
       threadLocal[i].store(nullptr);
   }
@@ -272,6 +357,16 @@ namespace embree
 
   __dllexport ssize_t TaskScheduler::allocThreadIndex()
   {
+    activeThreads++;
+
+    /* reuse the index of a thread that left early */
+    Lock<MutexSys> lock(threadIndexMutex);
+    if (!freeThreadIndices.empty()) {
+      const size_t threadIndex = freeThreadIndices.back();
+      freeThreadIndices.pop_back();
+      return threadIndex;
+    }
+
     size_t threadIndex = threadCounter++;
     assert(threadIndex < threadLocal.size());
     return threadIndex;
@@ -316,7 +411,7 @@ namespace embree
     return thread->scheduler->cancellingException == nullptr;
   }
 
-  std::exception_ptr TaskScheduler::thread_loop(size_t threadIndex)
+  std::exception_ptr TaskScheduler::thread_loop(size_t threadIndex, bool mayLeave)
   {
     /* allocate thread structure */
     std::unique_ptr<Thread> mthread(new Thread(threadIndex,this)); // too large for stack allocation
@@ -324,11 +419,21 @@ namespace embree
     threadLocal[threadIndex].store(&thread);
     Thread* oldThread = swapThread(&thread);
 
-    /* main thread loop */
-    while (anyTasksRunning)
+    /* main thread loop, the thread holds no tasks when the predicate gets
+     * evaluated, thus it can leave for a scheduler that was added later and
+     * needs the thread more urgently */
+    size_t generation = mayLeave ? threadPool->getGeneration() : 0;
+    bool leave = false;
+    while (anyTasksRunning && !leave)
     {
       steal_loop(thread,
-                 [&] () { return anyTasksRunning > 0; },
+                 [&] () { 
+                   if (mayLeave && threadPool->getGeneration() != generation) {
+                     generation = threadPool->getGeneration();
+                     leave = threadPool->should_leave(this);
+                   }
+                   return anyTasksRunning > 0 && !leave; 
+                 },
                  [&] () { 
                    anyTasksRunning++;
                    while (thread.tasks.execute_local(thread,nullptr));
@@ -338,13 +443,24 @@ namespace embree
     threadLocal[threadIndex].store(nullptr);
     swapThread(oldThread);
 
+    /* other threads may still try to steal from the empty task queue of a
+     * thread that left, thus it stays alive until the scheduler finished */
+    if (leave) 
+    {
+      Lock<MutexSys> lock(threadIndexMutex);
+      retiredThreads.push_back(std::move(mthread));
+      freeThreadIndices.push_back(threadIndex);
+      activeThreads--;
+      return nullptr;
+    }
+
     /* remember exception to throw */
     std::exception_ptr except = nullptr;
     if (cancellingException != nullptr) except = cancellingException;
 
     /* wait for all threads to terminate */
-    threadCounter--;
-    while (threadCounter > 0) yield();
+    activeThreads--;
+    while (activeThreads > 0) yield();
     return except;
   }
 
@@ -353,18 +469,24 @@ namespace embree
     const size_t threadIndex = thread.threadIndex;
     const size_t threadCount = this->threadCounter;
 
-    for (size_t i=1; i<threadCount; i++) 
+    /* first try victims on our own socket, then remote ones */
+    for (size_t remote=0; remote<2; remote++)
     {
-      __pause_cpu(32);
-      size_t otherThreadIndex = threadIndex+i;
-      if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
-
-      Thread* othread = threadLocal[otherThreadIndex].load();
-      if (!othread)
-        continue;
-
-      if (othread->tasks.steal(thread)) 
-        return true;      
+      for (size_t i=1; i<threadCount; i++) 
+      {
+        size_t otherThreadIndex = threadIndex+i;
+        if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
+        
+        Thread* othread = threadLocal[otherThreadIndex].load();
+        if (!othread)
+          continue;
+        
+        if ((othread->socket != thread.socket) != bool(remote))
+          continue;
+        
+        if (othread->tasks.steal(thread)) 
+          return true;      
+      }
     }
 
     return false;
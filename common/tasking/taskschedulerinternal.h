@@ -24,6 +24,7 @@
 #include "../sys/condition.h"
 #include "../sys/ref.h"
 #include "../sys/atomic.h"
+#include "../sys/sysinfo.h"
 #include "../../kernels/algorithms/range.h"
 
 #include <list>
@@ -53,8 +54,10 @@ namespace embree
     ALIGNED_STRUCT;
     friend class Device;
 
-    static const size_t TASK_STACK_SIZE = 2*1024;           //!< task structure stack, FIXME: gcc-baxsed run throws assertion
-    static const size_t CLOSURE_STACK_SIZE = 256*1024;    //!< stack for task closures
+    static const size_t TASK_BLOCK_SIZE = 1024;            //!< number of tasks per block of the task stack
+    static const size_t MAX_TASK_BLOCKS = 1024;            //!< maximal number of task blocks per thread
+    static const size_t CLOSURE_BLOCK_SIZE = 256*1024;    //!< bytes per block of the closure stack
+    static const size_t MAX_CLOSURE_BLOCKS = 256;          //!< maximal number of closure blocks per thread
 
     struct Thread;
     
@@ -158,24 +161,45 @@ namespace embree
 
     struct TaskQueue
     {
-      TaskQueue ()
-      : left(0), right(0), stackPtr(0) {}
+      __dllexport TaskQueue ();
+      __dllexport ~TaskQueue ();
       
-      __forceinline void* alloc(size_t bytes, size_t align = 64) {
-        stackPtr += bytes + ((align - stackPtr) & (align-1));
-        assert(stackPtr <= CLOSURE_STACK_SIZE);
-        return &stack[stackPtr-bytes];
+      /*! allocates a closure on the closure stack, a closure never straddles two blocks */
+      __forceinline void* alloc(size_t bytes, size_t align = 64) 
+      {
+        size_t ofs = stackPtr + ((align - stackPtr) & (align-1));
+        if (unlikely(ofs+bytes > numClosureBlocks*CLOSURE_BLOCK_SIZE || ofs/CLOSURE_BLOCK_SIZE != (ofs+bytes-1)/CLOSURE_BLOCK_SIZE))
+          ofs = growClosures(ofs,bytes);
+        stackPtr = ofs+bytes;
+        return &closureBlocks[ofs/CLOSURE_BLOCK_SIZE][ofs%CLOSURE_BLOCK_SIZE];
+      }
+
+      /*! moves a closure that does not fit into the current block to the start of the next block, already allocated blocks never move */
+      __dllexport size_t growClosures(size_t ofs, size_t bytes);
+
+      /*! returns the i'th task of the task stack */
+      __forceinline Task& task(size_t i) {
+        return blocks[i/TASK_BLOCK_SIZE].load()[i%TASK_BLOCK_SIZE];
+      }
+
+      /*! makes sure there is space for one more task on the right side of the stack */
+      __forceinline void reserve() {
+        if (unlikely(right >= numBlocks*TASK_BLOCK_SIZE)) grow();
       }
+
+      /*! adds another block of tasks, already allocated blocks never move */
+      __dllexport void grow();
       
       template<typename Closure>
       __forceinline void push_right(Thread& thread, const size_t size, const Closure& closure) 
       {
-        assert(right < TASK_STACK_SIZE);
+        reserve();
         
 	/* allocate new task on right side of stack */
         size_t oldStackPtr = stackPtr;
         TaskFunction* func = new (alloc(sizeof(ClosureTaskFunction<Closure>))) ClosureTaskFunction<Closure>(closure);
-        new (&tasks[right++]) Task(func,thread.task,oldStackPtr,size);
+        new (&task(right)) Task(func,thread.task,oldStackPtr,size);
+        right++;
 
 	/* also move left pointer */
 	if (left >= right-1) left = right-1;
@@ -189,13 +213,15 @@ namespace embree
 
     public:
 
-      /* task stack */
-      Task tasks[TASK_STACK_SIZE];
+      /* task stack, grows in blocks of TASK_BLOCK_SIZE tasks */
+      std::atomic<Task*> blocks[MAX_TASK_BLOCKS];
+      size_t numBlocks;
       __aligned(64) std::atomic<size_t> left;   //!< threads steal from left
       __aligned(64) std::atomic<size_t> right;  //!< new tasks are added to the right
       
-      /* closure stack */
-      __aligned(64) char stack[CLOSURE_STACK_SIZE];
+      /* closure stack, grows in blocks of CLOSURE_BLOCK_SIZE bytes */
+      char* closureBlocks[MAX_CLOSURE_BLOCKS];
+      size_t numClosureBlocks;
       size_t stackPtr;
     };
     
@@ -205,13 +231,14 @@ namespace embree
       ALIGNED_STRUCT;
 
       Thread (size_t threadIndex, const Ref<TaskScheduler>& scheduler)
-      : threadIndex(threadIndex), scheduler(scheduler), task(nullptr) {}
+      : threadIndex(threadIndex), socket(getCurrentSocket()), scheduler(scheduler), task(nullptr) {}
 
       __forceinline size_t threadCount() {
         return scheduler->threadCounter;
       }
       
       size_t threadIndex;              //!< ID of this thread
+      size_t socket;                   //!< socket this thread was started on
       TaskQueue tasks;                 //!< local task queue
       Task* task;                      //!< current active task
       Ref<TaskScheduler> scheduler;     //!< pointer to task scheduler
@@ -240,12 +267,22 @@ namespace embree
 
       /*! main loop for all threads */
       void thread_loop(size_t threadIndex);
+
+      /*! selects the task scheduler a worker thread should join next */
+      Ref<TaskScheduler> select_scheduler();
+
+      /*! returns true if a worker thread of some scheduler should rather join a different scheduler */
+      bool should_leave(TaskScheduler* scheduler);
+
+      /*! returns a counter that increases whenever a scheduler gets added */
+      __forceinline size_t getGeneration() const { return generation; }
       
     private:
       std::atomic<size_t> numThreads;
       std::atomic<size_t> numThreadsRunning;
       bool set_affinity;
       std::atomic<bool> running;
+      std::atomic<size_t> generation;
       std::vector<thread_t> threads;
 
     private:
@@ -254,7 +291,7 @@ namespace embree
       std::list<Ref<TaskScheduler> > schedulers;
     };
 
-    TaskScheduler ();
+    TaskScheduler (int priority = 0);
     ~TaskScheduler ();
 
     /*! initializes the task scheduler */
@@ -273,8 +310,8 @@ namespace embree
     /*! wait for some number of threads available (threadCount includes main thread) */
     void wait_for_threads(size_t threadCount);
 
-    /*! thread loop for all worker threads */
-    std::exception_ptr thread_loop(size_t threadIndex);
+    /*! thread loop for all worker threads, threads of the thread pool may leave before all tasks finished */
+    std::exception_ptr thread_loop(size_t threadIndex, bool mayLeave = false);
 
     /*! steals a task from a different thread */
     bool steal_from_other_threads(Thread& thread);
@@ -317,9 +354,12 @@ namespace embree
       if (cancellingException != nullptr) except = cancellingException;
 
       /* wait for all threads to terminate */
-      threadCounter--;
-      while (threadCounter > 0) yield();
+      activeThreads--;
+      while (activeThreads > 0) yield();
       cancellingException = nullptr;
+      threadCounter = 0;
+      freeThreadIndices.clear();
+      retiredThreads.clear();
 
       /* re-throw proper exception */
       if (except != nullptr) 
@@ -388,9 +428,14 @@ namespace embree
 
   private:
     std::vector<atomic<Thread*>> threadLocal;
-    std::atomic<size_t> threadCounter;
+    std::atomic<size_t> threadCounter;    //!< number of allocated thread indices
+    std::atomic<size_t> activeThreads;    //!< number of threads currently working on this scheduler
+    MutexSys threadIndexMutex;            //!< protects the two vectors below
+    std::vector<size_t> freeThreadIndices;               //!< indices of threads that left early
+    std::vector<std::unique_ptr<Thread>> retiredThreads; //!< threads that left early, other threads may still try to steal from them
     std::atomic<size_t> anyTasksRunning;
     std::atomic<bool> hasRootTask;
+    int priority;                        //!< worker threads prefer schedulers of higher priority
     std::exception_ptr cancellingException;
     MutexSys mutex;
     ConditionSys condition;
@@ -162,6 +162,20 @@ enum RTCParameter {
   RTC_CONFIG_HAIR_GEOMETRY = 20,              //!< checks if hair geometries are supported
   RTC_CONFIG_SUBDIV_GEOMETRY = 21,           //!< checks if subdiv geometries are supported
   RTC_CONFIG_USER_GEOMETRY = 22,             //!< checks if user geometries are supported
+
+  RTC_MEMORY_POOL_CACHED_BYTES = 23,         //!< returns number of bytes currently cached by the build memory pool (read only)
+  RTC_MEMORY_POOL_REUSED_BYTES = 24,         //!< returns number of bytes the build memory pool served from its cache (read only)
+
+  RTC_SOFTWARE_CACHE_HITS = 25,              //!< returns number of lookups served by the software cache (read only)
+  RTC_SOFTWARE_CACHE_MISSES = 26,            //!< returns number of lookups that had to fill the software cache (read only)
+  RTC_SOFTWARE_CACHE_FLUSHES = 27,           //!< returns number of times the software cache evicted entries (read only)
+
+  RTC_STAT_RAYS_INTERSECTED = 28,            //!< returns number of rays passed to any rtcIntersect function of the device (read only)
+  RTC_STAT_RAYS_OCCLUDED = 29,               //!< returns number of rays passed to any rtcOccluded function of the device (read only)
+  RTC_STAT_NODES_VISITED = 30,               //!< returns number of BVH nodes visited by single ray traversal (read only)
+  RTC_STAT_LEAVES_VISITED = 31,              //!< returns number of BVH leaves visited by single ray traversal (read only)
+  RTC_STAT_BUILDS = 32,                      //!< returns number of acceleration structure builds (read only)
+  RTC_STAT_BUILD_TIME = 33,                  //!< returns total time spent in acceleration structure builds in microseconds (read only)
 };
 
 /*! \brief Configures some parameters. 
@@ -23,6 +23,9 @@
 /*! invalid geometry ID */
 #define RTC_INVALID_GEOMETRY_ID ((unsigned)-1)
 
+/*! maximal number of time steps of triangle and quad meshes */
+#define RTC_MAX_TIME_STEPS 129
+
 /*! \brief Specifies the type of buffers when mapping buffers */
 enum RTCBufferType {
   RTC_INDEX_BUFFER         = 0x01000000,
@@ -127,9 +130,12 @@ RTCORE_API unsigned rtcNewInstance (RTCScene target,                  //!< the s
 
   A scene instance contains a reference to a scene to instantiate and
   the transformation to instantiate the scene with. For motion blurred
-  instances, a number of timesteps can get specified (currently only 1
-  or 2 timesteps are supported). An implementation will typically
-  transform the ray with the inverse of the provided transformation
+  instances, a number of timesteps can get specified (1 to
+  RTC_MAX_TIME_STEPS). The transformations of neighbouring timesteps
+  get interpolated with a spherical interpolation of their rotation
+  and a linear interpolation of their translation and scale. An
+  implementation will typically transform the ray with the inverse of
+  the provided transformation
   and continue traversing the ray through the provided scene. If any
   geometry is hit, the instance ID (instID) member of the ray will get
   set to the geometry ID of the instance. */
@@ -155,13 +161,16 @@ RTCORE_API void rtcSetTransform2 (RTCScene scene,                         //!< s
 
 /*! \brief Creates a new triangle mesh. The number of triangles
   (numTriangles), number of vertices (numVertices), and number of time
-  steps (1 for normal meshes, and 2 for linear motion blur), have to
-  get specified. The triangle indices can be set be mapping and
-  writing to the index buffer (RTC_INDEX_BUFFER) and the triangle
-  vertices can be set by mapping and writing into the vertex buffer
-  (RTC_VERTEX_BUFFER). In case of linear motion blur, two vertex
-  buffers have to get filled (RTC_VERTEX_BUFFER0, RTC_VERTEX_BUFFER1),
-  one for each time step. The index buffer has the default layout of
+  steps (1 for normal meshes, and 2 up to RTC_MAX_TIME_STEPS for
+  multi segment linear motion blur), have to get specified. The triangle
+  indices can be set be mapping and writing to the index buffer
+  (RTC_INDEX_BUFFER) and the triangle vertices can be set by mapping
+  and writing into the vertex buffer (RTC_VERTEX_BUFFER). In case of
+  motion blur, one vertex buffer has to get filled for each time step
+  (RTC_VERTEX_BUFFER0+i for the i'th time step). The time steps are
+  uniformly distributed over the [0,1] shutter interval and the
+  geometry is linearly interpolated between neighbouring time
+  steps. The index buffer has the default layout of
   three 32 bit integer indices for each triangle. An index points to
   the ith vertex. The vertex buffer stores single precision x,y,z
   floating point coordinates aligned to 16 bytes. The value of the 4th
@@ -176,13 +185,16 @@ RTCORE_API unsigned rtcNewTriangleMesh (RTCScene scene,                    //!<
 
 /*! \brief Creates a new quad mesh. The number of quads
   (numQuads), number of vertices (numVertices), and number of time
-  steps (1 for normal meshes, and 2 for linear motion blur), have to
-  get specified. The quad indices can be set be mapping and
-  writing to the index buffer (RTC_INDEX_BUFFER) and the quad
-  vertices can be set by mapping and writing into the vertex buffer
-  (RTC_VERTEX_BUFFER). In case of linear motion blur, two vertex
-  buffers have to get filled (RTC_VERTEX_BUFFER0, RTC_VERTEX_BUFFER1),
-  one for each time step. The index buffer has the default layout of
+  steps (1 for normal meshes, and 2 up to RTC_MAX_TIME_STEPS for
+  multi segment linear motion blur), have to get specified. The quad
+  indices can be set be mapping and writing to the index buffer
+  (RTC_INDEX_BUFFER) and the quad vertices can be set by mapping
+  and writing into the vertex buffer (RTC_VERTEX_BUFFER). In case of
+  motion blur, one vertex buffer has to get filled for each time step
+  (RTC_VERTEX_BUFFER0+i for the i'th time step). The time steps are
+  uniformly distributed over the [0,1] shutter interval and the
+  geometry is linearly interpolated between neighbouring time
+  steps. The index buffer has the default layout of
   three 32 bit integer indices for each quad. An index points to
   the ith vertex. The vertex buffer stores single precision x,y,z
   floating point coordinates aligned to 16 bytes. The value of the 4th
@@ -511,6 +523,20 @@ RTCORE_API void rtcInterpolateN2(RTCScene scene, unsigned geomID,
                                 RTCBufferType buffer, 
                                 float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
 
+/*! Interpolates user data for an array of hits that can be located
+ *  on arbitrary geometries of the scene. The hits are specified by
+ *  the geomIDs, primIDs, u, and v arrays of numUVs entries, hits with
+ *  a geomID of RTC_INVALID_GEOMETRY_ID are skipped. The hits get
+ *  sorted by geometry internally, such that all hits of a geometry
+ *  are interpolated with a single vectorized call. The destination
+ *  arrays have the same meaning as for rtcInterpolateN2 and are
+ *  filled in structure of array (SoA) layout. Contrary to the other
+ *  interpolation calls this function is thread safe. */
+RTCORE_API void rtcInterpolateM(RTCScene scene, const unsigned* geomIDs, 
+                                const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
+                                RTCBufferType buffer, 
+                                float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
+
 /*! \brief Deletes the geometry. */
 RTCORE_API void rtcDeleteGeometry (RTCScene scene, unsigned geomID);
 
@@ -69,6 +69,13 @@ typedef void (*RTCIntersectFuncN)(const int* valid,                        /*!<
                                   size_t N,                                /*!< number of rays in packet */
                                   size_t item                              /*!< item to intersect */);
 
+/*! Type of intersect function pointer for batches of ray/item pairs. */
+typedef void (*RTCIntersectFuncNM)(void* ptr,                               /*!< pointer to geometry user data */
+                                   const RTCIntersectContext* context,      /*!< intersection context as passed to rtcIntersect/rtcOccluded */
+                                   RTCRay** rays,                           /*!< pointers to rays to intersect */
+                                   const unsigned* items,                   /*!< items to intersect, one for each ray pointer */
+                                   size_t M                                 /*!< number of ray/item pairs in batch */);
+
 /*! Type of occlusion function pointer for single rays. */
 typedef void (*RTCOccludedFunc) (void* ptr,           /*!< pointer to user data */ 
                                  RTCRay& ray,         /*!< ray to test occlusion */
@@ -107,6 +114,13 @@ typedef void (*RTCOccludedFuncN) (const int* valid,                      /*! poi
                                   size_t N,                              /*!< number of rays in packet */
                                   size_t item                            /*!< item to test for occlusion */);
 
+/*! Type of occlusion function pointer for batches of ray/item pairs. */
+typedef void (*RTCOccludedFuncNM) (void* ptr,                              /*!< pointer to geometry user data */
+                                   const RTCIntersectContext* context,     /*!< intersection context as passed to rtcIntersect/rtcOccluded */
+                                   RTCRay** rays,                          /*!< pointers to rays to test occlusion */
+                                   const unsigned* items,                  /*!< items to test for occlusion, one for each ray pointer */
+                                   size_t M                                /*!< number of ray/item pairs in batch */);
+
 /*! Creates a new user geometry object. This feature makes it possible
  *  to add arbitrary types of geometry to the scene by providing
  *  appropiate bounding, intersect and occluded functions. A user
@@ -169,6 +183,13 @@ RTCORE_API void rtcSetIntersectFunction1Mp (RTCScene scene, unsigned geomID, RTC
  *  geometry. */
 RTCORE_API void rtcSetIntersectFunctionN (RTCScene scene, unsigned geomID, RTCIntersectFuncN intersect);
 
+/*! Set intersect function for batches of ray/item pairs. The
+ *  ray stream functions will collect the rays and items of the user
+ *  geometry that get reached during traversal and pass them in
+ *  batches to this function. The same ray can occur multiple times
+ *  in a batch. */
+RTCORE_API void rtcSetIntersectFunctionNM (RTCScene scene, unsigned geomID, RTCIntersectFuncNM intersect);
+
 /*! Set occlusion function for single rays. The rtcOccluded function
  *  will call the passed function for intersecting the user
  *  geometry. */
@@ -199,6 +220,13 @@ RTCORE_API void rtcSetOccludedFunction1Mp (RTCScene scene, unsigned geomID, RTCO
  *  geometry. */
 RTCORE_API void rtcSetOccludedFunctionN (RTCScene scene, unsigned geomID, RTCOccludedFuncN occluded);
 
+/*! Set occlusion function for batches of ray/item pairs. The
+ *  ray stream functions will collect the rays and items of the user
+ *  geometry that get reached during traversal and pass them in
+ *  batches to this function. The same ray can occur multiple times
+ *  in a batch. */
+RTCORE_API void rtcSetOccludedFunctionNM (RTCScene scene, unsigned geomID, RTCOccludedFuncNM occluded);
+
 
 /*! @} */
 
@@ -20,6 +20,9 @@
 /*! \ingroup embree_kernel_api */
 /*! \{ */
 
+/*! maximal number of nested instance levels recorded in a ray */
+#define RTC_MAX_INSTANCE_LEVEL_COUNT 4
+
 /*! \brief Ray structure for an individual ray */
 #ifndef __RTCRay__
 #define __RTCRay__
@@ -50,6 +53,7 @@ public:
   unsigned geomID;        //!< geometry ID
   unsigned primID;        //!< primitive ID
   unsigned instID;        //!< instance ID
+  unsigned instIDNested[RTC_MAX_INSTANCE_LEVEL_COUNT-1]; //!< instance IDs of nested instances below instID
 };
 #endif
 
@@ -59,7 +59,8 @@ enum RTCAlgorithmFlags
 enum RTCIntersectFlags
 {
   RTC_INTERSECT_COHERENT   = 0,  //!< optimize for coherent rays
-  RTC_INTERSECT_INCOHERENT = 1   //!< optimize for incoherent rays
+  RTC_INTERSECT_INCOHERENT = 1,  //!< optimize for incoherent rays
+  RTC_INTERSECT_SORT       = 2   //!< reorders rays of streams by direction octant and origin before tracing them
 };
 
 /*! intersection context passed to intersect/occluded calls */
@@ -87,6 +88,12 @@ RTCORE_DEPRECATED typedef RTCProgressMonitorFunc RTC_PROGRESS_MONITOR_FUNCTION;
 /*! \brief Sets the progress callback function which is called during hierarchy build of this scene. */
 RTCORE_API void rtcSetProgressMonitorFunction(RTCScene scene, RTCProgressMonitorFunc func, void* ptr);
 
+/*! Sets the build priority of the scene (default is 0). Scenes can
+ *  get committed concurrently from different application threads,
+ *  the worker threads join the builds of highest priority first and
+ *  are shared equally among builds of the same priority. */
+RTCORE_API void rtcSetBuildPriority(RTCScene scene, int priority);
+
 /*! Commits the geometry of the scene. After initializing or modifying
  *  geometries, commit has to get called before tracing
  *  rays. */
@@ -104,6 +111,79 @@ RTCORE_API void rtcCommit (RTCScene scene);
  *  coprocessor. */
 RTCORE_API void rtcCommitThread(RTCScene scene, unsigned int threadID, unsigned int numThreads);
 
+/*! Commits a static scene using the acceleration structures stored
+ *  in a scene cache file. Returns true if the cache file matches the
+ *  geometry of the scene, in which case no hierarchy build is
+ *  performed and the structures are paged in lazily from the memory
+ *  mapped file. Returns false if the file does not exist or does not
+ *  match, in which case rtcCommit has to get called. Calling this
+ *  function also enables computation of the input data hash during
+ *  the following rtcCommit, which is required to save a cache file
+ *  for scenes whose buffers get freed at commit. */
+RTCORE_API bool rtcLoadSceneCache(RTCScene scene, const char* filename);
+
+/*! Stores the acceleration structures of a committed static scene
+ *  into a scene cache file, together with a hash of the input
+ *  data. Scenes containing subdivision meshes, user geometries,
+ *  instances, or Triangle4i based acceleration structures cannot
+ *  get cached. */
+RTCORE_API void rtcSaveSceneCache(RTCScene scene, const char* filename);
+
+/*! Ray tracing API entry points counted by the scene statistics. */
+enum RTCStatEntryPoint
+{
+  RTC_STAT_RAY1  = 0,   //!< rtcIntersect and rtcOccluded
+  RTC_STAT_RAY4  = 1,   //!< rtcIntersect4 and rtcOccluded4
+  RTC_STAT_RAY8  = 2,   //!< rtcIntersect8 and rtcOccluded8
+  RTC_STAT_RAY16 = 3,   //!< rtcIntersect16 and rtcOccluded16
+  RTC_STAT_RAY1M = 4,   //!< rtcIntersect1M and rtcOccluded1M
+  RTC_STAT_RAYNM = 5,   //!< rtcIntersectNM and rtcOccludedNM
+  RTC_STAT_RAYNP = 6,   //!< rtcIntersectNp and rtcOccludedNp
+  RTC_STAT_NUM_ENTRY_POINTS = 7
+};
+
+/*! Statistics of a scene, counted since creation of the scene or
+ *  the last call to rtcResetSceneStatistics. Ray counts only include
+ *  active rays, i.e. rays of packets enabled by the valid mask and
+ *  rays of streams with tnear <= tfar. */
+struct RTCSceneStatistics
+{
+  size_t raysIntersected[RTC_STAT_NUM_ENTRY_POINTS]; //!< rays passed to the rtcIntersect functions
+  size_t raysOccluded[RTC_STAT_NUM_ENTRY_POINTS];    //!< rays passed to the rtcOccluded functions
+  size_t nodesVisited;                                //!< BVH nodes visited by single ray traversal
+  size_t leavesVisited;                               //!< BVH leaves visited by single ray traversal
+  size_t numBuilds;                                   //!< number of acceleration structure builds
+  double buildTime;                                   //!< total build time in seconds
+  size_t bytes;                                       //!< bytes allocated by all acceleration structures
+  size_t numAccels;                                   //!< number of acceleration structures built
+};
+
+/*! Build statistics of one acceleration structure of a scene. */
+struct RTCAccelStatistics
+{
+  char builder[64];       //!< name of the builder used for the last build
+  char primitiveType[32]; //!< name of the primitive type stored
+  size_t numBuilds;       //!< number of builds
+  double buildTime;       //!< total build time in seconds
+  double lastBuildTime;   //!< time of the last build in seconds
+  size_t numPrimitives;   //!< number of primitives of the last build
+  size_t bytes;           //!< bytes allocated after the last build
+};
+
+/*! Returns the statistics of the scene. The counters are always
+ *  enabled and each thread counts into its own memory, thus this
+ *  function can get called at any time, e.g. to periodically scrape
+ *  the counters into a metrics system. */
+RTCORE_API void rtcGetSceneStatistics(RTCScene scene, RTCSceneStatistics* stats);
+
+/*! Returns the build statistics of the i'th acceleration structure of
+ *  the scene. Returns false if the scene has less than i+1
+ *  acceleration structures. */
+RTCORE_API bool rtcGetSceneAccelStatistics(RTCScene scene, size_t i, RTCAccelStatistics* stats);
+
+/*! Resets the ray counters and build times of the scene. */
+RTCORE_API void rtcResetSceneStatistics(RTCScene scene);
+
 /*! Returns to AABB of the scene. rtcCommit has to get called
  *  previously to this function. */
 RTCORE_API void rtcGetBounds(RTCScene scene, RTCBounds& bounds_o);
@@ -60,4 +60,118 @@ namespace embree
   };
 
   parallel_for_regression_test parallel_for_regression("parallel_for_regression_test");
+
+  /* every recursion level leaves 256 tasks outstanding, thus the task
+   * and closure stacks of the thread have to grow well beyond 4k tasks */
+  struct task_recursion_regression_test : public RegressionTest
+  {
+    task_recursion_regression_test(const char* name) : RegressionTest(name) {
+      registerRegressionTest(this);
+    }
+
+    static const size_t TASKS_PER_LEVEL = 256;
+
+    static void spawn_level(std::atomic<size_t>& counter, size_t depth)
+    {
+      if (depth == 0) return;
+      SPAWN_BEGIN;
+      for (size_t i=0; i<TASKS_PER_LEVEL; i++)
+        SPAWN(([&] { counter++; }));
+      SPAWN(([&,depth] { spawn_level(counter,depth-1); }));
+      SPAWN_END;
+    }
+    
+    bool run ()
+    {
+      bool passed = true;
+      
+      for (size_t depth=16; depth<=128; depth*=2)
+      {
+        std::atomic<size_t> counter(0);
+        SPAWN_BEGIN;
+        SPAWN(([&] { spawn_level(counter,depth); }));
+        SPAWN_END;
+        passed &= counter == depth*TASKS_PER_LEVEL;
+      }
+      
+      return passed;
+    }
+  };
+
+  task_recursion_regression_test task_recursion_regression("task_recursion_regression_test");
+
+#if defined(TASKING_INTERNAL)
+
+  /* a high priority scheduler that starts while the worker threads are
+   * busy with a long low priority scheduler has to get worker threads */
+  struct task_priority_regression_test : public RegressionTest
+  {
+    task_priority_regression_test(const char* name) : RegressionTest(name) {
+      registerRegressionTest(this);
+    }
+
+    static const size_t NUM_LOW_TASKS = 100000;
+    static const size_t NUM_HIGH_TASKS = 64;
+
+    struct LowPriorityBuild
+    {
+      Ref<TaskScheduler> scheduler;
+      std::atomic<size_t> numStarted;
+      std::atomic<bool> highDone;
+    };
+
+    static void spin(double seconds) {
+      const double t0 = getSeconds();
+      while (getSeconds()-t0 < seconds) __pause_cpu();
+    }
+
+    static void lowPriorityBuild(LowPriorityBuild* build)
+    {
+      build->scheduler->spawn_root([&] {
+          SPAWN_BEGIN;
+          for (size_t i=0; i<NUM_LOW_TASKS; i++)
+            SPAWN(([&] { build->numStarted++; if (!build->highDone) spin(50E-6); }));
+          SPAWN_END;
+        });
+    }
+    
+    bool run ()
+    {
+      /* the low and high priority schedulers each need a thread, and the test needs some worker threads to move */
+      if (TaskScheduler::threadCount() < 3)
+        return true;
+
+      LowPriorityBuild low;
+      low.scheduler = new TaskScheduler(-1);
+      low.numStarted = 0;
+      low.highDone = false;
+      thread_t thread = createThread((thread_func)lowPriorityBuild,&low);
+
+      /* wait until the worker threads joined the low priority scheduler */
+      while (low.numStarted < 1000) yield();
+
+      std::vector<size_t> threadIndices;
+      MutexSys mutex;
+      Ref<TaskScheduler> high = new TaskScheduler(+1);
+      high->spawn_root([&] {
+          SPAWN_BEGIN;
+          for (size_t i=0; i<NUM_HIGH_TASKS; i++)
+            SPAWN(([&] { 
+                  spin(1E-3); 
+                  Lock<MutexSys> lock(mutex);
+                  if (std::find(threadIndices.begin(),threadIndices.end(),TaskScheduler::threadIndex()) == threadIndices.end())
+                    threadIndices.push_back(TaskScheduler::threadIndex());
+                }));
+          SPAWN_END;
+        });
+      low.highDone = true;
+      join(thread);
+
+      return threadIndices.size() > 1;
+    }
+  };
+
+  task_priority_regression_test task_priority_regression("task_priority_regression_test");
+
+#endif
 }
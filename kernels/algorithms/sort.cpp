@@ -62,4 +62,43 @@ namespace embree
 
   RadixSortRegressionTest<uint32_t> test_u32("RadixSortRegressionTestU32");
   RadixSortRegressionTest<uint64_t> test_u64("RadixSortRegressionTestU64");
+
+  template<typename Key>
+  struct RadixSortKeyValueRegressionTest : public RegressionTest
+  {
+    RadixSortKeyValueRegressionTest(const char* name) : RegressionTest(name) {
+      registerRegressionTest(this);
+    }
+    
+    bool run ()
+    {
+      bool passed = true;
+
+      for (size_t N=10; N<10000000; N*=2.1f)
+      {
+        /* the upper digits of all keys are equal to test skipping of passes */
+        std::vector<Key> keys(N), tmpKeys(N), orgKeys(N);
+        std::vector<unsigned int> values(N), tmpValues(N);
+        for (size_t i=0; i<N; i++) {
+          orgKeys[i] = keys[i] = (Key(rand()) & 0xFFFF) | (Key(0xAB) << (8*sizeof(Key)-8));
+          values[i] = (unsigned int) i;
+        }
+
+        radix_sort_key_value<Key,unsigned int>(keys.data(),values.data(),tmpKeys.data(),tmpValues.data(),N);
+
+        /* check if keys are sorted, values got moved along, and the sort is stable */
+        for (size_t i=0; i<N; i++) 
+          passed &= keys[i] == orgKeys[values[i]];
+        for (size_t i=1; i<N; i++) {
+          passed &= keys[i-1] <= keys[i];
+          passed &= keys[i-1] != keys[i] || values[i-1] < values[i];
+        }
+      }
+      
+      return passed;
+    }
+  };
+
+  RadixSortKeyValueRegressionTest<uint32_t> test_key_value_u32("RadixSortKeyValueRegressionTestU32");
+  RadixSortKeyValueRegressionTest<uint64_t> test_key_value_u64("RadixSortKeyValueRegressionTestU64");
 }
@@ -195,149 +195,200 @@ namespace embree
     }
   }
   
+  /*! Parallel LSD radix sort. Keys are sorted in digits of BITS bits,
+   *  each task counts the digits of its range into its own histogram,
+   *  and passes where all keys share the same digit get skipped. */
   class __aligned(64) ParallelRadixSort
   {
   public:
     static const size_t MAX_TASKS = MAX_THREADS;
     static const size_t BITS = 8;
     static const size_t BUCKETS = (1 << BITS);
-    typedef unsigned int TyRadixCount[BUCKETS];
+
+    /*! per task histogram, aligned to cache lines to avoid false sharing between tasks */
+    struct __aligned(64) TyRadixCount 
+    {
+      __forceinline       unsigned int& operator[] (const size_t i)       { return count[i]; }
+      __forceinline const unsigned int& operator[] (const size_t i) const { return count[i]; }
+    private:
+      unsigned int count[BUCKETS];
+    };
     
     ParallelRadixSort() 
       : radixCount(nullptr) {}
 
+    /*! items of a single array that get sorted by the key returned by the Key cast operator */
     template<typename Ty, typename Key>
-      class Task
+      struct Items
     {
-      template<typename T>
-        static bool compare(const T& v0, const T& v1) {
-        return (Key)v0 < (Key)v1;
-      }
+      Items (Ty* const src, Ty* const tmp) { data[0] = src; data[1] = tmp; }
       
-    public:
-      Task (ParallelRadixSort* parent, Ty* const src, Ty* const tmp, const size_t N, const size_t blockSize)
-        : parent(parent), src(src), tmp(tmp), N(N)
-      {
-        assert(blockSize > 0);
-        
-        /* perform single threaded sort for small N */
-        if (N<=blockSize) // handles also special case of 0!
-        {	  
-          /* do inplace sort inside destination array */
-          std::sort(src,src+N,compare<Ty>);
-        }
-        
-        /* perform parallel sort for large N */
-        else 
-        {
-          const size_t numThreads = min((N+blockSize-1)/blockSize,TaskScheduler::threadCount(),size_t(MAX_TASKS));
-          tbbRadixSort(numThreads);
-        }
+      __forceinline Key key(const size_t buf, const size_t i) const { 
+        return (Key)data[buf][i]; 
+      }
+
+      __forceinline void move(const size_t buf, const size_t i, const size_t j) const { 
+        data[1-buf][j] = data[buf][i]; 
+      }
+
+      __forceinline void copyBack(const size_t i) const {
+        data[0][i] = data[1][i];
+      }
+
+      Ty* data[2];
+    };
+
+    /*! keys with a separate array of values that get moved along */
+    template<typename Key, typename Value>
+      struct KeyValueItems
+    {
+      KeyValueItems (Key* const keys, Value* const values, Key* const tmpKeys, Value* const tmpValues) { 
+        this->keys[0] = keys; this->keys[1] = tmpKeys; 
+        this->values[0] = values; this->values[1] = tmpValues; 
       }
       
-    private:
+      __forceinline Key key(const size_t buf, const size_t i) const { 
+        return keys[buf][i]; 
+      }
+
+      __forceinline void move(const size_t buf, const size_t i, const size_t j) const { 
+        keys[1-buf][j] = keys[buf][i]; 
+        values[1-buf][j] = values[buf][i]; 
+      }
+
+      __forceinline void copyBack(const size_t i) const {
+        keys[0][i] = keys[1][i];
+        values[0][i] = values[1][i];
+      }
+
+      Key* keys[2];
+      Value* values[2];
+    };
+
+    /*! sorts the items with numTasks tasks, the sorted items end up in the first buffer */
+    template<typename Key, typename Items>
+      void sort(const Items& items, const size_t N, const size_t numTasks)
+    {
+      assert(radixCount == nullptr);
+      assert(numTasks > 0 && numTasks <= MAX_TASKS);
+      if (N == 0) return;
       
-      void tbbRadixIteration0(const Key shift, 
-                              const Ty* __restrict const src, 
-                              Ty* __restrict const dst, 
-                              const size_t threadIndex, const size_t threadCount)
+      radixCount = (TyRadixCount*) alignedMalloc(numTasks*sizeof(TyRadixCount));
+
+      size_t buf = 0;
+      for (size_t shift=0; shift<8*sizeof(Key); shift+=BITS)
       {
-        const size_t startID = (threadIndex+0)*N/threadCount;
-        const size_t endID   = (threadIndex+1)*N/threadCount;
+        if (!radixIteration<Key>(items,Key(shift),buf,N,numTasks))
+          continue;
+        buf = 1-buf;
+      }
+
+      /* copy back if an odd number of passes were performed */
+      if (buf == 1) {
+        parallel_for(numTasks,[&] (size_t taskIndex) { 
+            const size_t startID = (taskIndex+0)*N/numTasks;
+            const size_t endID   = (taskIndex+1)*N/numTasks;
+            for (size_t i=startID; i<endID; i++) items.copyBack(i);
+          });
+      }
+
+      alignedFree(radixCount); 
+      radixCount = nullptr;
+    }
+
+  private:
+
+    /*! performs one pass, returns false if the pass got skipped */
+    template<typename Key, typename Items>
+      bool radixIteration(const Items& items, const Key shift, const size_t buf, const size_t N, const size_t numTasks)
+    {
+      /* mask to extract some number of bits */
+      const Key mask = BUCKETS-1;
         
-        /* mask to extract some number of bits */
-        const Key mask = BUCKETS-1;
+      /* count how many items of each task go into the buckets */
+      parallel_for(numTasks,[&] (size_t taskIndex) 
+      {
+        const size_t startID = (taskIndex+0)*N/numTasks;
+        const size_t endID   = (taskIndex+1)*N/numTasks;
         
-        /* count how many items go into the buckets */
+        __aligned(64) unsigned int count[BUCKETS];
         for (size_t i=0; i<BUCKETS; i++)
-          parent->radixCount[threadIndex][i] = 0;
+          count[i] = 0;
         
         for (size_t i=startID; i<endID; i++) {
-          const Key index = ((Key)src[i] >> shift) & mask;
-          parent->radixCount[threadIndex][index]++;
+          const Key index = (items.key(buf,i) >> shift) & mask;
+          count[index]++;
         }
-      }
-      
-      void tbbRadixIteration1(const Key shift, 
-                              const Ty* __restrict const src, 
-                              Ty* __restrict const dst, 
-                              const size_t threadIndex, const size_t threadCount)
-      {
-        const size_t startID = (threadIndex+0)*N/threadCount;
-        const size_t endID   = (threadIndex+1)*N/threadCount;
-        
-        /* mask to extract some number of bits */
-        const Key mask = BUCKETS-1;
-        
-        /* calculate total number of items for each bucket */
-        __aligned(64) unsigned int total[BUCKETS];
+
         for (size_t i=0; i<BUCKETS; i++)
-          total[i] = 0;
-        
-        for (size_t i=0; i<threadCount; i++)
-          for (size_t j=0; j<BUCKETS; j++)
-            total[j] += parent->radixCount[i][j];
+          radixCount[taskIndex][i] = count[i];
+      });
+
+      /* skip the pass if all keys have the same digit */
+      const Key digit = (items.key(buf,0) >> shift) & mask;
+      size_t numDigit = 0;
+      for (size_t i=0; i<numTasks; i++)
+        numDigit += radixCount[i][digit];
+      if (numDigit == N) 
+        return false;
+
+      /* calculate start offset of each bucket for each task */
+      unsigned int sum = 0;
+      for (size_t j=0; j<BUCKETS; j++) {
+        for (size_t i=0; i<numTasks; i++) {
+          const unsigned int count = radixCount[i][j];
+          radixCount[i][j] = sum;
+          sum += count;
+        }
+      }
         
-        /* calculate start offset of each bucket */
+      /* copy items into their buckets */
+      parallel_for(numTasks,[&] (size_t taskIndex) 
+      {
+        const size_t startID = (taskIndex+0)*N/numTasks;
+        const size_t endID   = (taskIndex+1)*N/numTasks;
+
         __aligned(64) unsigned int offset[BUCKETS];
-        offset[0] = 0;
-        for (size_t i=1; i<BUCKETS; i++)    
-          offset[i] = offset[i-1] + total[i-1];
-        
-        /* calculate start offset of each bucket for this thread */
-        for (size_t i=0; i<threadIndex; i++)
-          for (size_t j=0; j<BUCKETS; j++)
-            offset[j] += parent->radixCount[i][j];
+        for (size_t i=0; i<BUCKETS; i++)
+          offset[i] = radixCount[taskIndex][i];
         
-        /* copy items into their buckets */
         for (size_t i=startID; i<endID; i++) {
-          const Ty elt = src[i];
-          const Key index = ((Key)src[i] >> shift) & mask;
-          dst[offset[index]++] = elt;
-          //prefetchEX(((char*)&dst[offset[index]]) + 64);
+          const Key index = (items.key(buf,i) >> shift) & mask;
+          items.move(buf,i,offset[index]++);
         }
+      });
+      return true;
+    }
+
+  public:
+    
+    template<typename Ty, typename Key>
+      class Task
+    {
+      template<typename T>
+        static bool compare(const T& v0, const T& v1) {
+        return (Key)v0 < (Key)v1;
       }
       
-      void tbbRadixIteration(const Key shift, const bool last,
-                             const Ty* __restrict src, Ty* __restrict dst,
-                             const size_t numTasks)
-      {
-        parallel_for(numTasks,[&] (size_t taskIndex) { tbbRadixIteration0(shift,src,dst,taskIndex,numTasks); });
-        parallel_for(numTasks,[&] (size_t taskIndex) { tbbRadixIteration1(shift,src,dst,taskIndex,numTasks); });
-      }
-      
-      void tbbRadixSort(const size_t numTasks)
+    public:
+      Task (ParallelRadixSort* parent, Ty* const src, Ty* const tmp, const size_t N, const size_t blockSize)
       {
-        assert(parent->radixCount == nullptr);
-
-        parent->radixCount = (TyRadixCount*) alignedMalloc(MAX_TASKS*sizeof(TyRadixCount));
-
-        if (sizeof(Key) == sizeof(uint32_t)) {
-          tbbRadixIteration(0*BITS,0,src,tmp,numTasks);
-          tbbRadixIteration(1*BITS,0,tmp,src,numTasks);
-          tbbRadixIteration(2*BITS,0,src,tmp,numTasks);
-          tbbRadixIteration(3*BITS,1,tmp,src,numTasks);
+        assert(blockSize > 0);
+        
+        /* perform single threaded sort for small N */
+        if (N<=blockSize) // handles also special case of 0!
+        {	  
+          /* do inplace sort inside destination array */
+          std::sort(src,src+N,compare<Ty>);
         }
-        else if (sizeof(Key) == sizeof(uint64_t))
+        
+        /* perform parallel sort for large N */
+        else 
         {
-          tbbRadixIteration(0*BITS,0,src,tmp,numTasks);
-          tbbRadixIteration(1*BITS,0,tmp,src,numTasks);
-          tbbRadixIteration(2*BITS,0,src,tmp,numTasks);
-          tbbRadixIteration(3*BITS,0,tmp,src,numTasks);
-          tbbRadixIteration(4*BITS,0,src,tmp,numTasks);
-          tbbRadixIteration(5*BITS,0,tmp,src,numTasks);
-          tbbRadixIteration(6*BITS,0,src,tmp,numTasks);
-          tbbRadixIteration(7*BITS,1,tmp,src,numTasks);
+          const size_t numTasks = min((N+blockSize-1)/blockSize,TaskScheduler::threadCount(),size_t(MAX_TASKS));
+          parent->sort<Key>(Items<Ty,Key>(src,tmp),N,numTasks);
         }
-        alignedFree(parent->radixCount); 
-        parent->radixCount = nullptr;
       }
-      
-    private:
-      ParallelRadixSort* const parent;
-      Ty* const src;
-      Ty* const tmp;
-      const size_t N;
     };
 
   private:
@@ -384,4 +435,16 @@ namespace embree
     void radix_sort_u64(Ty* const src, Ty* const tmp, const size_t N, const size_t blockSize = RADIX_SORT_MIN_BLOCK_SIZE) {
     radix_sort<Ty,uint64_t>(src,tmp,N,blockSize);
   }
+
+  /*! stable parallel radix sort of unsigned integer keys that moves a separate array of values along, 
+   *  the sorted keys and values end up in the keys and values arrays */
+  template<typename Key, typename Value>
+    void radix_sort_key_value(Key* const keys, Value* const values, Key* const tmpKeys, Value* const tmpValues, const size_t N, 
+                              const size_t blockSize = RADIX_SORT_MIN_BLOCK_SIZE)
+  {
+    assert(blockSize > 0);
+    const size_t numTasks = max(size_t(1),min((N+blockSize-1)/blockSize,TaskScheduler::threadCount(),size_t(ParallelRadixSort::MAX_TASKS)));
+    ParallelRadixSort radix_sort_state;
+    radix_sort_state.sort<Key>(ParallelRadixSort::KeyValueItems<Key,Value>(keys,values,tmpKeys,tmpValues),N,numTasks);
+  }
 }
@@ -39,6 +39,16 @@ namespace embree
     /*! clears the acceleration structure data */
     virtual void clear() = 0;
 
+    /*! writes the acceleration structure data in relocatable form to a scene cache file */
+    virtual void writeCache(std::ofstream& file) { 
+      throw_RTCError(RTC_INVALID_OPERATION,"acceleration structure does not support scene caching"); 
+    }
+
+    /*! initializes the acceleration structure from data of a mapped scene cache file, returns false if data does not match */
+    virtual bool loadCache(char* ptr, size_t bytes) { 
+      return false; 
+    }
+
   public:
     BBox3fa bounds;
     Type type;
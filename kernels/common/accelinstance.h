@@ -49,7 +49,18 @@ namespace embree
     
     void clear() {
       accel->clear();
-      builder->clear();
+      if (builder) builder->clear();
+    }
+
+    void writeCache(std::ofstream& file) {
+      accel->writeCache(file);
+    }
+
+    bool loadCache(char* ptr, size_t bytes) 
+    {
+      if (!accel->loadCache(ptr,bytes)) return false;
+      bounds = accel->bounds;
+      return true;
     }
 
   private:
@@ -159,6 +159,11 @@ namespace embree
         accels[i]->build(threadIndex,threadCount);
       });
 
+    updateValidAccels();
+  }
+
+  void AccelN::updateValidAccels()
+  {
     /* create list of non-empty acceleration structures */
     validAccels.clear();
     for (size_t i=0; i<accels.size(); i++) {
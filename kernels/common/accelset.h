@@ -37,6 +37,7 @@ namespace embree
     typedef RTCIntersectFunc16 IntersectFunc16;
     typedef RTCIntersectFunc1Mp IntersectFunc1M;
     typedef RTCIntersectFuncN IntersectFuncN;
+    typedef RTCIntersectFuncNM IntersectFuncNM;
     
     typedef RTCOccludedFunc OccludedFunc;
     typedef RTCOccludedFunc4 OccludedFunc4;
@@ -44,6 +45,7 @@ namespace embree
     typedef RTCOccludedFunc16 OccludedFunc16;
     typedef RTCOccludedFunc1Mp OccludedFunc1M;
     typedef RTCOccludedFuncN OccludedFuncN;
+    typedef RTCOccludedFuncNM OccludedFuncNM;
 
 #if defined(__SSE__)
     typedef void (*ISPCIntersectFunc4)(void* ptr, RTCRay4& ray, size_t item, __m128 valid);
@@ -166,6 +168,23 @@ namespace embree
         IntersectFuncN intersect;
         OccludedFuncN occluded;  
       };
+
+      struct IntersectorNM
+      {
+        IntersectorNM (ErrorFunc error = nullptr) 
+        : intersect((IntersectFuncNM)error), occluded((OccludedFuncNM)error), name(nullptr) {}
+        
+        IntersectorNM (IntersectFuncNM intersect, OccludedFuncNM occluded, const char* name)
+        : intersect(intersect), occluded(occluded), name(name) {}
+        
+        operator bool() const { return name; }
+        
+      public:
+        static const char* type;
+        const char* name;
+        IntersectFuncNM intersect;
+        OccludedFuncNM occluded;  
+      };
       
     public:
       
@@ -188,6 +207,14 @@ namespace embree
         return box[0];
       }
 
+      /*! Calculates the bounds of an item at the itime'th time step */
+      __forceinline BBox3fa bounds (size_t item, size_t itime) const
+      {
+        assert(itime < numTimeSteps);
+        if (itime == 0) return bounds(item);
+        return bounds_mblur(item).second;
+      }
+
       /*! Calculates the bounds of an item */
       __forceinline std::pair<BBox3fa,BBox3fa> bounds_mblur (size_t item) const
       {
@@ -302,6 +329,13 @@ namespace embree
           for (size_t i=0; i<N; i++) packet.readHit(i,(Ray&)*rays[i]);
         }
       }
+
+      /*! Intersects a batch of ray/item pairs with the scene. */
+      __forceinline void intersectNM (RTCRay** rays, const unsigned* items, size_t M, const RTCIntersectContext* context) 
+      {
+        assert(intersectors.intersectorNM.intersect); // only called for geometries that have a batched callback
+        intersectors.intersectorNM.intersect(intersectors.ptr,context,rays,items,M);
+      }
       
       /*! Tests if single ray is occluded by the scene. */
       __forceinline void occluded (RTCRay& ray, size_t item, const RTCIntersectContext* context) 
@@ -393,6 +427,13 @@ namespace embree
         }
       }
 
+      /*! Tests if a batch of ray/item pairs is occluded by the scene. */
+      __forceinline void occludedNM (RTCRay** rays, const unsigned* items, size_t M, const RTCIntersectContext* context) 
+      {
+        assert(intersectors.intersectorNM.occluded); // only called for geometries that have a batched callback
+        intersectors.intersectorNM.occluded(intersectors.ptr,context,rays,items,M);
+      }
+
     public:
       RTCBoundsFunc  boundsFunc;
       RTCBoundsFunc2 boundsFunc2;
@@ -409,6 +450,7 @@ namespace embree
         Intersector16 intersector16;
         Intersector1M intersector1M;
         IntersectorN intersectorN;
+        IntersectorNM intersectorNM;
       } intersectors;
   };
 
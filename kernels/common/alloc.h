@@ -386,8 +386,25 @@ namespace embree
         const size_t sizeof_Header = offsetof(Block,data[0]);
         bytesAllocate = ((sizeof_Header+bytesAllocate+defaultBlockSize-1) & ~(defaultBlockSize-1)); // always consume full pages
         bytesReserve  = ((sizeof_Header+bytesReserve +defaultBlockSize-1) & ~(defaultBlockSize-1)); // always consume full pages
+
+        /* recycle already committed memory through the memory pool */
+        if (MemoryPool* pool = device ? device->memoryPool() : nullptr)
+        {
+          bytesReserve = pool->roundBytes(bytesReserve);
+          size_t bytesCommitted = 0;
+          void* ptr = pool->malloc(bytesReserve,bytesCommitted);
+          if (bytesCommitted < bytesAllocate) {
+            device->memoryMonitor(bytesAllocate-bytesCommitted,false);
+            os_commit(ptr,bytesAllocate);
+          }
+          bytesAllocate = max(bytesAllocate,bytesCommitted);
+          new (ptr) Block(bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next);
+          return (Block*) ptr;
+        }
+
         if (device) device->memoryMonitor(bytesAllocate,false);
         void* ptr = os_reserve(bytesReserve);
+        if (device) os_numa_policy(ptr,bytesReserve,device->numaPolicy());
         os_commit(ptr,bytesAllocate);
         new (ptr) Block(bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next);
         return (Block*) ptr;
@@ -404,6 +421,10 @@ namespace embree
         const size_t sizeof_Header = offsetof(Block,data[0]);
         size_t sizeof_This = sizeof_Header+reserveEnd;
         const size_t sizeof_Alloced = sizeof_Header+getBlockAllocatedBytes();
+        if (MemoryPool* pool = device ? device->memoryPool() : nullptr) {
+          pool->free(this,sizeof_This,sizeof_Alloced);
+          return;
+        }
         os_free(this,sizeof_This);
         if (device) device->memoryMonitor(-sizeof_Alloced,true);
       }
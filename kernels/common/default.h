@@ -55,6 +55,7 @@
 
 #include <vector>
 #include <map>
+#include <set>
 #include <algorithm>
 #include <functional>
 
@@ -56,7 +56,7 @@ namespace embree
   static std::map<Device*,size_t> g_num_threads_map;
 
   Device::Device (const char* cfg, bool singledevice)
-    : State(singledevice)
+    : State(singledevice), statBuilds(0), statBuildTime(0)
   {
     /* initialize global state */
     State::parseString(cfg);
@@ -73,6 +73,11 @@ namespace embree
     /*! set tessellation cache size */
     setCacheSize( State::tessellation_cache_size );
 
+    /*! create memory pool to recycle build memory */
+    memory_pool = nullptr;
+    if (State::memory_pool_size)
+      memory_pool = new MemoryPool(this,State::memory_pool_size,State::memory_pool_hugepages);
+
     /*! enable some floating point exceptions to catch bugs */
     if (State::float_exceptions)
     {
@@ -117,6 +122,8 @@ namespace embree
 #if defined(__TARGET_AVX__)
     delete bvh8_factory;
 #endif
+    if (memory_pool && State::verbosity(2)) memory_pool->print();
+    delete memory_pool;
     setCacheSize(0);
     exitTaskingSystem();
   }
@@ -295,11 +302,12 @@ namespace embree
     if (bytes == 0) g_cache_size_map.erase(this);
     else            g_cache_size_map[this] = bytes;
     
-    size_t maxCacheSize = 0;
+    /* the tessellation cache is shared, thus it gets sized to hold the budgets of all devices */
+    size_t totalCacheSize = 0;
     for (std::map<Device*,size_t>::iterator i=g_cache_size_map.begin(); i!= g_cache_size_map.end(); i++)
-      maxCacheSize = max(maxCacheSize, (*i).second);
+      totalCacheSize += (*i).second;
     
-    resizeTessellationCache(maxCacheSize);
+    resizeTessellationCache(totalCacheSize);
   }
 
   void Device::initTaskingSystem(size_t numThreads) 
@@ -487,6 +495,20 @@ namespace embree
     case RTC_CONFIG_USER_GEOMETRY: return 0;
 #endif
 
+    case RTC_MEMORY_POOL_CACHED_BYTES: return memory_pool ? memory_pool->getCachedBytes() : 0;
+    case RTC_MEMORY_POOL_REUSED_BYTES: return memory_pool ? memory_pool->getReusedBytes() : 0;
+
+    case RTC_SOFTWARE_CACHE_HITS   : return getTessellationCacheHits();
+    case RTC_SOFTWARE_CACHE_MISSES : return getTessellationCacheMisses();
+    case RTC_SOFTWARE_CACHE_FLUSHES: return getTessellationCacheFlushes();
+
+    case RTC_STAT_RAYS_INTERSECTED: return stat.get(ShardedStat::INTERSECT1,ShardedStat::OCCLUDED1);
+    case RTC_STAT_RAYS_OCCLUDED   : return stat.get(ShardedStat::OCCLUDED1,ShardedStat::NODES_VISITED);
+    case RTC_STAT_NODES_VISITED   : return stat.get(ShardedStat::NODES_VISITED);
+    case RTC_STAT_LEAVES_VISITED  : return stat.get(ShardedStat::LEAVES_VISITED);
+    case RTC_STAT_BUILDS          : return statBuilds;
+    case RTC_STAT_BUILD_TIME      : return statBuildTime;
+
     default: throw_RTCError(RTC_INVALID_ARGUMENT, "unknown readable parameter"); break;
     };
   }
@@ -59,6 +59,12 @@ namespace embree
     /*! invokes the memory monitor callback */
     void memoryMonitor(ssize_t bytes, bool post);
 
+    /*! returns the memory pool to recycle build memory */
+    MemoryPool* memoryPool() { return memory_pool; }
+
+    /*! returns the NUMA placement policy for build memory */
+    NumaPolicy numaPolicy() { return State::numa_policy; }
+
     /*! sets the size of the software cache. */
     void setCacheSize(size_t bytes);
 
@@ -99,6 +105,13 @@ namespace embree
     tbb::task_arena* arena;
 #endif
     
+    MemoryPool* memory_pool;  //!< pool to recycle build memory, nullptr if disabled
+
+    /* always enabled statistics of all scenes of the device */
+    ShardedStat stat;                     //!< ray tracing counters
+    std::atomic<size_t> statBuilds;       //!< number of acceleration structure builds
+    std::atomic<size_t> statBuildTime;    //!< total build time in microseconds
+
     /* ray streams filter */
     RayStreamFilterFuncs rayStreamFilters;
   };
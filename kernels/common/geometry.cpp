@@ -41,6 +41,10 @@ namespace embree
     int type = -1; file.write((char*)&type,sizeof(type));
   }
 
+  void Geometry::hash(Hash64& h) const {
+    throw_RTCError(RTC_INVALID_OPERATION,"geometry type does not support scene caching");
+  }
+
   void Geometry::updateIntersectionFilters(bool enable)
   {
     const size_t num1  = (intersectionFilter1  != nullptr) + (occlusionFilter1  != nullptr);
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "default.h"
+#include "hash.h"
 
 namespace embree
 {
@@ -42,6 +43,9 @@ namespace embree
     /*! writes geometry to disk */
     virtual void write(std::ofstream& file);
 
+    /*! adds all geometry data relevant for hierarchy construction to the hash */
+    virtual void hash(Hash64& h) const;
+
     /*! updates intersection filter function counts in scene */
     void updateIntersectionFilters(bool enable);
 
@@ -80,6 +84,43 @@ namespace embree
     /*! returns number of primitives */
     __forceinline size_t size() const { return numPrimitives; }
 
+    /*! returns the time segment the specified time falls into and the local time inside that segment */
+    __forceinline int timeSegment(float time, float& ftime) const
+    {
+      const float timeScaled = time * float(numTimeSteps-1);
+      const int itime = clamp(int(floor(timeScaled)), 0, int(numTimeSteps)-2);
+      ftime = timeScaled - float(itime);
+      return itime;
+    }
+
+    /*! returns the time segments the specified times fall into and the local times inside these segments */
+    template<int K>
+    __forceinline vint<K> timeSegment(const vfloat<K>& time, vfloat<K>& ftime) const
+    {
+      const vfloat<K> timeScaled = time * vfloat<K>(float(numTimeSteps-1));
+      const vint<K> itime = min(max(vint<K>(floor(timeScaled)), vint<K>(zero)), vint<K>(int(numTimeSteps)-2));
+      ftime = timeScaled - vfloat<K>(itime);
+      return itime;
+    }
+
+    /*! converts positions at the start and end of the itime'th time segment into the positions at time 0 and 1 of a linear motion that matches the segment */
+    __forceinline void linearMotion(int itime, Vec3fa& p0, Vec3fa& p1) const
+    {
+      if (numTimeSteps == 2) return;
+      const float numSegments = float(numTimeSteps-1);
+      const Vec3fa dp = (p1-p0)*numSegments;
+      p0 = p0 - (float(itime)/numSegments)*dp;
+      p1 = p0 + dp;
+    }
+
+    /*! converts bounds at the start and end of the itime'th time segment into linear bounds over the [0,1] time range */
+    __forceinline std::pair<BBox3fa,BBox3fa> linearBounds(int itime, BBox3fa bounds0, BBox3fa bounds1) const
+    {
+      linearMotion(itime,bounds0.lower,bounds1.lower);
+      linearMotion(itime,bounds0.upper,bounds1.upper);
+      return std::make_pair(bounds0,bounds1);
+    }
+
     /*! for all geometries */
   public:
 
@@ -246,6 +287,11 @@ namespace embree
     virtual void setIntersectFunctionN (RTCIntersectFuncN intersect) { 
       throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
+
+    /*! Set intersect function for batches of ray/item pairs. */
+    virtual void setIntersectFunctionNM (RTCIntersectFuncNM intersect) { 
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
     
     /*! Set occlusion function for single rays. */
     virtual void setOccludedFunction (RTCOccludedFunc occluded, bool ispc = false) { 
@@ -277,6 +323,11 @@ namespace embree
       throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! Set occlusion function for batches of ray/item pairs. */
+    virtual void setOccludedFunctionNM (RTCOccludedFuncNM occluded) { 
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
   public:
     __forceinline bool hasIntersectionFilter1() const { return (hasIntersectionFilterMask & (HAS_FILTER1 | HAS_FILTERN)) != 0;  }
     __forceinline bool hasOcclusionFilter1   () const { return (hasOcclusionFilterMask    & (HAS_FILTER1 | HAS_FILTERN)) != 0; }
@@ -291,7 +342,7 @@ namespace embree
     unsigned id;               //!< internal geometry ID
     Type type;                 //!< geometry type 
     ssize_t numPrimitives;     //!< number of primitives of this geometry
-    unsigned numTimeSteps;     //!< number of time steps (1 or 2)
+    unsigned numTimeSteps;     //!< number of time steps
     RTCGeometryFlags flags;    //!< flags of geometry
     bool enabled;              //!< true if geometry is enabled
     bool modified;             //!< true if geometry is modified
@@ -0,0 +1,60 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  /*! Simple 64 bit hash (FNV-1a over 8 byte words) used to detect
+   *  changes of the input data of a scene. Not a cryptographic hash. */
+  struct Hash64
+  {
+    __forceinline Hash64 () 
+      : h(0xcbf29ce484222325ull) {}
+
+    /*! adds a single value to the hash */
+    __forceinline void add(uint64_t v) {
+      h = (h ^ v) * 0x100000001b3ull;
+    }
+
+    /*! adds bytes starting at ptr to the hash */
+    __forceinline void add(const void* ptr, size_t bytes) 
+    {
+      const char* p = (const char*) ptr;
+      for (; bytes >= 8; p+=8, bytes-=8) {
+        uint64_t v; memcpy(&v,p,8); add(v);
+      }
+      if (bytes) {
+        uint64_t v = 0; memcpy(&v,p,bytes); add(v);
+      }
+    }
+
+    /*! adds num items of a strided array, hashing only the first bytes of each item */
+    __forceinline void add(const char* ptr, size_t num, size_t stride, size_t bytes) 
+    {
+      add(uint64_t(num));
+      for (size_t i=0; i<num; i++) 
+        add(ptr+i*stride,bytes);
+    }
+
+    __forceinline operator uint64_t() const { return h; }
+
+  private:
+    uint64_t h;
+  };
+}
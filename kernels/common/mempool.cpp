@@ -0,0 +1,108 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "mempool.h"
+#include "default.h"
+
+namespace embree
+{
+  MemoryPool::MemoryPool (MemoryMonitorInterface* device, size_t maxBytes, bool hugepages)
+    : device(device), maxBytes(maxBytes), hugepages(hugepages), 
+      bytesCached(0), numAllocations(0), numReused(0), bytesReused(0) {}
+
+  MemoryPool::~MemoryPool () {
+    clear();
+  }
+
+  size_t MemoryPool::roundBytes(size_t bytes) const
+  {
+    /* 4 size classes per power of two, wastes at most 25% of memory */
+    size_t step = hugepages ? 2*1024*1024 : 4*1024;
+    while (8*step < bytes) step *= 2;
+    return (bytes+step-1) & ~(step-1);
+  }
+
+  void* MemoryPool::malloc(size_t bytes, size_t& bytesCommitted)
+  {
+    assert(bytes == roundBytes(bytes));
+    {
+      Lock<MutexSys> lock(mutex);
+      numAllocations++;
+      auto i = regions.find(bytes);
+      if (i != regions.end()) 
+      {
+        void* ptr = i->second.ptr;
+        bytesCommitted = i->second.bytesCommitted;
+        regions.erase(i);
+        bytesCached -= bytes;
+        numReused++;
+        bytesReused += bytes;
+        return ptr;
+      }
+    }
+    bytesCommitted = 0;
+    void* ptr = os_reserve(bytes);
+    if (device) os_numa_policy(ptr,bytes,device->numaPolicy());
+    return ptr;
+  }
+
+  void MemoryPool::free(void* ptr, size_t bytes, size_t bytesCommitted)
+  {
+    if (bytes == roundBytes(bytes)) 
+    {
+      Lock<MutexSys> lock(mutex);
+      if (bytesCached+bytes <= maxBytes) {
+        regions.insert(std::make_pair(bytes,Region(ptr,bytesCommitted)));
+        bytesCached += bytes;
+        return;
+      }
+    }
+    os_free(ptr,bytes);
+    if (device) device->memoryMonitor(-ssize_t(bytesCommitted),true);
+  }
+
+  void MemoryPool::clear()
+  {
+    Lock<MutexSys> lock(mutex);
+    for (auto& i : regions) {
+      os_free(i.second.ptr,i.first);
+      if (device) device->memoryMonitor(-ssize_t(i.second.bytesCommitted),true);
+    }
+    regions.clear();
+    bytesCached = 0;
+  }
+
+  void MemoryPool::print()
+  {
+    Lock<MutexSys> lock(mutex);
+    std::cout << "memory pool:" << std::endl;
+    std::cout << "  allocations    = " << numAllocations << std::endl;
+    std::cout << "  reused         = " << numReused << " (" << 1E-6*double(bytesReused) << " MB)" << std::endl;
+    std::cout << "  cached         = " << regions.size() << " (" << 1E-6*double(bytesCached) << " MB)" << std::endl;
+  }
+
+  size_t MemoryPool::getCachedBytes() const
+  {
+    Lock<MutexSys> lock(mutex);
+    return bytesCached;
+  }
+
+  size_t MemoryPool::getReusedBytes() const
+  {
+    Lock<MutexSys> lock(mutex);
+    return bytesReused;
+  }
+}
@@ -0,0 +1,95 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "../../common/sys/platform.h"
+#include "../../common/sys/alloc.h"
+#include "../../common/sys/mutex.h"
+#include <map>
+
+namespace embree
+{
+  struct MemoryMonitorInterface;
+
+  /*! Device wide pool of page allocations. Memory blocks of the BVH
+   *  allocators and large temporary build arrays are returned to the
+   *  pool instead of the OS, such that rebuilds of dynamic scenes can
+   *  reuse already committed memory and do not page fault again. Pooled
+   *  memory stays accounted in the memory monitor until it leaves the
+   *  pool. */
+  class MemoryPool
+  {
+    ALIGNED_CLASS;
+
+  public:
+
+    /*! minimal size of temporary allocations that go through the pool */
+    static const size_t minTemporaryBytes = 64*1024;
+
+    /*! creates pool that caches up to maxBytes of freed memory */
+    MemoryPool (MemoryMonitorInterface* device, size_t maxBytes, bool hugepages);
+
+    /*! releases all cached memory */
+    ~MemoryPool ();
+
+    /*! rounds a number of bytes to the size class of the pool */
+    size_t roundBytes(size_t bytes) const;
+
+    /*! returns a memory region of bytes bytes, which has to be a
+     *  rounded size, bytesCommitted returns the number of bytes
+     *  already reported to the memory monitor for that region */
+    void* malloc(size_t bytes, size_t& bytesCommitted);
+
+    /*! returns a memory region of bytes bytes to the pool, of which
+     *  bytesCommitted were reported to the memory monitor */
+    void free(void* ptr, size_t bytes, size_t bytesCommitted);
+
+    /*! releases all cached memory to the OS */
+    void clear();
+
+    /*! prints pool statistics */
+    void print();
+
+    /*! returns the number of bytes currently cached */
+    size_t getCachedBytes() const;
+
+    /*! returns the number of bytes served from the cache so far */
+    size_t getReusedBytes() const;
+
+  private:
+    struct Region 
+    {
+      Region (void* ptr, size_t bytesCommitted)
+        : ptr(ptr), bytesCommitted(bytesCommitted) {}
+
+      void* ptr;
+      size_t bytesCommitted;
+    };
+
+  private:
+    MemoryMonitorInterface* device;
+    const size_t maxBytes;             //!< maximal number of cached bytes
+    const bool hugepages;              //!< rounds regions to multiples of 2MB to enable huge pages
+    mutable MutexSys mutex;
+    std::multimap<size_t,Region> regions; //!< cached regions sorted by size
+
+    size_t bytesCached;                //!< number of bytes currently cached
+    size_t numAllocations;             //!< number of allocations served
+    size_t numReused;                  //!< number of allocations served from cache
+    size_t bytesReused;                //!< number of bytes served from cache
+  };
+}
@@ -172,6 +172,9 @@ namespace embree
       }
       N = l;
     }
+
+    /* returns the instance ID of some nesting level */
+    __forceinline int& instIDLevel(const size_t level) { return level == 0 ? instID : instIDNested[level-1]; }
     
     /* Ray data */
     Vec3fa org;  // ray origin
@@ -188,6 +191,7 @@ namespace embree
     int geomID;  // geometry ID
     int primID;  // primitive ID
     int instID;  // instance ID
+    int instIDNested[RTC_MAX_INSTANCE_LEVEL_COUNT-1]; // instance IDs of nested instances
 
 #if defined(__AVX512F__)
     __forceinline void update(const vbool16& m_mask,
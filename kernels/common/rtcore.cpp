@@ -222,6 +222,16 @@ namespace embree
     scene->setProgressMonitorFunction(func,ptr);
     RTCORE_CATCH_END(scene->device);
   }
+
+  RTCORE_API void rtcSetBuildPriority(RTCScene hscene, int priority) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetBuildPriority);
+    RTCORE_VERIFY_HANDLE(hscene);
+    scene->setBuildPriority(priority);
+    RTCORE_CATCH_END(scene->device);
+  }
   
   RTCORE_API void rtcCommit (RTCScene hscene) 
   {
@@ -263,6 +273,130 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API bool rtcLoadSceneCache(RTCScene hscene, const char* filename) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcLoadSceneCache);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_HANDLE(filename);
+    return scene->loadCache(filename);
+    RTCORE_CATCH_END(scene->device);
+    return false;
+  }
+
+  RTCORE_API void rtcSaveSceneCache(RTCScene hscene, const char* filename) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSaveSceneCache);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_HANDLE(filename);
+    scene->saveCache(filename);
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  RTCORE_API void rtcGetSceneStatistics(RTCScene hscene, RTCSceneStatistics* stats) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcGetSceneStatistics);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_HANDLE(stats);
+    for (size_t i=0; i<RTC_STAT_NUM_ENTRY_POINTS; i++) {
+      stats->raysIntersected[i] = scene->stat.get(ShardedStat::Counter(ShardedStat::INTERSECT1+i));
+      stats->raysOccluded[i]    = scene->stat.get(ShardedStat::Counter(ShardedStat::OCCLUDED1+i));
+    }
+    stats->nodesVisited  = scene->stat.get(ShardedStat::NODES_VISITED);
+    stats->leavesVisited = scene->stat.get(ShardedStat::LEAVES_VISITED);
+    scene->buildStat.sum(stats->numBuilds,stats->buildTime,stats->bytes);
+    BuildStat::Accel accel;
+    for (stats->numAccels=0; scene->buildStat.get(stats->numAccels,accel); stats->numAccels++);
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  RTCORE_API bool rtcGetSceneAccelStatistics(RTCScene hscene, size_t i, RTCAccelStatistics* stats) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcGetSceneAccelStatistics);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_HANDLE(stats);
+    BuildStat::Accel accel;
+    if (!scene->buildStat.get(i,accel)) return false;
+    strncpy(stats->builder,accel.builder.c_str(),sizeof(stats->builder)-1);
+    stats->builder[sizeof(stats->builder)-1] = 0;
+    strncpy(stats->primitiveType,accel.primTy.c_str(),sizeof(stats->primitiveType)-1);
+    stats->primitiveType[sizeof(stats->primitiveType)-1] = 0;
+    stats->numBuilds     = accel.numBuilds;
+    stats->buildTime     = accel.buildTime;
+    stats->lastBuildTime = accel.lastBuildTime;
+    stats->numPrimitives = accel.numPrimitives;
+    stats->bytes         = accel.bytes;
+    return true;
+    RTCORE_CATCH_END(scene->device);
+    return false;
+  }
+
+  RTCORE_API void rtcResetSceneStatistics(RTCScene hscene) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcResetSceneStatistics);
+    RTCORE_VERIFY_HANDLE(hscene);
+    scene->stat.clear();
+    scene->buildStat.clear();
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  /*! counts rays passed to some API entry point in the statistics of the scene and its device */
+  static __forceinline void countRays(Scene* scene, ShardedStat::Counter counter, size_t N) 
+  {
+    scene->stat.add(counter,N);
+    scene->device->stat.add(counter,N);
+  }
+
+  /*! returns the number of rays of a packet enabled by the valid mask */
+  static __forceinline size_t countValidRays(const void* valid, size_t N) 
+  {
+    size_t cnt = 0;
+    for (size_t i=0; i<N; i++) cnt += ((int*)valid)[i] == -1;
+    return cnt;
+  }
+
+  /*! returns the number of active rays (tnear <= tfar) of a stream of single rays */
+  static __forceinline size_t countActiveRays(const RTCRay* rays, size_t M, size_t stride) 
+  {
+    size_t cnt = 0;
+    for (size_t i=0; i<M; i++) {
+      const RTCRay& ray = *(RTCRay*)((char*)rays + i*stride);
+      cnt += ray.tnear <= ray.tfar;
+    }
+    return cnt;
+  }
+
+  /*! returns the number of active rays (tnear <= tfar) of a stream of M ray packets of size N */
+  static __forceinline size_t countActiveRays(RTCRayN* rays, size_t N, size_t M, size_t stride) 
+  {
+    if (N == 1) return countActiveRays((RTCRay*)rays,M,stride);
+    size_t cnt = 0;
+    for (size_t j=0; j<M; j++) {
+      RTCRayN* rayN = (RTCRayN*)((char*)rays + j*stride);
+      for (size_t i=0; i<N; i++)
+        cnt += RTCRayN_tnear(rayN,N,i) <= RTCRayN_tfar(rayN,N,i);
+    }
+    return cnt;
+  }
+
+  /*! returns the number of active rays (tnear <= tfar) of a stream of rays stored as pointers to arrays */
+  static __forceinline size_t countActiveRays(const RTCRayNp& rays, size_t N) 
+  {
+    size_t cnt = 0;
+    for (size_t i=0; i<N; i++)
+      cnt += (rays.tnear ? rays.tnear[i] : 0.0f) <= rays.tfar[i];
+    return cnt;
+  }
+
   RTCORE_API void rtcGetBounds(RTCScene hscene, RTCBounds& bounds_o)
   {
     Scene* scene = (Scene*) hscene;
@@ -297,6 +431,7 @@ namespace embree
 #endif
 
     STAT3(normal.travs,1,1,1);
+    countRays(scene,ShardedStat::INTERSECT1,1);
     scene->intersect(ray,nullptr);
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
@@ -320,6 +455,7 @@ namespace embree
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,1,cnt,4);
+    countRays(scene,ShardedStat::INTERSECT4,countValidRays(valid,4));
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RTCRay4 old_ray = ray;
@@ -352,6 +488,7 @@ namespace embree
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<8; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,1,cnt,8);
+    countRays(scene,ShardedStat::INTERSECT8,countValidRays(valid,8));
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RTCRay8 old_ray = ray;
@@ -384,6 +521,7 @@ namespace embree
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<16; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,1,cnt,16);
+    countRays(scene,ShardedStat::INTERSECT16,countValidRays(valid,16));
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RTCRay16 old_ray = ray;
@@ -414,6 +552,7 @@ namespace embree
     if (((size_t)rays ) & 0x03) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,M,1,1);
+    countRays(scene,ShardedStat::INTERSECT1M,countActiveRays(rays,M,stride));
    
     /* fast codepath for single rays */
     if (likely(M == 1)) {
@@ -444,6 +583,7 @@ namespace embree
     if (((size_t)rays ) & 0x03) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,N*M,N,N);
+    countRays(scene,ShardedStat::INTERSECTNM,countActiveRays(rays,N,M,stride));
 
     /* code path for single ray streams */
     if (likely(N == 1))
@@ -498,6 +638,7 @@ namespace embree
     if (((size_t)rays.instID ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.instID not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,N,N,N);
+    countRays(scene,ShardedStat::INTERSECTNP,countActiveRays(rays,N));
 
     scene->device->rayStreamFilters.filterSOP(scene,rays,N,context,true);
 #else
@@ -512,6 +653,7 @@ namespace embree
     RTCORE_CATCH_BEGIN;
     RTCORE_TRACE(rtcOccluded);
     STAT3(shadow.travs,1,1,1);
+    countRays(scene,ShardedStat::OCCLUDED1,1);
 #if defined(DEBUG)
     RTCORE_VERIFY_HANDLE(hscene);
     if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
@@ -545,6 +687,7 @@ namespace embree
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,1,cnt,4);
+    countRays(scene,ShardedStat::OCCLUDED4,countValidRays(valid,4));
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RTCRay4 old_ray = ray;
@@ -577,6 +720,7 @@ namespace embree
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<8; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,1,cnt,8);
+    countRays(scene,ShardedStat::OCCLUDED8,countValidRays(valid,8));
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RTCRay8 old_ray = ray;
@@ -609,6 +753,7 @@ namespace embree
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<16; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,1,cnt,16);
+    countRays(scene,ShardedStat::OCCLUDED16,countValidRays(valid,16));
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RTCRay16 old_ray = ray;
@@ -639,6 +784,7 @@ namespace embree
     if (((size_t)rays ) & 0x03) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,M,1,1);
+    countRays(scene,ShardedStat::OCCLUDED1M,countActiveRays(rays,M,stride));
 
     /* fast codepath for streams of size 1 */
     if (likely(M == 1)) {
@@ -669,6 +815,7 @@ namespace embree
     if (((size_t)rays ) & 0x03) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,N*M,N,N);
+    countRays(scene,ShardedStat::OCCLUDEDNM,countActiveRays(rays,N,M,stride));
 
     /* codepath for single rays */
     if (likely(N == 1))
@@ -723,6 +870,7 @@ namespace embree
     if (((size_t)rays.instID ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.instID not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,N,N,N);
+    countRays(scene,ShardedStat::OCCLUDEDNP,countActiveRays(rays,N));
 
     scene->device->rayStreamFilters.filterSOP(scene,rays,N,context,false);
 #else
@@ -1174,6 +1322,17 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcSetIntersectFunctionNM (RTCScene hscene, unsigned geomID, RTCIntersectFuncNM intersect) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetIntersectFunctionNM);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    scene->get_locked(geomID)->setIntersectFunctionNM(intersect);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcSetOccludedFunction (RTCScene hscene, unsigned geomID, RTCOccludedFunc occluded) 
   {
     Scene* scene = (Scene*) hscene;
@@ -1240,6 +1399,17 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcSetOccludedFunctionNM (RTCScene hscene, unsigned geomID, RTCOccludedFuncNM occluded) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetOccludedFunctionNM);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    scene->get_locked(geomID)->setOccludedFunctionNM(occluded);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcSetIntersectionFilterFunction (RTCScene hscene, unsigned geomID, RTCFilterFunc intersect) 
   {
     Scene* scene = (Scene*) hscene;
@@ -1395,6 +1565,20 @@ namespace embree
   }
 #endif
 
+  RTCORE_API void rtcInterpolateM(RTCScene hscene, const unsigned* geomIDs, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
+                                  RTCBufferType buffer,
+                                  float* P, float* dPdu, float* dPdv, 
+                                  float* ddPdudu, float* ddPdvdv, float* ddPdudv, 
+                                  size_t numFloats)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcInterpolateM);
+    RTCORE_VERIFY_HANDLE(hscene);
+    scene->interpolateM(geomIDs,primIDs,u,v,numUVs,buffer,P,dPdu,dPdv,ddPdudu,ddPdvdv,ddPdudv,numFloats);
+    RTCORE_CATCH_END(scene->device);
+  }
+
 #if defined (RTCORE_RAY_PACKETS)
   RTCORE_API void rtcInterpolateN2(RTCScene hscene, unsigned geomID, 
                                    const void* valid_i, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
@@ -15,6 +15,7 @@
 // ======================================================================== //
 
 #include "../../include/embree2/rtcore.h"
+#include "../../include/embree2/rtcore_ray.h"
 
 namespace embree
 {
@@ -39,6 +40,7 @@ namespace embree
    /*! decoding of intersection flags */
   __forceinline bool isCoherent  (RTCIntersectFlags flags) { return !(flags & RTC_INTERSECT_INCOHERENT); }
   __forceinline bool isIncoherent(RTCIntersectFlags flags) { return   flags & RTC_INTERSECT_INCOHERENT;  }  
+  __forceinline bool isSortStream(RTCIntersectFlags flags) { return   flags & RTC_INTERSECT_SORT;  }
 
 #if TBB_INTERFACE_VERSION_MAJOR < 8    
 #  define USE_TASK_ARENA 0
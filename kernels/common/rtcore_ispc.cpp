@@ -108,6 +108,10 @@ namespace embree
     return rtcSetProgressMonitorFunction(scene,(RTCProgressMonitorFunc)func,ptr);
   }
 
+  extern "C" void ispcSetBuildPriority(RTCScene scene, int priority) {
+    return rtcSetBuildPriority(scene,priority);
+  }
+
   extern "C" void ispcCommit (RTCScene scene) {
     return rtcCommit(scene);
   }
@@ -116,6 +120,14 @@ namespace embree
     return rtcCommitThread(scene,threadID,numThreads);
   }
 
+  extern "C" bool ispcLoadSceneCache(RTCScene scene, const char* filename) {
+    return rtcLoadSceneCache(scene,filename);
+  }
+
+  extern "C" void ispcSaveSceneCache(RTCScene scene, const char* filename) {
+    rtcSaveSceneCache(scene,filename);
+  }
+
   extern "C" void ispcGetBounds(RTCScene scene, RTCBounds& bounds_o) {
     rtcGetBounds(scene,bounds_o);
   }
@@ -367,6 +379,17 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  extern "C" void ispcSetIntersectFunctionNM (RTCScene hscene, unsigned geomID, RTCIntersectFuncNM intersect) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetIntersectFunctionNM);
+    RTCORE_VERIFY_HANDLE(scene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    ((Scene*)scene)->get_locked(geomID)->setIntersectFunctionNM(intersect);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   extern "C" void ispcSetOccludedFunction1 (RTCScene hscene, unsigned geomID, RTCOccludedFunc occluded) 
   {
     Scene* scene = (Scene*) hscene;
@@ -433,6 +456,17 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  extern "C" void ispcSetOccludedFunctionNM (RTCScene hscene, unsigned geomID, RTCOccludedFuncNM occluded) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetOccludedFunctionNM);
+    RTCORE_VERIFY_HANDLE(scene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    ((Scene*)scene)->get_locked(geomID)->setOccludedFunctionNM(occluded);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   extern "C" void ispcSetIntersectionFilterFunction1 (RTCScene hscene, unsigned geomID, RTCFilterFunc filter) 
   {
     Scene* scene = (Scene*) hscene;
@@ -571,4 +605,14 @@ namespace embree
   {
     rtcInterpolateN2(scene,geomID,valid,primIDs,u,v,numUVs,buffer,P,dPdu,dPdv,ddPdudu,ddPdvdv,ddPdudv,numFloats);
   }
+
+  extern "C" void ispcInterpolateM(RTCScene scene, const unsigned int* geomIDs, 
+                                   const unsigned int* primIDs, const float* u, const float* v, size_t numUVs, 
+                                   RTCBufferType buffer, 
+                                   float* P, float* dPdu, float* dPdv,
+                                   float* ddPdudu, float* ddPdvdv, float* ddPdudv,
+                                   size_t numFloats)
+  {
+    rtcInterpolateM(scene,geomIDs,primIDs,u,v,numUVs,buffer,P,dPdu,dPdv,ddPdudu,ddPdvdv,ddPdudv,numFloats);
+  }
 }
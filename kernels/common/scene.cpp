@@ -15,6 +15,7 @@
 // ======================================================================== //
 
 #include "scene.h"
+#include "version.h"
 
 #include "../xeon/bvh/bvh4_factory.h"
 #include "../xeon/bvh/bvh8_factory.h"
@@ -41,7 +42,8 @@ namespace embree
       numIntersectionFilters1(0), numIntersectionFilters4(0), numIntersectionFilters8(0), numIntersectionFilters16(0), numIntersectionFiltersN(0),
       commitCounter(0), commitCounterSubdiv(0), 
       progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0),
-      progressInterface(this)
+      progressInterface(this),
+      cacheHashRequested(false), cacheHashValid(false), cacheHash(0), cache_mem(nullptr), size_cache_mem(0), buildPriority(0)
   {
 #if defined(TASKING_INTERNAL)
     scheduler = nullptr;
@@ -129,6 +131,7 @@ namespace embree
     else if (device->tri_accel == "bvh4.triangle4")       accels.add(device->bvh4_factory->BVH4Triangle4(this));
     else if (device->tri_accel == "bvh4.triangle4v")      accels.add(device->bvh4_factory->BVH4Triangle4v(this));
     else if (device->tri_accel == "bvh4.triangle4i")      accels.add(device->bvh4_factory->BVH4Triangle4i(this));
+    else if (device->tri_accel == "bvh4.triangle4q")      accels.add(device->bvh4_factory->BVH4Triangle4q(this));
 
 #if defined (__TARGET_AVX__)
     else if (device->tri_accel == "bvh8.triangle4")       accels.add(device->bvh8_factory->BVH8Triangle4(this));
@@ -148,10 +151,16 @@ namespace embree
       case /*0b00*/ 0:
 #if defined (__TARGET_AVX__)
         if (device->hasISA(AVX))
-          accels.add(device->bvh8_factory->BVH8Quad4v(this));
+        {
+          if (isStatic() && isHighQuality()) accels.add(device->bvh8_factory->BVH8Quad4vSpatialSplit(this));
+          else                               accels.add(device->bvh8_factory->BVH8Quad4v(this));
+        }
         else
 #endif
-          accels.add(device->bvh4_factory->BVH4Quad4v(this));
+        {
+          if (isStatic() && isHighQuality()) accels.add(device->bvh4_factory->BVH4Quad4vSpatialSplit(this));
+          else                               accels.add(device->bvh4_factory->BVH4Quad4v(this));
+        }
         break;
 
       case /*0b01*/ 1:
@@ -258,20 +267,20 @@ namespace embree
         if (device->hasISA(AVX2)) // only enable on HSW machines, for SNB this codepath is slower
         {
           switch (mode) {
-          case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8OBBBezier1v(this,isHighQuality())); break;
+          case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8OBBBezier4v(this,isHighQuality())); break;
           case /*0b01*/ 1: accels.add(device->bvh8_factory->BVH8OBBBezier1v(this,isHighQuality())); break;
-          case /*0b10*/ 2: accels.add(device->bvh8_factory->BVH8OBBBezier1i(this,isHighQuality())); break;
-          case /*0b11*/ 3: accels.add(device->bvh8_factory->BVH8OBBBezier1i(this,isHighQuality())); break;
+          case /*0b10*/ 2: accels.add(device->bvh8_factory->BVH8QuantizedOBBBezier1i(this,isHighQuality())); break;
+          case /*0b11*/ 3: accels.add(device->bvh8_factory->BVH8QuantizedOBBBezier1i(this,isHighQuality())); break;
           }
         }
         else
 #endif
         {
           switch (mode) {
-          case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4OBBBezier1v(this,isHighQuality())); break;
+          case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4OBBBezier4v(this,isHighQuality())); break;
           case /*0b01*/ 1: accels.add(device->bvh4_factory->BVH4OBBBezier1v(this,isHighQuality())); break;
-          case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4OBBBezier1i(this,isHighQuality())); break;
-          case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4OBBBezier1i(this,isHighQuality())); break;
+          case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4QuantizedOBBBezier1i(this,isHighQuality())); break;
+          case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4QuantizedOBBBezier1i(this,isHighQuality())); break;
           }
         }
       }
@@ -289,9 +298,13 @@ namespace embree
     else if (device->hair_accel == "bvh4.bezier1i"    ) accels.add(device->bvh4_factory->BVH4Bezier1i(this));
     else if (device->hair_accel == "bvh4obb.bezier1v" ) accels.add(device->bvh4_factory->BVH4OBBBezier1v(this,false));
     else if (device->hair_accel == "bvh4obb.bezier1i" ) accels.add(device->bvh4_factory->BVH4OBBBezier1i(this,false));
+    else if (device->hair_accel == "bvh4obb.bezier4v" ) accels.add(device->bvh4_factory->BVH4OBBBezier4v(this,false));
+    else if (device->hair_accel == "qbvh4obb.bezier1i") accels.add(device->bvh4_factory->BVH4QuantizedOBBBezier1i(this,false));
 #if defined (__TARGET_AVX__)
     else if (device->hair_accel == "bvh8obb.bezier1v" ) accels.add(device->bvh8_factory->BVH8OBBBezier1v(this,false));
     else if (device->hair_accel == "bvh8obb.bezier1i" ) accels.add(device->bvh8_factory->BVH8OBBBezier1i(this,false));
+    else if (device->hair_accel == "bvh8obb.bezier4v" ) accels.add(device->bvh8_factory->BVH8OBBBezier4v(this,false));
+    else if (device->hair_accel == "qbvh8obb.bezier1i") accels.add(device->bvh8_factory->BVH8QuantizedOBBBezier1i(this,false));
 #endif
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown hair acceleration structure "+device->hair_accel);
 #endif
@@ -402,6 +415,8 @@ namespace embree
 #if TASKING_TBB
     delete group; group = nullptr;
 #endif
+
+    os_unmap_file(cache_mem,size_cache_mem);
   }
 
   void Scene::clear() {
@@ -415,6 +430,11 @@ namespace embree
 
   unsigned Scene::newInstance (Scene* scene, size_t numTimeSteps) 
   {
+    if (numTimeSteps == 0 || numTimeSteps > RTC_MAX_TIME_STEPS) {
+      throw_RTCError(RTC_INVALID_OPERATION,"only 1 to "+toString(RTC_MAX_TIME_STEPS)+" time steps supported");
+      return -1;
+    }
+
     Geometry* geom = new Instance(this,scene,numTimeSteps);
     return geom->id;
   }
@@ -431,8 +451,8 @@ namespace embree
       return -1;
     }
 
-    if (numTimeSteps == 0 || numTimeSteps > 2) {
-      throw_RTCError(RTC_INVALID_OPERATION,"only 1 or 2 time steps supported");
+    if (numTimeSteps == 0 || numTimeSteps > RTC_MAX_TIME_STEPS) {
+      throw_RTCError(RTC_INVALID_OPERATION,"only 1 to "+toString(RTC_MAX_TIME_STEPS)+" time steps supported");
       return -1;
     }
     
@@ -447,8 +467,8 @@ namespace embree
       return -1;
     }
 
-    if (numTimeSteps == 0 || numTimeSteps > 2) {
-      throw_RTCError(RTC_INVALID_OPERATION,"only 1 or 2 time steps supported");
+    if (numTimeSteps == 0 || numTimeSteps > RTC_MAX_TIME_STEPS) {
+      throw_RTCError(RTC_INVALID_OPERATION,"only 1 to "+toString(RTC_MAX_TIME_STEPS)+" time steps supported");
       return -1;
     }
     
@@ -526,6 +546,76 @@ namespace embree
     }
   }
 
+  void Scene::interpolateM(const unsigned* geomIDs, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
+                           RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats)
+  {
+    /* sort the hits by geometry and primitive, such that all hits of a geometry get interpolated by one vectorized call */
+    std::vector<std::pair<uint64_t,unsigned>> hits;
+    hits.reserve(numUVs);
+    for (size_t i=0; i<numUVs; i++) {
+      if (geomIDs[i] == RTC_INVALID_GEOMETRY_ID) continue;
+      hits.push_back(std::make_pair((uint64_t(geomIDs[i]) << 32) | uint64_t(primIDs[i]),unsigned(i)));
+    }
+    std::sort(hits.begin(),hits.end());
+
+    /* the vectorized interpolation reads full SIMD vectors and
+     * performs aligned (masked) stores, thus the hits of a geometry
+     * are padded to a multiple of 16 and stored in 64 byte aligned
+     * arrays, which keeps every row of the output arrays aligned */
+    avector<int,aligned_allocator<int,64>> lvalid;
+    avector<unsigned,aligned_allocator<unsigned,64>> lprimIDs;
+    avector<float,aligned_allocator<float,64>> lu, lv;
+    avector<float,aligned_allocator<float,64>> lP, ldPdu, ldPdv, lddPdudu, lddPdvdv, lddPdudv;
+    
+    for (size_t begin=0, end=0; begin<hits.size(); begin=end)
+    {
+      const unsigned geomID = unsigned(hits[begin].first >> 32);
+      for (end=begin+1; end<hits.size() && unsigned(hits[end].first >> 32) == geomID; end++);
+      const size_t N = end-begin;
+      
+      if (geomID >= size() || get_locked(geomID) == nullptr)
+        throw_RTCError(RTC_INVALID_ARGUMENT,"invalid geometry ID");
+      Geometry* geom = get_locked(geomID);
+      
+      /* gather hits of this geometry */
+      const size_t stride = (N+15) & size_t(-16);
+      lvalid.resize(stride); lprimIDs.resize(stride); lu.resize(stride); lv.resize(stride);
+      for (size_t i=0; i<N; i++) {
+        const unsigned j = hits[begin+i].second;
+        lvalid[i] = -1; lprimIDs[i] = primIDs[j]; lu[i] = u[j]; lv[i] = v[j];
+      }
+      for (size_t i=N; i<stride; i++) {
+        lvalid[i] = 0; lprimIDs[i] = 0; lu[i] = 0.0f; lv[i] = 0.0f;
+      }
+      const size_t numOut = stride*numFloats;
+      if (P)       lP.resize(numOut);
+      if (dPdu)    { ldPdu.resize(numOut); ldPdv.resize(numOut); }
+      if (ddPdudu) { lddPdudu.resize(numOut); lddPdvdv.resize(numOut); lddPdudv.resize(numOut); }
+      float* lPt       = P       ? lP.data()       : nullptr;
+      float* ldPdut    = dPdu    ? ldPdu.data()    : nullptr;
+      float* ldPdvt    = dPdu    ? ldPdv.data()    : nullptr;
+      float* lddPdudut = ddPdudu ? lddPdudu.data() : nullptr;
+      float* lddPdvdvt = ddPdudu ? lddPdvdv.data() : nullptr;
+      float* lddPdudvt = ddPdudu ? lddPdudv.data() : nullptr;
+
+      geom->interpolateN(lvalid.data(),lprimIDs.data(),lu.data(),lv.data(),stride,buffer,
+                         lPt,ldPdut,ldPdvt,lddPdudut,lddPdvdvt,lddPdudvt,numFloats);
+
+      /* scatter results back into original order */
+      for (size_t k=0; k<numFloats; k++) 
+      {
+        for (size_t i=0; i<N; i++) 
+        {
+          const size_t dst = k*numUVs+hits[begin+i].second;
+          const size_t src = k*stride+i;
+          if (P) P[dst] = lPt[src];
+          if (dPdu) { dPdu[dst] = ldPdut[src]; dPdv[dst] = ldPdvt[src]; }
+          if (ddPdudu) { ddPdudu[dst] = lddPdudut[src]; ddPdvdv[dst] = lddPdvdvt[src]; ddPdudv[dst] = lddPdudvt[src]; }
+        }
+      }
+    }
+  }
+
   void Scene::deleteGeometry(size_t geomID)
   {
     Lock<AtomicMutex> lock(geometriesMutex);
@@ -579,7 +669,19 @@ namespace embree
   
     /* build all hierarchies of this scene */
     accels.build(0,0);
-    
+
+    /* input buffers may get freed below, thus hash them now */
+    cacheHashValid = false;
+    if (cacheHashRequested) {
+      cacheHash = computeCacheHash();
+      cacheHashValid = true;
+    }
+
+    build_finish();
+  }
+
+  void Scene::build_finish ()
+  {
     /* make static geometry immutable */
     if (isStatic()) 
     {
@@ -621,7 +723,7 @@ namespace embree
       scheduler = this->scheduler;
       if (scheduler == null) {
         buildLock.lock();
-        this->scheduler = scheduler = new TaskScheduler;
+        this->scheduler = scheduler = new TaskScheduler(buildPriority);
       }
     }
 
@@ -718,7 +820,10 @@ namespace embree
 #else
       tbb::task_group_context ctx( tbb::task_group_context::isolated, tbb::task_group_context::default_traits | tbb::task_group_context::fp_settings );
 #endif
-      //ctx.set_priority(tbb::priority_high);
+#if __TBB_TASK_PRIORITY
+      if      (buildPriority > 0) ctx.set_priority(tbb::priority_high);
+      else if (buildPriority < 0) ctx.set_priority(tbb::priority_low);
+#endif
 
 #if USE_TASK_ARENA
       device->arena->execute([&]{
@@ -759,6 +864,154 @@ namespace embree
     }
   }
 
+  /*! header of scene cache files, followed by one entry per hierarchy */
+  struct SceneCacheHeader
+  {
+    char magick[8];
+    unsigned int version;
+    unsigned int numAccels;
+    uint64_t hash;
+  };
+
+  struct SceneCacheEntry 
+  {
+    size_t offset;  //!< page aligned offset of the hierarchy data in the file
+    size_t bytes;   //!< size of the hierarchy data
+  };
+
+  static const char sceneCacheMagick[8] = { 'E','M','B','R','B','V','H','C' };
+  static const unsigned int sceneCacheVersion = 1;
+  static const size_t sceneCachePageSize = 4096;
+
+  uint64_t Scene::computeCacheHash() const
+  {
+    /* hash geometries in parallel and combine in order */
+    std::vector<uint64_t> hashes(geometries.size());
+    parallel_for(geometries.size(), [&] (size_t i) 
+    {
+      Hash64 h;
+      const Geometry* geom = geometries[i];
+      if (geom == nullptr) { hashes[i] = h; return; }
+      h.add(uint64_t(geom->getType()));
+      h.add(uint64_t(geom->flags));
+      h.add(uint64_t(geom->numTimeSteps));
+      h.add(uint64_t(geom->numPrimitives));
+      h.add(uint64_t(geom->isEnabled()));
+      if (geom->isEnabled()) geom->hash(h);
+      hashes[i] = h;
+    });
+
+    Hash64 h;
+    h.add(uint64_t(__EMBREE_VERSION_NUMBER__));
+    h.add(uint64_t(flags));
+    h.add(uint64_t(aflags));
+    h.add(hashes.data(),hashes.size()*sizeof(uint64_t));
+    return h;
+  }
+
+  void Scene::saveCache(const char* fileName)
+  {
+    if (!isStatic())
+      throw_RTCError(RTC_INVALID_OPERATION,"only static scenes can get cached");
+
+    if (!isBuild() || isModified())
+      throw_RTCError(RTC_INVALID_OPERATION,"scene has to get committed before it can get cached");
+
+    /* buffers of static scenes are freed at commit, thus hash got typically calculated during commit */
+    if (!cacheHashValid) {
+      cacheHash = computeCacheHash();
+      cacheHashValid = true;
+    }
+
+    std::ofstream file(fileName,std::ios::binary);
+    if (!file.is_open()) 
+      throw_RTCError(RTC_INVALID_OPERATION,"cannot open file "+std::string(fileName));
+
+    SceneCacheHeader header;
+    memcpy(header.magick,sceneCacheMagick,sizeof(header.magick));
+    header.version = sceneCacheVersion;
+    header.numAccels = (unsigned int) accels.accels.size();
+    header.hash = cacheHash;
+    std::vector<SceneCacheEntry> entries(header.numAccels);
+    file.write((char*)&header,sizeof(header));
+    file.write((char*)entries.data(),entries.size()*sizeof(SceneCacheEntry));
+
+    /* each hierarchy starts at a page boundary such that it stays aligned when mapped */
+    for (size_t i=0; i<accels.accels.size(); i++) 
+    {
+      while ((file.tellp() % sceneCachePageSize) != 0) { char c = 0; file.write(&c,1); }
+      entries[i].offset = file.tellp();
+      accels.accels[i]->writeCache(file);
+      entries[i].bytes = size_t(file.tellp())-entries[i].offset;
+    }
+
+    file.seekp(sizeof(header));
+    file.write((char*)entries.data(),entries.size()*sizeof(SceneCacheEntry));
+    if (!file.good())
+      throw_RTCError(RTC_UNKNOWN_ERROR,"error writing file "+std::string(fileName));
+  }
+
+  bool Scene::loadCache(const char* fileName)
+  {
+    if (!isStatic())
+      throw_RTCError(RTC_INVALID_OPERATION,"only static scenes can get cached");
+
+    if (!ready())
+      throw_RTCError(RTC_INVALID_OPERATION,"not all buffers are unmapped");
+
+    /* the hash gets also calculated during the commit following a cache miss */
+    cacheHashRequested = true;
+    if (!isModified()) 
+      return isBuild();
+
+    const uint64_t hash = computeCacheHash();
+
+    size_t bytes = 0;
+    char* ptr = (char*) os_map_file(fileName,bytes);
+    if (ptr == nullptr) 
+      return false;
+
+    /* validate header */
+    const SceneCacheHeader* header = (const SceneCacheHeader*) ptr;
+    const SceneCacheEntry* entries = (const SceneCacheEntry*) (ptr+sizeof(SceneCacheHeader));
+    bool valid = bytes >= sizeof(SceneCacheHeader) 
+      && memcmp(header->magick,sceneCacheMagick,sizeof(header->magick)) == 0
+      && header->version == sceneCacheVersion
+      && header->numAccels == accels.accels.size()
+      && header->hash == hash
+      && bytes >= sizeof(SceneCacheHeader)+header->numAccels*sizeof(SceneCacheEntry);
+
+    /* relocate all hierarchies */
+    for (size_t i=0; valid && i<accels.accels.size(); i++) 
+    {
+      const SceneCacheEntry& entry = entries[i];
+      valid = entry.offset % sceneCachePageSize == 0 && entry.offset <= bytes && entry.bytes <= bytes-entry.offset
+        && accels.accels[i]->loadCache(ptr+entry.offset,entry.bytes);
+    }
+
+    if (!valid) {
+      accels.clear();
+      os_unmap_file(ptr,bytes);
+      return false;
+    }
+
+    os_unmap_file(cache_mem,size_cache_mem);
+    cache_mem = ptr;
+    size_cache_mem = bytes;
+    cacheHash = hash;
+    cacheHashValid = true;
+
+    /* finish commit like after a regular build */
+    progress_monitor_counter = 0;
+    accels.select(numIntersectionFiltersN+numIntersectionFilters4,
+                  numIntersectionFiltersN+numIntersectionFilters8,
+                  numIntersectionFiltersN+numIntersectionFilters16,
+                  numIntersectionFiltersN);
+    accels.updateValidAccels();
+    build_finish();
+    return true;
+  }
+
   void Scene::setProgressMonitorFunction(RTCProgressMonitorFunc func, void* ptr) 
   {
     static MutexSys mutex;
@@ -768,6 +1021,10 @@ namespace embree
     mutex.unlock();
   }
 
+  void Scene::setBuildPriority(int priority) {
+    buildPriority = priority;
+  }
+
   void Scene::progressMonitor(double dn)
   {
     if (progress_monitor_function) {
@@ -55,7 +55,7 @@ namespace embree
         if (geom == nullptr) return nullptr;
         if (!all && !geom->isEnabled()) return nullptr;
         if (geom->getType() != Ty::geom_type) return nullptr;
-        if (geom->numTimeSteps != timeSteps) return nullptr;
+        if ((geom->numTimeSteps == 1) != (timeSteps == 1)) return nullptr; // timeSteps == 2 iterates over all motion blurred geometries
         return (Ty*) geom;
       }
 
@@ -135,13 +135,27 @@ namespace embree
     /*! deletes some geometry */
     void deleteGeometry(size_t geomID);
 
+    /*! interpolates user data for hits on arbitrary geometries of the scene */
+    void interpolateM(const unsigned* geomIDs, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
+                      RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
+
     /*! Builds acceleration structure for the scene. */
     void build (size_t threadIndex, size_t threadCount);
     void build_task ();
+    void build_finish ();
 
     /*! stores scene into binary file */
     void write(std::ofstream& file);
 
+    /*! computes hash over all input data relevant for hierarchy construction */
+    uint64_t computeCacheHash() const;
+
+    /*! stores the hierarchies of the committed scene into a cache file */
+    void saveCache(const char* fileName);
+
+    /*! commits the scene using the hierarchies of a cache file, returns false if the cache does not match the scene */
+    bool loadCache(const char* fileName);
+
     void updateInterface();
 
     /* return number of geometries */
@@ -306,6 +320,14 @@ namespace embree
     MutexSys buildMutex;
     AtomicMutex geometriesMutex;
     bool modified;                   //!< true if scene got modified
+    bool cacheHashRequested;         //!< true if input hash for the scene cache is computed during commit
+    bool cacheHashValid;             //!< true if cacheHash matches the committed scene
+    uint64_t cacheHash;              //!< hash of the input data of the committed scene
+    void* cache_mem;                 //!< mapped scene cache file the hierarchies got loaded from
+    size_t size_cache_mem;
+    int buildPriority;               //!< builds of higher priority get worker threads first
+    ShardedStat stat;                //!< always enabled ray tracing counters
+    BuildStat buildStat;             //!< build time and memory of each acceleration structure
     
     /*! global lock step task scheduler */
 #if defined(TASKING_INTERNAL)
@@ -331,6 +353,9 @@ namespace embree
     void progressMonitor(double nprims);
     void setProgressMonitorFunction(RTCProgressMonitorFunc func, void* ptr);
 
+    /*! sets the priority of the builds of this scene */
+    void setBuildPriority(int priority);
+
   public:
     struct GeometryCounts 
     {
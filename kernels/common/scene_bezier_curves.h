@@ -39,6 +39,7 @@ namespace embree
     
     /*! writes the bezier curve geometry to disk */
     void write(std::ofstream& file);
+    void hash(Hash64& h) const;
     
   public:
     void enabling();
@@ -38,11 +38,44 @@ namespace embree
 #endif
   }
 
+  __thread size_t Instance::level = 0;
+
+  /* decomposes a transformation into translation, rotation, and a symmetric scale and shear matrix through polar decomposition */
+  static Instance::MotionKey decompose(const AffineSpace3fa& xfm)
+  {
+    Instance::MotionKey key;
+    key.translation = xfm.p;
+    key.rotation = Quaternion3f(one);
+    key.scale = xfm.l;
+    key.rotation_perp = Quaternion3f(zero);
+    key.angle = 0.0f;
+
+    /* reflections cannot be represented by a rotation and are moved into the scale part */
+    const float det = xfm.l.det();
+    if (abs(det) < 1E-20f) return key;
+    LinearSpace3fa R = det < 0.0f ? -xfm.l : xfm.l;
+
+    /* converges quadratically to the closest rotation */
+    for (size_t i=0; i<32; i++) 
+    {
+      const LinearSpace3fa Rn = 0.5f*(R + rcp(R).transposed());
+      const Vec3fa d = abs(Rn.vx-R.vx) + abs(Rn.vy-R.vy) + abs(Rn.vz-R.vz);
+      R = Rn;
+      if (reduce_max(d) < 1E-7f) break;
+    }
+    key.rotation = normalize(Quaternion3f(R.vx,R.vy,R.vz));
+    key.scale = R.transposed()*xfm.l;
+    return key;
+  }
+
   Instance::Instance (Scene* parent, Scene* object, size_t numTimeSteps) 
-    : AccelSet(parent,1,numTimeSteps), object(object)
+    : AccelSet(parent,1,numTimeSteps), world2local0(one), local2world(numTimeSteps), keys(numTimeSteps), object(object), 
+      maxLevel(min(parent->device->max_instance_level,size_t(RTC_MAX_INSTANCE_LEVEL_COUNT)))
   {
-    local2world[0] = local2world[1] = one;
-    world2local[0] = world2local[1] = one;
+    for (size_t i=0; i<numTimeSteps; i++) {
+      local2world[i] = one;
+      keys[i] = decompose(local2world[i]);
+    }
     intersectors.ptr = this;
     boundsFunc2 = parent->device->instance_factory->InstanceBoundsFunc;
     intersectors.intersector1 = parent->device->instance_factory->InstanceIntersector1;
@@ -61,7 +94,72 @@ namespace embree
       throw_RTCError(RTC_INVALID_OPERATION,"invalid timestep");
 
     local2world[timeStep] = xfm;
-    world2local[timeStep] = rcp(xfm);
+    if (timeStep == 0) world2local0 = rcp(xfm);
+    
+    keys[timeStep] = decompose(xfm);
+    if (timeStep > 0) updateTimeSegment(timeStep-1);
+    if (timeStep+1 < numTimeSteps) updateTimeSegment(timeStep);
+  }
+
+  void Instance::updateTimeSegment(size_t itime)
+  {
+    /* interpolate along the shorter arc, q and -q encode the same rotation */
+    MotionKey& k0 = keys[itime+0];
+    const Quaternion3f q0 = k0.rotation;
+    Quaternion3f q1 = keys[itime+1].rotation;
+    float cosAngle = dot(q0,q1);
+    if (cosAngle < 0.0f) { q1 = -q1; cosAngle = -cosAngle; }
+
+    const float sinAngle = sqrt(max(0.0f,1.0f-cosAngle*cosAngle));
+    if (sinAngle < 1E-6f) {
+      k0.angle = 0.0f;
+      k0.rotation_perp = Quaternion3f(zero);
+    } else {
+      k0.angle = atan2(sinAngle,cosAngle);
+      k0.rotation_perp = (q1-q0*cosAngle)*rcp(sinAngle);
+    }
+  }
+
+  AffineSpace3fa Instance::getLocal2World(size_t itime, float ftime) const
+  {
+    const MotionKey& k0 = keys[itime+0];
+    const MotionKey& k1 = keys[itime+1];
+    float s,c; sincosf(ftime*k0.angle,&s,&c);
+    const LinearSpace3fa R(c*k0.rotation + s*k0.rotation_perp);
+    return AffineSpace3fa(R*lerp(k0.scale,k1.scale,ftime),lerp(k0.translation,k1.translation,ftime));
+  }
+
+  BBox3fa Instance::boundsMotionBlur() const
+  {
+    /* The bounds are the union of the bounds at a number of sample
+     * times, extended by the maximal distance of the motion to the
+     * linear motion between two samples. This distance is bounded by
+     * dt^2/8 max|p''(t)|, where for p(t) = T(t) + R(t)S(t)x with linear
+     * T and S and constant angular velocity w of R we have |p''(t)| <=
+     * w^2 |S(t)x| + 2w |S'(t)x|. */
+    const size_t numSamples = 16;
+    const BBox3fa& lbounds = object->bounds;
+    BBox3fa bounds = empty;
+    for (size_t itime=0; itime+1<numTimeSteps; itime++)
+    {
+      const MotionKey& k0 = keys[itime+0];
+      const MotionKey& k1 = keys[itime+1];
+      float r = 0.0f, dr = 0.0f;
+      for (size_t i=0; i<8; i++) {
+        const Vec3fa x(i&1 ? lbounds.upper.x : lbounds.lower.x, i&2 ? lbounds.upper.y : lbounds.lower.y, i&4 ? lbounds.upper.z : lbounds.lower.z);
+        r  = max(r,length(xfmVector(k0.scale,x)),length(xfmVector(k1.scale,x)));
+        dr = max(dr,length(xfmVector(k1.scale-k0.scale,x)));
+      }
+      const float w = 2.0f*k0.angle;
+      const float dt = 1.0f/float(numSamples);
+      const float err = 0.125f*dt*dt*(w*w*r + 2.0f*w*dr);
+
+      BBox3fa sbounds = empty;
+      for (size_t i=0; i<=numSamples; i++)
+        sbounds.extend(xfmBounds(getLocal2World(itime,float(i)*dt),lbounds));
+      bounds.extend(enlarge(sbounds,Vec3fa(err)));
+    }
+    return bounds;
   }
 
   void Instance::setMask (unsigned mask) 
@@ -35,35 +35,104 @@ namespace embree
   /*! Instanced acceleration structure */
   struct Instance : public AccelSet
   {
+    /*! transformation of a time step decomposed into scale, rotation, and translation */
+    struct MotionKey
+    {
+      LinearSpace3fa scale;        //!< symmetric scale and shear matrix
+      Quaternion3f rotation;       //!< rotation as unit quaternion
+      Quaternion3f rotation_perp;  //!< unit quaternion orthogonal to the rotation towards the rotation of the next time step
+      Vec3fa translation;          //!< translation
+      float angle;                 //!< angle between the rotation quaternions of this and the next time step
+    };
+
   public:
     Instance (Scene* parent, Scene* object, size_t numTimeSteps); 
     virtual void setTransform(const AffineSpace3fa& local2world, size_t timeStep);
     virtual void setMask (unsigned mask);
     virtual void build(size_t threadIndex, size_t threadCount) {}
 
+    /*! calculates the bounds of the instance over the whole time range */
+    BBox3fa boundsMotionBlur() const;
+
+  private:
+    void updateTimeSegment(size_t itime);
+    AffineSpace3fa getLocal2World(size_t itime, float ftime) const;
+
   public:
 
     __forceinline AffineSpace3fa getWorld2Local() const {
-      return world2local[0];
+      return world2local0;
     }
 
-    __forceinline AffineSpace3fa getWorld2Local(float time) const {
-      return rcp(lerp(local2world[0],local2world[1],time));
+    /*! interpolates the transformation from world to local space at local time ftime of the itime'th time segment */
+    __forceinline AffineSpace3fa getWorld2Local(int itime, float ftime) const
+    {
+      const MotionKey& k0 = keys[itime+0];
+      const MotionKey& k1 = keys[itime+1];
+      float s,c; sincosf(ftime*k0.angle,&s,&c);
+      const LinearSpace3fa R(c*k0.rotation + s*k0.rotation_perp);
+      const LinearSpace3fa l = rcp(lerp(k0.scale,k1.scale,ftime))*R.transposed();
+      return AffineSpace3fa(l,-xfmVector(l,Vec3fa(lerp(k0.translation,k1.translation,ftime))));
+    }
+
+    __forceinline AffineSpace3fa getWorld2Local(float time) const 
+    {
+      float ftime; const int itime = timeSegment(time,ftime);
+      return getWorld2Local(itime,ftime);
     }
 
     /* calculates transformation from world to local space */
     __forceinline AffineSpace3fa getWorld2LocalSpecial(float time) const
     {
       if (likely(numTimeSteps == 1)) {
-        return world2local[0];
+        return world2local0;
       } else {
-        return rcp(lerp(local2world[0],local2world[1],time));
+        return getWorld2Local(time);
       }
     }
+
+    /* calculates transformations from world to local space for a ray packet */
+    template<int K>
+    __forceinline AffineSpaceT<LinearSpace3<Vec3<vfloat<K>>>> getWorld2Local(const vbool<K>& valid, const vfloat<K>& time) const
+    {
+      typedef Vec3<vfloat<K>> Vec3vfK;
+      typedef LinearSpace3<Vec3vfK> LinearSpace3vfK;
+      typedef AffineSpaceT<LinearSpace3vfK> AffineSpace3vfK;
+
+      if (likely(numTimeSteps == 1))
+        return AffineSpace3vfK(world2local0);
+
+      vfloat<K> ftime; const vint<K> vitime = timeSegment(time,ftime);
+      const vfloat<K> t0 = vfloat<K>(1.0f)-ftime, t1 = ftime;
+      AffineSpace3vfK world2local(one);
+      foreach_unique(valid,vitime,[&] (const vbool<K>& valid, const int itime)
+      {
+        const MotionKey& k0 = keys[itime+0];
+        const MotionKey& k1 = keys[itime+1];
+        const vfloat<K> angle = ftime*k0.angle;
+        vfloat<K> s,c; 
+        for (size_t i=0; i<K; i++) sincosf(angle[i],&s[i],&c[i]);
+        const QuaternionT<vfloat<K>> q(c*k0.rotation.r + s*k0.rotation_perp.r, c*k0.rotation.i + s*k0.rotation_perp.i,
+                                       c*k0.rotation.j + s*k0.rotation_perp.j, c*k0.rotation.k + s*k0.rotation_perp.k);
+        const LinearSpace3vfK S = t0*LinearSpace3vfK(k0.scale) + t1*LinearSpace3vfK(k1.scale);
+        const Vec3vfK T = t0*Vec3vfK(k0.translation) + t1*Vec3vfK(k1.translation);
+        const LinearSpace3vfK l = rcp(S)*LinearSpace3vfK(q).transposed();
+        world2local.l.vx = select(valid,l.vx,world2local.l.vx);
+        world2local.l.vy = select(valid,l.vy,world2local.l.vy);
+        world2local.l.vz = select(valid,l.vz,world2local.l.vz);
+        world2local.p    = select(valid,-xfmVector(l,T),world2local.p);
+      });
+      return world2local;
+    }
     
   public:
-    AffineSpace3fa local2world[2]; //!< transforms from local space to world space
-    AffineSpace3fa world2local[2]; //!< transforms from world space to local space
-    Scene* object;                 //!< pointer to instanced acceleration structure
+    AffineSpace3fa world2local0;          //!< transforms from world space to local space at the first time step
+    avector<AffineSpace3fa> local2world;  //!< transforms from local space to world space for each time step
+    avector<MotionKey> keys;              //!< decomposed transformation for each time step
+    Scene* object;                        //!< pointer to instanced acceleration structure
+    size_t maxLevel;               //!< instances nested deeper than this level are ignored
+
+  public:
+    static __thread size_t level;  //!< nesting level of the instances the calling thread traverses
   };
 }
@@ -199,4 +199,17 @@ namespace embree
     while ((file.tellp() % 16) != 0) { char c = 0; file.write(&c,1); }
     for (size_t i=0; i<numPrimitives; i++) file.write((char*)&segment(i),sizeof(int));
   }
+
+  void LineSegments::hash(Hash64& h) const
+  {
+    if (!segments) 
+      throw_RTCError(RTC_INVALID_OPERATION,"buffer got already freed");
+    h.add(segments.getPtr(),segments.size(),segments.getStride(),sizeof(int));
+
+    for (size_t j=0; j<numTimeSteps; j++) {
+      if (!vertices[j]) 
+        throw_RTCError(RTC_INVALID_OPERATION,"buffer got already freed");
+      h.add(vertices[j].getPtr(),vertices[j].size(),vertices[j].getStride(),sizeof(Vec3fa));
+    }
+  }
 }
@@ -36,6 +36,7 @@ namespace embree
 
     /*! writes the bezier segment geometry to disk */
     void write(std::ofstream& file);
+    void hash(Hash64& h) const;
 
   public:
     void enabling();
@@ -24,6 +24,7 @@ namespace embree
     : Geometry(parent,QUAD_MESH,numQuads,numTimeSteps,flags)
   {
     quads.init(parent->device,numQuads,sizeof(Quad));
+    vertices.resize(numTimeSteps);
     for (size_t i=0; i<numTimeSteps; i++) {
       vertices[i].init(parent->device,numVertices,sizeof(Vec3fa));
     }
@@ -60,18 +61,18 @@ namespace embree
     if (((size_t(ptr) + offset) & 0x3) || (stride & 0x3)) 
       throw_RTCError(RTC_INVALID_OPERATION,"data must be 4 bytes aligned");
 
+    if (type >= RTC_VERTEX_BUFFER0 && type < RTC_VERTEX_BUFFER0+numTimeSteps) 
+    {
+      const size_t t = type - RTC_VERTEX_BUFFER0;
+      vertices[t].set(ptr,offset,stride); 
+      vertices[t].checkPadding16();
+      return;
+    }
+
     switch (type) {
     case RTC_INDEX_BUFFER  : 
       quads.set(ptr,offset,stride); 
       break;
-    case RTC_VERTEX_BUFFER0: 
-      vertices[0].set(ptr,offset,stride); 
-      vertices[0].checkPadding16();
-      break;
-    case RTC_VERTEX_BUFFER1: 
-      vertices[1].set(ptr,offset,stride); 
-      vertices[1].checkPadding16();
-      break;
     case RTC_USER_VERTEX_BUFFER0: 
       if (userbuffers[0] == nullptr) userbuffers[0].reset(new Buffer(parent->device,numVertices(),stride)); 
       userbuffers[0]->set(ptr,offset,stride);  
@@ -93,10 +94,11 @@ namespace embree
     if (parent->isStatic() && parent->isBuild())
       throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
 
+    if (type >= RTC_VERTEX_BUFFER0 && type < RTC_VERTEX_BUFFER0+numTimeSteps) 
+      return vertices[type - RTC_VERTEX_BUFFER0].map(parent->numMappedBuffers);
+
     switch (type) {
     case RTC_INDEX_BUFFER  : return quads.map(parent->numMappedBuffers);
-    case RTC_VERTEX_BUFFER0: return vertices[0].map(parent->numMappedBuffers);
-    case RTC_VERTEX_BUFFER1: return vertices[1].map(parent->numMappedBuffers);
     default                : throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type"); return nullptr;
     }
   }
@@ -106,10 +108,13 @@ namespace embree
     if (parent->isStatic() && parent->isBuild())
       throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
 
+    if (type >= RTC_VERTEX_BUFFER0 && type < RTC_VERTEX_BUFFER0+numTimeSteps) {
+      vertices[type - RTC_VERTEX_BUFFER0].unmap(parent->numMappedBuffers);
+      return;
+    }
+
     switch (type) {
     case RTC_INDEX_BUFFER  : quads  .unmap(parent->numMappedBuffers); break;
-    case RTC_VERTEX_BUFFER0: vertices[0].unmap(parent->numMappedBuffers); break;
-    case RTC_VERTEX_BUFFER1: vertices[1].unmap(parent->numMappedBuffers); break;
     default                : throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type"); break;
     }
   }
@@ -119,14 +124,15 @@ namespace embree
     const bool freeQuads = !parent->needQuadIndices;
     const bool freeVertices  = !parent->needQuadVertices;
     if (freeQuads) quads.free(); 
-    if (freeVertices ) vertices[0].free();
-    if (freeVertices ) vertices[1].free();
+    if (freeVertices ) 
+      for (auto& buffer : vertices) buffer.free();
   }
 
   bool QuadMesh::verify () 
   {
     /*! verify consistent size of vertex arrays */
-    if (numTimeSteps == 2 && vertices[0].size() != vertices[1].size())
+    for (size_t t=1; t<numTimeSteps; t++) 
+      if (vertices[t].size() != vertices[0].size())
         return false;
 
     /*! verify proper quad indices */
@@ -158,7 +164,7 @@ namespace embree
 #endif
 
     /* calculate base pointer and stride */
-    assert((buffer >= RTC_VERTEX_BUFFER0 && buffer <= RTC_VERTEX_BUFFER1) ||
+    assert((buffer >= RTC_VERTEX_BUFFER0 && buffer < RTC_VERTEX_BUFFER0+numTimeSteps) ||
            (buffer >= RTC_USER_VERTEX_BUFFER0 && buffer <= RTC_USER_VERTEX_BUFFER1));
     const char* src = nullptr; 
     size_t stride = 0;
@@ -220,4 +226,17 @@ namespace embree
     for (size_t i=0; i<numQuads; i++) file.write((char*)&quad(i),sizeof(Quad));  
 
   }
+
+  void QuadMesh::hash(Hash64& h) const
+  {
+    if (!quads) 
+      throw_RTCError(RTC_INVALID_OPERATION,"buffer got already freed");
+    h.add(quads.getPtr(),quads.size(),quads.getStride(),sizeof(Quad));
+
+    for (size_t j=0; j<numTimeSteps; j++) {
+      if (!vertices[j]) 
+        throw_RTCError(RTC_INVALID_OPERATION,"buffer got already freed");
+      h.add(vertices[j].getPtr(),vertices[j].size(),vertices[j].getStride(),sizeof(Vec3f));
+    }
+  }
 }
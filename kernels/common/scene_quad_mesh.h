@@ -45,6 +45,7 @@ namespace embree
   
     /*! writes the quad mesh geometry to disk */
     void write(std::ofstream& file);
+    void hash(Hash64& h) const;
 
     /* geometry interface */
   public:
@@ -97,6 +98,17 @@ namespace embree
       return BBox3fa(min(v0,v1,v2,v3),max(v0,v1,v2,v3));
     }
 
+    /*! calculates the bounds of the i'th quad at the itime'th timestep */
+    __forceinline BBox3fa bounds(size_t i, size_t itime) const 
+    {
+      const Quad& q = quad(i);
+      const Vec3fa v0  = vertex(q.v[0],itime);
+      const Vec3fa v1  = vertex(q.v[1],itime);
+      const Vec3fa v2  = vertex(q.v[2],itime);
+      const Vec3fa v3  = vertex(q.v[3],itime);
+      return BBox3fa(min(v0,v1,v2,v3),max(v0,v1,v2,v3));
+    }
+
     /*! check if the i'th primitive is valid */
     __forceinline bool valid(size_t i, BBox3fa* bbox = nullptr) const 
     {
@@ -125,7 +137,7 @@ namespace embree
     
   public:
     BufferT<Quad> quads;                            //!< array of quads
-    array_t<BufferT<Vec3fa>,2> vertices;            //!< vertex array
+    std::vector<BufferT<Vec3fa>> vertices;          //!< vertex array for each time step
     array_t<std::unique_ptr<Buffer>,2> userbuffers; //!< user buffers
   };
 }
@@ -270,6 +270,10 @@ namespace embree
 	const size_t N = faceVertices[f];
 	const size_t e = faceStartEdge[f];
 
+        /* edges of holes get the invalid key and are thus never linked */
+        const bool hole = holeSet.lookup(f);
+        invalidFace[f] = hole;
+
 	for (size_t de=0; de<N; de++)
 	{
 	  HalfEdge* edge = &halfEdges[e+de];
@@ -290,7 +294,7 @@ namespace embree
           edge->patch_type             = HalfEdge::COMPLEX_PATCH; // type gets updated below
           edge->vertex_type            = HalfEdge::REGULAR_VERTEX;
 
-	  if (unlikely(holeSet.lookup(f))) 
+	  if (unlikely(hole)) 
 	    halfEdges1[e+de] = SubdivMesh::KeyHalfEdge(-1,edge);
 	  else
 	    halfEdges1[e+de] = SubdivMesh::KeyHalfEdge(key,edge);
@@ -360,7 +364,7 @@ namespace embree
       {
         HalfEdge* edge = &halfEdges[faceStartEdge[f]];
         HalfEdge::PatchType patch_type = edge->patchType();
-        invalidFace[f] = !edge->valid(vertices[0]) || holeSet.lookup(f);
+        invalidFace[f] |= !edge->valid(vertices[0]);
           
         for (size_t i=0; i<faceVertices[f]; i++) 
         {
@@ -416,6 +420,15 @@ namespace embree
     });
   }
 
+  void SubdivMesh::updateInvalidFaces()
+  {
+    parallel_for( size_t(0), numFaces, size_t(4096), [&](const range<size_t>& r) 
+    {
+      for (size_t f=r.begin(); f<r.end(); f++) 
+        invalidFace[f] = !getHalfEdge(f)->valid(vertices[0]) || holeSet.lookup(f);
+    });
+  }
+
   void SubdivMesh::initializeHalfEdgeStructures ()
   {
     double t0 = getSeconds();
@@ -461,6 +474,11 @@ namespace embree
     if (recalculate) calculateHalfEdges();
     else if (update) updateHalfEdges();
 
+    /* the topology is kept when only the vertices changed, but faces
+     * with invalid vertices have to get excluded again */
+    if (!recalculate && vertices[0].isModified())
+      updateInvalidFaces();
+
     /* create interpolation cache mapping for interpolatable meshes */
     if (parent->isInterpolatable()) 
     {
@@ -131,6 +131,9 @@ namespace embree
     /*! updates half edges when recalculation is not necessary */
     void updateHalfEdges();
 
+    /*! recalculates the invalid faces when only the vertices changed */
+    void updateInvalidFaces();
+
   public:
 
     /*! returns the start half edge for some face */
@@ -111,6 +111,7 @@ namespace embree
   
     /*! writes the triangle mesh geometry to disk */
     void write(std::ofstream& file);
+    void hash(Hash64& h) const;
 
     /* geometry interface */
   public:
@@ -162,6 +163,16 @@ namespace embree
       return BBox3fa(min(v0,v1,v2),max(v0,v1,v2));
     }
 
+    /*! calculates the bounds of the i'th triangle at the itime'th timestep */
+    __forceinline BBox3fa bounds(size_t i, size_t itime) const 
+    {
+      const Triangle& tri = triangle(i);
+      const Vec3fa v0 = vertex(tri.v[0],itime);
+      const Vec3fa v1 = vertex(tri.v[1],itime);
+      const Vec3fa v2 = vertex(tri.v[2],itime);
+      return BBox3fa(min(v0,v1,v2),max(v0,v1,v2));
+    }
+
     /*! check if the i'th primitive is valid */
     __forceinline bool valid(size_t i, BBox3fa* bbox = nullptr) const 
     {
@@ -187,7 +198,7 @@ namespace embree
 
   public:
     BufferT<Triangle> triangles;                    //!< array of triangles
-    array_t<BufferT<Vec3fa>,2> vertices;            //!< vertex array
+    std::vector<BufferT<Vec3fa>> vertices;          //!< vertex array for each time step
     array_t<std::unique_ptr<Buffer>,2> userbuffers; //!< user buffers
 
   };
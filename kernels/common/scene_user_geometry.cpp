@@ -122,6 +122,17 @@ namespace embree
     intersectors.intersectorN.intersect = intersect;
   }
 
+  void UserGeometry::setIntersectFunctionNM (RTCIntersectFuncNM intersect) 
+  {
+    if (!parent->isStreamMode())
+      throw_RTCError(RTC_INVALID_OPERATION,"you can use rtcSetIntersectFunctionNM only in stream mode");
+
+    if (parent->isStatic() && parent->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    intersectors.intersectorNM.intersect = intersect;
+  }
+
   void UserGeometry::setOccludedFunction (RTCOccludedFunc occluded1, bool ispc) 
   {
     if (parent->isStreamMode())
@@ -190,4 +201,15 @@ namespace embree
 
     intersectors.intersectorN.occluded = occluded;
   }
+
+  void UserGeometry::setOccludedFunctionNM (RTCOccludedFuncNM occluded) 
+  {
+    if (!parent->isStreamMode())
+      throw_RTCError(RTC_INVALID_OPERATION,"you can use rtcSetOccludedFunctionNM only in stream mode");
+
+    if (parent->isStatic() && parent->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    intersectors.intersectorNM.occluded = occluded;
+  }
 }
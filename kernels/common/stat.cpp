@@ -130,4 +130,150 @@ namespace embree
     cout << "#user7/user3 " << 100.0f*float(cntrs.user[7])/float(cntrs.user[3]) << "%" << std::endl;
     cout << std::endl;
   }
+
+  __thread size_t ShardedStat::shard = size_t(-1);
+
+  /* shard indices of exited threads are reused by new threads */
+  static MutexSys g_shardMutex;
+  static std::vector<size_t> g_freeShards;
+  static size_t g_numShards = 0;
+
+  struct ShardOwner
+  {
+    ShardOwner () : index(size_t(-1)) {}
+
+    ~ShardOwner () 
+    {
+      if (index == size_t(-1)) return;
+      Lock<MutexSys> lock(g_shardMutex);
+      g_freeShards.push_back(index);
+    }
+
+    size_t index;
+  };
+  static thread_local ShardOwner t_shardOwner;
+
+  size_t ShardedStat::acquireShard()
+  {
+    size_t index;
+    {
+      Lock<MutexSys> lock(g_shardMutex);
+      if (g_freeShards.size()) { index = g_freeShards.back(); g_freeShards.pop_back(); }
+      else                     index = g_numShards++;
+    }
+    t_shardOwner.index = index;
+    return index;
+  }
+
+  ShardedStat::ShardedStat () 
+  {
+    for (size_t i=0; i<MAX_SHARD_BLOCKS; i++) blocks[i].store(nullptr);
+    clear();
+  }
+
+  ShardedStat::~ShardedStat () 
+  {
+    for (size_t i=0; i<MAX_SHARD_BLOCKS; i++)
+      alignedFree(blocks[i].load());
+  }
+
+  ShardedStat::Shard* ShardedStat::allocBlock(size_t i)
+  {
+    Shard* block = (Shard*) alignedMalloc(SHARD_BLOCK_SIZE*sizeof(Shard),64);
+    for (size_t j=0; j<SHARD_BLOCK_SIZE; j++)
+      for (size_t c=0; c<NUM_COUNTERS; c++)
+        block[j].counters[c].store(0,std::memory_order_relaxed);
+
+    /* another thread of the same block may have been faster */
+    Shard* expected = nullptr;
+    if (blocks[i].compare_exchange_strong(expected,block)) return block;
+    alignedFree(block);
+    return expected;
+  }
+
+  size_t ShardedStat::get(Counter counter) const 
+  {
+    size_t sum = overflow.counters[counter].load(std::memory_order_relaxed);
+    for (size_t i=0; i<MAX_SHARD_BLOCKS; i++) 
+    {
+      const Shard* block = blocks[i].load(std::memory_order_acquire);
+      if (block == nullptr) continue;
+      for (size_t j=0; j<SHARD_BLOCK_SIZE; j++)
+        sum += block[j].counters[counter].load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+
+  size_t ShardedStat::get(Counter begin, Counter end) const 
+  {
+    size_t sum = 0;
+    for (size_t c=begin; c<end; c++)
+      sum += get((Counter)c);
+    return sum;
+  }
+
+  void ShardedStat::clear() 
+  {
+    for (size_t c=0; c<NUM_COUNTERS; c++)
+      overflow.counters[c].store(0,std::memory_order_relaxed);
+
+    for (size_t i=0; i<MAX_SHARD_BLOCKS; i++) 
+    {
+      Shard* block = blocks[i].load(std::memory_order_acquire);
+      if (block == nullptr) continue;
+      for (size_t j=0; j<SHARD_BLOCK_SIZE; j++)
+        for (size_t c=0; c<NUM_COUNTERS; c++)
+          block[j].counters[c].store(0,std::memory_order_relaxed);
+    }
+  }
+
+  void BuildStat::add(const void* accel, const std::string& builder, const std::string& primTy, double dt, size_t numPrimitives, size_t bytes)
+  {
+    Lock<MutexSys> lock(mutex);
+    size_t i=0;
+    while (i<accels.size() && accels[i].accel != accel) i++;
+    if (i == accels.size()) {
+      Accel entry;
+      entry.accel = accel;
+      entry.numBuilds = 0;
+      entry.buildTime = 0.0;
+      accels.push_back(entry);
+    }
+    Accel& entry = accels[i];
+    entry.builder = builder;
+    entry.primTy = primTy;
+    entry.numBuilds++;
+    entry.buildTime += dt;
+    entry.lastBuildTime = dt;
+    entry.numPrimitives = numPrimitives;
+    entry.bytes = bytes;
+  }
+
+  bool BuildStat::get(size_t i, Accel& accel_o) const
+  {
+    Lock<MutexSys> lock(mutex);
+    if (i >= accels.size()) return false;
+    accel_o = accels[i];
+    return true;
+  }
+
+  void BuildStat::sum(size_t& numBuilds, double& buildTime, size_t& bytes) const
+  {
+    Lock<MutexSys> lock(mutex);
+    numBuilds = 0; buildTime = 0.0; bytes = 0;
+    for (size_t i=0; i<accels.size(); i++) {
+      numBuilds += accels[i].numBuilds;
+      buildTime += accels[i].buildTime;
+      bytes     += accels[i].bytes;
+    }
+  }
+
+  void BuildStat::clear()
+  {
+    Lock<MutexSys> lock(mutex);
+    for (size_t i=0; i<accels.size(); i++) {
+      accels[i].numBuilds = 0;
+      accels[i].buildTime = 0.0;
+    }
+  }
 }
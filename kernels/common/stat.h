@@ -98,4 +98,115 @@ namespace embree
   private:
     static Stat instance;
   };
+
+  /*! Always enabled ray tracing counters of a scene or device. Each
+   *  thread accumulates into its own cache line aligned shard using
+   *  plain loads and stores, thus counting requires no atomic
+   *  read-modify-write operations. Shard indices are unique among the
+   *  running threads and are handed back when a thread exits. Shards
+   *  are allocated in blocks that never move, threads beyond
+   *  MAX_SHARDS count atomically into a shared overflow shard. */
+  class ShardedStat
+  {
+  public:
+
+    enum Counter
+    {
+      INTERSECT1 = 0, INTERSECT4, INTERSECT8, INTERSECT16, INTERSECT1M, INTERSECTNM, INTERSECTNP,
+      OCCLUDED1, OCCLUDED4, OCCLUDED8, OCCLUDED16, OCCLUDED1M, OCCLUDEDNM, OCCLUDEDNP,
+      NODES_VISITED, LEAVES_VISITED,
+      NUM_COUNTERS
+    };
+
+    static const size_t SHARD_BLOCK_SIZE = 64;     //!< number of shards per block
+    static const size_t MAX_SHARD_BLOCKS = 64;     //!< maximal number of shard blocks
+    static const size_t MAX_SHARDS = SHARD_BLOCK_SIZE*MAX_SHARD_BLOCKS;
+
+    ShardedStat ();
+    ~ShardedStat ();
+
+    /*! adds n to some counter of the calling thread's shard */
+    __forceinline void add(Counter counter, size_t n) 
+    {
+      const size_t i = threadShard();
+      if (unlikely(i >= MAX_SHARDS)) {
+        overflow.counters[counter].fetch_add(n,std::memory_order_relaxed);
+        return;
+      }
+      Shard* block = blocks[i/SHARD_BLOCK_SIZE].load(std::memory_order_acquire);
+      if (unlikely(block == nullptr)) block = allocBlock(i/SHARD_BLOCK_SIZE);
+      std::atomic<size_t>& c = block[i%SHARD_BLOCK_SIZE].counters[counter];
+      c.store(c.load(std::memory_order_relaxed)+n,std::memory_order_relaxed);
+    }
+
+    /*! sums some counter over all shards */
+    size_t get(Counter counter) const;
+
+    /*! sums some range of counters over all shards */
+    size_t get(Counter begin, Counter end) const;
+
+    /*! resets all counters */
+    void clear();
+
+  private:
+    ShardedStat (const ShardedStat& other); // do not implement
+    ShardedStat& operator= (const ShardedStat& other); // do not implement
+
+    struct __aligned(64) Shard {
+      std::atomic<size_t> counters[NUM_COUNTERS];
+    };
+
+    static __forceinline size_t threadShard() 
+    {
+      if (unlikely(shard == size_t(-1))) shard = acquireShard();
+      return shard;
+    }
+
+    /*! assigns a shard index to the calling thread, the index is released again when the thread exits */
+    static size_t acquireShard();
+
+    /*! allocates the i'th block of shards, already allocated blocks never move */
+    Shard* allocBlock(size_t i);
+
+  private:
+    std::atomic<Shard*> blocks[MAX_SHARD_BLOCKS];
+    Shard overflow;                         //!< shared by threads beyond MAX_SHARDS
+
+    static __thread size_t shard;           //!< shard of the calling thread
+  };
+
+  /*! Gathers build time and memory consumption of each acceleration
+   *  structure of a scene. */
+  class BuildStat
+  {
+  public:
+
+    struct Accel
+    {
+      const void* accel;      //!< acceleration structure the entry belongs to
+      std::string builder;    //!< name of the builder used last
+      std::string primTy;     //!< name of the primitive type
+      size_t numBuilds;       //!< number of builds
+      double buildTime;       //!< total build time in seconds
+      double lastBuildTime;   //!< time of the last build in seconds
+      size_t numPrimitives;   //!< number of primitives of the last build
+      size_t bytes;           //!< bytes allocated after the last build
+    };
+
+    /*! records a build of some acceleration structure */
+    void add(const void* accel, const std::string& builder, const std::string& primTy, double dt, size_t numPrimitives, size_t bytes);
+
+    /*! returns a copy of the i'th entry, false if there is no such entry */
+    bool get(size_t i, Accel& accel_o) const;
+
+    /*! returns the sum over all entries */
+    void sum(size_t& numBuilds, double& buildTime, size_t& bytes) const;
+
+    /*! resets build counts and times */
+    void clear();
+
+  private:
+    mutable MutexSys mutex;
+    std::vector<Accel> accels;
+  };
 }
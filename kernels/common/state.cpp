@@ -86,6 +86,12 @@ namespace embree
     object_accel_mb_min_leaf_size = 1;
     object_accel_mb_max_leaf_size = 1;
 
+    toplevel_update_sah_factor = 1.5f;
+
+    memory_pool_size = 0;
+    memory_pool_hugepages = false;
+    numa_policy = NUMA_DEFAULT;
+
     tessellation_cache_size = 128*1024*1024;
 
     /* large default cache size only for old mode single device mode */
@@ -97,6 +103,10 @@ namespace embree
 
     subdiv_accel = "default";
 
+    morton_code_bits = 0;
+
+    max_instance_level = RTC_MAX_INSTANCE_LEVEL_COUNT;
+
     float_exceptions = false;
     scene_flags = -1;
     verbose = 0;
@@ -238,7 +248,7 @@ namespace embree
       else if ((tok == Token::Id("tri_traverser") || tok == Token::Id("traverser")) && cin->trySymbol("="))
         tri_traverser = cin->get().Identifier();
       else if (tok == Token::Id("tri_builder_replication_factor") && cin->trySymbol("="))
-        tri_builder_replication_factor = cin->get().Int();
+        tri_builder_replication_factor = cin->get().Float();
 
       else if ((tok == Token::Id("tri_accel_mb") || tok == Token::Id("accel_mb")) && cin->trySymbol("="))
         tri_accel_mb = cin->get().Identifier();
@@ -297,8 +307,17 @@ namespace embree
       else if (tok == Token::Id("object_accel_mb_max_leaf_size") && cin->trySymbol("="))
         object_accel_mb_max_leaf_size = cin->get().Int();
 
+      else if (tok == Token::Id("toplevel_update_sah_factor") && cin->trySymbol("="))
+        toplevel_update_sah_factor = cin->get().Float();
+
       else if (tok == Token::Id("subdiv_accel") && cin->trySymbol("="))
         subdiv_accel = cin->get().Identifier();
+
+      else if (tok == Token::Id("morton_code_bits") && cin->trySymbol("="))
+        morton_code_bits = cin->get().Int();
+
+      else if (tok == Token::Id("max_instance_level") && cin->trySymbol("="))
+        max_instance_level = cin->get().Int();
       
       else if (tok == Token::Id("verbose") && cin->trySymbol("="))
         verbose = cin->get().Int();
@@ -321,6 +340,20 @@ namespace embree
         }
       }
 
+      else if (tok == Token::Id("memory_pool_size") && cin->trySymbol("="))
+        memory_pool_size = cin->get().Float() * 1024 * 1024;
+
+      else if (tok == Token::Id("memory_pool_hugepages") && cin->trySymbol("="))
+        memory_pool_hugepages = cin->get().Int();
+
+      else if (tok == Token::Id("numa") && cin->trySymbol("=")) {
+        std::string policy = toLowerCase(cin->get().Identifier());
+        if      (policy == "default"   ) numa_policy = NUMA_DEFAULT;
+        else if (policy == "interleave") numa_policy = NUMA_INTERLEAVE;
+        else if (policy == "local"     ) numa_policy = NUMA_LOCAL;
+        else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown NUMA policy "+policy);
+      }
+
       else if (tok == Token::Id("tessellation_cache_size") && cin->trySymbol("="))
         tessellation_cache_size = cin->get().Float() * 1024 * 1024;
 
@@ -388,5 +421,19 @@ namespace embree
     std::cout << "object_accel_mb:" << std::endl;
     std::cout << "  min_leaf_size = " << object_accel_mb_min_leaf_size << std::endl;
     std::cout << "  max_leaf_size = " << object_accel_mb_max_leaf_size << std::endl;
+
+    std::cout << "toplevel_update:" << std::endl;
+    std::cout << "  sah_factor    = " << toplevel_update_sah_factor << std::endl;
+
+    std::cout << "memory_pool:" << std::endl;
+    std::cout << "  size          = " << memory_pool_size << std::endl;
+    std::cout << "  hugepages     = " << memory_pool_hugepages << std::endl;
+
+    std::cout << "numa:" << std::endl;
+    std::cout << "  nodes         = " << os_numa_nodes() << std::endl;
+    std::cout << "  policy        = " << numa_policy << std::endl;
+
+    std::cout << "instances:" << std::endl;
+    std::cout << "  max_level     = " << max_instance_level << std::endl;
   }
 }
@@ -98,10 +98,24 @@ namespace embree
     int object_accel_mb_min_leaf_size;         //!< minimal leaf size for mblur object acceleration structure
     int object_accel_mb_max_leaf_size;         //!< maximal leaf size for mblur object acceleration structure
 
+  public:
+    float toplevel_update_sah_factor;      //!< rebuild top level of dynamic scenes when updates increase its SAH cost by more than this factor, 0 disables updates
+
+  public:
+    size_t memory_pool_size;               //!< maximal number of bytes the memory pool caches for reuse, 0 disables the pool
+    bool memory_pool_hugepages;            //!< rounds pooled allocations to 2MB to enable huge pages
+    NumaPolicy numa_policy;                //!< NUMA placement of BVH node and leaf memory
+
   public:
     size_t      tessellation_cache_size;   //!< size of the shared tessellation cache 
     std::string subdiv_accel;              //!< acceleration structure to use for subdivision surfaces
 
+  public:
+    int morton_code_bits;                  //!< number of bits of morton codes (32 or 64), 0 selects automatically
+
+  public:
+    size_t max_instance_level;             //!< maximal number of nested instance levels, at most RTC_MAX_INSTANCE_LEVEL_COUNT
+
   public:
     bool float_exceptions;                 //!< enable floating point exceptions
     int scene_flags;                       //!< scene flags to use
@@ -37,21 +37,32 @@ namespace embree
     //SharedLazyTessellationCache::sharedLazyTessellationCache.addCurrentIndex(SharedLazyTessellationCache::NUM_CACHE_SEGMENTS);
     SharedLazyTessellationCache::sharedLazyTessellationCache.reset();
   }
+
+  size_t getTessellationCacheHits() {
+    return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumHits();
+  }
+
+  size_t getTessellationCacheMisses() {
+    return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumMisses();
+  }
+
+  size_t getTessellationCacheFlushes() {
+    return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumFlushes();
+  }
   
   SharedLazyTessellationCache::SharedLazyTessellationCache()
   {
     size = 0;
+    reserved = 0;
     data = nullptr;
     maxBlocks              = size/64;
     localTime              = NUM_CACHE_SEGMENTS;
     next_block             = 0;
     numRenderThreads       = 0;
-#if FORCE_SIMPLE_FLUSH == 1
-    switch_block_threshold = maxBlocks;
-#else
-    switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
-#endif
+    numFlushes             = 0;
+    switch_block_threshold = getSegmentBlocks();
     threadWorkState     = new ThreadWorkState[NUM_PREALLOC_THREAD_WORK_STATES];
+    resetSegments();
 
     //reset_state.reset();
     //linkedlist_mtx.reset();
@@ -82,6 +93,24 @@ namespace embree
     linkedlist_mtx.unlock();
   }
 
+  size_t SharedLazyTessellationCache::getNumHits()
+  {
+    size_t hits = 0;
+    linkedlist_mtx.lock();
+    for (ThreadWorkState* t=current_t_state; t!=nullptr; t=t->next) hits += t->hits;
+    linkedlist_mtx.unlock();
+    return hits;
+  }
+
+  size_t SharedLazyTessellationCache::getNumMisses()
+  {
+    size_t misses = 0;
+    linkedlist_mtx.lock();
+    for (ThreadWorkState* t=current_t_state; t!=nullptr; t=t->next) misses += t->misses;
+    linkedlist_mtx.unlock();
+    return misses;
+  }
+
   void SharedLazyTessellationCache::waitForUsersLessEqual(ThreadWorkState *const t_state,
 							  const unsigned int users)
    {
@@ -116,15 +145,37 @@ namespace embree
 
 #if FORCE_SIMPLE_FLUSH == 1
 	    next_block = 0;
-	    switch_block_threshold = maxBlocks;
+	    switch_block_threshold = segmentBlocks = maxBlocks;
 #else
-	    const size_t region = localTime % NUM_CACHE_SEGMENTS;
-	    next_block = region * (maxBlocks/NUM_CACHE_SEGMENTS);
-	    switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
+            /* the segments form a ring buffer, thus when the cache grew
+             * the next segment continues in the new memory. Segments keep
+             * their old size for NUM_CACHE_SEGMENTS switches after a grow,
+             * as larger segments at the old boundaries would overwrite
+             * entries that are still valid. */
+            if (oldSizeSwitches) oldSizeSwitches--;
+            else segmentBlocks = getSegmentBlocks();
+            size_t start = switch_block_threshold;
+            if (start + segmentBlocks > maxBlocks) start = 0;
+
+            /* invalidate the cache if the new segment still overlaps a valid segment */
+            const size_t slot = localTime % NUM_CACHE_SEGMENTS;
+            for (size_t i=0; i<NUM_CACHE_SEGMENTS; i++)
+            {
+              if (i == slot || start >= segmentEnd[i] || start + segmentBlocks <= segmentBegin[i]) continue;
+              localTime += NUM_CACHE_SEGMENTS;
+              for (size_t j=0; j<NUM_CACHE_SEGMENTS; j++) segmentBegin[j] = segmentEnd[j] = 0;
+              break;
+            }
+            segmentBegin[slot] = start;
+            segmentEnd  [slot] = start + segmentBlocks;
+
+	    next_block = start;
+	    switch_block_threshold = start + segmentBlocks;
 	    assert( switch_block_threshold <= maxBlocks );
 #endif
 
 	    CACHE_STATS(SharedTessellationCacheStats::cache_flushes++);
+            numFlushes++;
 
             /* release all blocked threads */
 
@@ -144,6 +195,16 @@ namespace embree
   }
 
 
+  void SharedLazyTessellationCache::resetSegments()
+  {
+    segmentBlocks = getSegmentBlocks();
+    oldSizeSwitches = 0;
+    for (size_t i=0; i<NUM_CACHE_SEGMENTS; i++) 
+      segmentBegin[i] = segmentEnd[i] = 0;
+    segmentBegin[localTime % NUM_CACHE_SEGMENTS] = 0;
+    segmentEnd  [localTime % NUM_CACHE_SEGMENTS] = segmentBlocks;
+  }
+
   void SharedLazyTessellationCache::reset()
   {
     /* lock the reset_state */
@@ -159,14 +220,12 @@ namespace embree
 
     /* reset to the first segment */
     next_block = 0;
-#if FORCE_SIMPLE_FLUSH == 1
-    switch_block_threshold = maxBlocks;
-#else
-    switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
-#endif
+    switch_block_threshold = getSegmentBlocks();
 
     /* reset local time */
     localTime = NUM_CACHE_SEGMENTS;
+    numFlushes++;
+    resetSegments();
 
     /* release all blocked threads */
     for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
@@ -192,26 +251,37 @@ namespace embree
       if (lockThread(t) == 1)
         waitForUsersLessEqual(t,1);
 
-    /* reallocate data */
-    if (data) os_free(data,size);
-    size      = new_size;
-    data      = nullptr;
-    if (size) data = (float*)os_malloc(size); // FIXME: do os_reserve under linux
-    maxBlocks = size/64;    
+    /* grow inside the reserved address space, cached entries stay valid */
+    if (new_size > size && new_size <= reserved)
+    {
+      os_commit((char*)data+size,new_size-size);
+      size      = new_size;
+      maxBlocks = size/64;
+      oldSizeSwitches = NUM_CACHE_SEGMENTS;
+    }
+
+    /* otherwise reallocate data and invalidate the entire cache */
+    else
+    {
+      if (data) os_free(data,reserved);
+      size      = new_size;
+      reserved  = min(TESSELLATION_CACHE_RESERVE*size,MAX_TESSELLATION_CACHE_SIZE);
+      data      = nullptr;
+      if (size) {
+        data = (float*)os_reserve(reserved);
+        os_commit(data,size);
+      }
+      maxBlocks = size/64;    
 
-    /* invalidate entire cache */
-    localTime += NUM_CACHE_SEGMENTS; 
+      /* invalidate entire cache */
+      localTime += NUM_CACHE_SEGMENTS; 
+      numFlushes++;
 
-    /* reset to the first segment */
-#if FORCE_SIMPLE_FLUSH == 1
-    next_block = 0;
-    switch_block_threshold = maxBlocks;
-#else
-    const size_t region = localTime % NUM_CACHE_SEGMENTS;
-    next_block = region * (maxBlocks/NUM_CACHE_SEGMENTS);
-    switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
-    assert( switch_block_threshold <= maxBlocks );
-#endif
+      /* reset to the first segment */
+      next_block = 0;
+      switch_block_threshold = getSegmentBlocks();
+      resetSegments();
+    }
 
     /* release all blocked threads */
     for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
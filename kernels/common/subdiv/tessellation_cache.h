@@ -62,6 +62,9 @@ namespace embree
 
   void resizeTessellationCache(size_t new_size);
   void resetTessellationCache();
+  size_t getTessellationCacheHits();
+  size_t getTessellationCacheMisses();
+  size_t getTessellationCacheFlushes();
 
 
  typedef size_t InputTagType;
@@ -82,8 +85,12 @@ namespace embree
    ThreadWorkState* next;
    bool allocated;
 
+   /* statistics, only written by the owning thread */
+   size_t hits;
+   size_t misses;
+
    __forceinline ThreadWorkState(bool allocated = false) 
-     : counter(0), next(nullptr), allocated(allocated) 
+     : counter(0), next(nullptr), allocated(allocated), hits(0), misses(0) 
    {
      assert( ((size_t)this % 64) == 0 ); 
    }   
@@ -104,6 +111,7 @@ namespace embree
    static const size_t REF_TAG_MASK                    = 0x7FFFFFFF;
 #endif
    static const size_t MAX_TESSELLATION_CACHE_SIZE     = REF_TAG_MASK+1;
+   static const size_t TESSELLATION_CACHE_RESERVE      = 2; // address space reserved for growth, relative to the requested size
    
 
     /*! Per thread tessellation ref cache */
@@ -158,6 +166,7 @@ namespace embree
 
    float *data;
    size_t size;
+   size_t reserved;
    size_t maxBlocks;
    ThreadWorkState *threadWorkState;
       
@@ -167,6 +176,16 @@ namespace embree
    __aligned(64) AtomicMutex   linkedlist_mtx;
    __aligned(64) std::atomic<size_t> switch_block_threshold;
    __aligned(64) std::atomic<size_t> numRenderThreads;
+   __aligned(64) std::atomic<size_t> numFlushes;
+
+   /* size of the current segment, differs from getSegmentBlocks() for
+    * NUM_CACHE_SEGMENTS switches after the cache grew */
+   size_t segmentBlocks;
+   size_t oldSizeSwitches;
+
+   /* block range of the segment of each of the last NUM_CACHE_SEGMENTS times */
+   size_t segmentBegin[NUM_CACHE_SEGMENTS];
+   size_t segmentEnd  [NUM_CACHE_SEGMENTS];
 
 
  public:
@@ -243,12 +262,16 @@ namespace embree
      {
        sharedLazyTessellationCache.lockThreadLoop(t_state);
        void* patch = SharedLazyTessellationCache::lookup(entry,globalTime);
-       if (patch) return (decltype(constructor())) patch;
+       if (patch) {
+         t_state->hits++;
+         return (decltype(constructor())) patch;
+       }
        
        if (entry.mutex.try_lock())
        {
          if (!validTag(entry.tag,globalTime)) 
          {
+           t_state->misses++;
            auto time = sharedLazyTessellationCache.getTime(globalTime);
            auto ret = constructor();
            __memory_barrier();
@@ -310,11 +333,10 @@ namespace embree
     
    __forceinline size_t alloc(const size_t blocks)
    {
-     if (unlikely(blocks >= switch_block_threshold))
+     if (unlikely(blocks >= segmentBlocks))
      {
        throw_RTCError(RTC_INVALID_OPERATION,"allocation exceeds size of tessellation cache segment");
      }
-     assert(blocks < switch_block_threshold);
      size_t index = next_block.fetch_add(blocks);
      if (unlikely(index + blocks >= switch_block_threshold)) return (size_t)-1;
      return index;
@@ -386,7 +408,19 @@ namespace embree
    __forceinline size_t getMaxBlocks()    { return maxBlocks; }
    __forceinline size_t getSize()         { return size; }
 
+#if FORCE_SIMPLE_FLUSH == 1
+   __forceinline size_t getSegmentBlocks() { return maxBlocks; }
+#else
+   __forceinline size_t getSegmentBlocks() { return maxBlocks/NUM_CACHE_SEGMENTS; }
+#endif
+
+   /* statistics over all render threads */
+   size_t getNumHits();
+   size_t getNumMisses();
+   __forceinline size_t getNumFlushes() { return numFlushes; }
+
    void allocNextSegment();
+   void resetSegments();
    void realloc(const size_t newSize);
 
    void reset();
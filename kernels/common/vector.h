@@ -15,12 +15,19 @@
 // ======================================================================== //
 
 #include "default.h"
+#include "mempool.h"
 
 namespace embree
 {
   /*! invokes the memory monitor callback */
   struct MemoryMonitorInterface {
     virtual void memoryMonitor(ssize_t bytes, bool post) = 0;
+
+    /*! returns the memory pool to recycle build memory, or nullptr if disabled */
+    virtual MemoryPool* memoryPool() { return nullptr; }
+
+    /*! returns the NUMA placement policy for build memory */
+    virtual NumaPolicy numaPolicy() { return NUMA_DEFAULT; }
   };
 
   /*! allocator that performs aligned monitored allocations */
@@ -41,6 +48,21 @@ namespace embree
       __forceinline pointer allocate( size_type n ) 
       {
         assert(device);
+        
+        /* large temporary arrays are recycled through the memory pool */
+        MemoryPool* pool = device->memoryPool();
+        if (pool && n*sizeof(T) >= MemoryPool::minTemporaryBytes) 
+        {
+          const size_t bytes = pool->roundBytes(n*sizeof(T));
+          size_t bytesCommitted = 0;
+          void* ptr = pool->malloc(bytes,bytesCommitted);
+          if (bytesCommitted < bytes) {
+            device->memoryMonitor(bytes-bytesCommitted,false);
+            os_commit(ptr,bytes);
+          }
+          return (pointer) ptr;
+        }
+
         device->memoryMonitor(n*sizeof(T),false);
         return (pointer) alignedMalloc(n*sizeof(value_type),alignment);
       }
@@ -48,6 +70,14 @@ namespace embree
       __forceinline void deallocate( pointer p, size_type n ) 
       {
         assert(device);
+
+        MemoryPool* pool = device->memoryPool();
+        if (pool && n*sizeof(T) >= MemoryPool::minTemporaryBytes) {
+          const size_t bytes = pool->roundBytes(n*sizeof(T));
+          pool->free(p,bytes,bytes);
+          return;
+        }
+
         alignedFree(p);
         device->memoryMonitor(-n*sizeof(T),true);
       }
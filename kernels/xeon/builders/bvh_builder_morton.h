@@ -53,7 +53,9 @@ namespace embree
     struct __aligned(8) MortonID32Bit
     {
     public:
-      
+      typedef unsigned int Key;
+      static const size_t LATTICE_BITS_PER_DIM = 10;  //!< 3*10 bits fit into 32 bit code
+
       unsigned int code;
       unsigned int index;
       
@@ -67,6 +69,11 @@ namespace embree
       __forceinline unsigned int getByte(const size_t index) const {
         return ((unsigned char*)&code)[index];
       }
+
+      /*! calculates morton code from quantized coordinates */
+      static __forceinline Key encode(const unsigned int x, const unsigned int y, const unsigned int z) {
+        return bitInterleave(x,y,z);
+      }
       
       __forceinline bool operator<(const MortonID32Bit &m) const { return code < m.code; } 
       
@@ -75,6 +82,38 @@ namespace embree
         return o;
       }
     };
+
+    /*! 64 bit morton code with 21 bits per dimension, used for large
+     *  scenes where 32 bit codes cannot separate primitives anymore */
+    struct __aligned(16) MortonID64Bit
+    {
+    public:
+      typedef uint64_t Key;
+      static const size_t LATTICE_BITS_PER_DIM = 21;  //!< 3*21 bits fit into 64 bit code
+
+      uint64_t code;
+      unsigned int index;
+      unsigned int align;
+      
+    public:   
+      __forceinline operator uint64_t() const { return code; }
+      
+      __forceinline unsigned int get(const unsigned int shift, const unsigned int and_mask) const {
+        return (unsigned int)(code >> shift) & and_mask;
+      }
+
+      /*! calculates morton code from quantized coordinates */
+      static __forceinline Key encode(const unsigned int x, const unsigned int y, const unsigned int z) {
+        return bitInterleave64<uint64_t>(x,y,z);
+      }
+      
+      __forceinline bool operator<(const MortonID64Bit &m) const { return code < m.code; } 
+      
+      __forceinline friend std::ostream &operator<<(std::ostream &o, const MortonID64Bit& mc) {
+        o << "index " << mc.index << " code = " << mc.code;
+        return o;
+      }
+    };
     
     struct MortonCodeGenerator
     {
@@ -86,11 +125,12 @@ namespace embree
         vfloat4 base;
         vfloat4 scale;
         
-        __forceinline MortonCodeMapping(const BBox3fa& bounds)
+        __forceinline MortonCodeMapping(const BBox3fa& bounds, const size_t latticeBits = LATTICE_BITS_PER_DIM)
         {
           base  = (vfloat4)bounds.lower;
           const vfloat4 diag  = (vfloat4)bounds.upper - (vfloat4)bounds.lower;
-          scale = select(diag > vfloat4(1E-19f), rcp(diag) * vfloat4(LATTICE_SIZE_PER_DIM * 0.99f),vfloat4(0.0f));
+          const float latticeSize = float(size_t(1) << latticeBits);
+          scale = select(diag > vfloat4(1E-19f), rcp(diag) * vfloat4(latticeSize * 0.99f),vfloat4(0.0f));
         }
       };
       
@@ -166,7 +206,38 @@ namespace embree
     };
             
 
-    static void InPlace32BitRadixSort(MortonID32Bit* const morton, const size_t num, const size_t shift = 3*8)
+    /*! scalar morton code generator for 64 bit codes */
+    struct MortonCodeGenerator64
+    {
+      typedef MortonCodeGenerator::MortonCodeMapping MortonCodeMapping;
+
+      __forceinline MortonCodeGenerator64(const MortonCodeMapping& mapping, MortonID64Bit* dest)
+        : mapping(mapping), dest(dest), currentID(0) {}
+
+      __forceinline void operator() (const BBox3fa& b, const size_t index)
+      {
+        const vfloat4 lower = (vfloat4)b.lower;
+        const vfloat4 upper = (vfloat4)b.upper;
+        const vfloat4 centroid = lower+upper;
+        const vint4 binID = vint4((centroid-mapping.base)*mapping.scale);
+        dest[currentID].code  = MortonID64Bit::encode(extract<0>(binID),extract<1>(binID),extract<2>(binID));
+        dest[currentID].index = index;
+        currentID++;
+      }
+
+    public:
+      const MortonCodeMapping mapping;
+      MortonID64Bit* dest;
+      size_t currentID;
+    };
+
+    /*! selects the morton code generator for some morton code type */
+    template<typename MortonID> struct MortonCodeGeneratorT;
+    template<> struct MortonCodeGeneratorT<MortonID32Bit> { typedef MortonCodeGenerator   Type; };
+    template<> struct MortonCodeGeneratorT<MortonID64Bit> { typedef MortonCodeGenerator64 Type; };
+
+    template<typename MortonID>
+    static void InPlaceRadixSort(MortonID* const morton, const size_t num, const size_t shift = 8*(sizeof(typename MortonID::Key)-1))
     {
       static const size_t BITS = 8;
       static const size_t BUCKETS = (1 << BITS);
@@ -203,7 +274,7 @@ namespace embree
         /* process bucket */
         while(head[i] < tail[i])
         {
-          MortonID32Bit v = morton[head[i]];
+          MortonID v = morton[head[i]];
           while(1)
           {
             const size_t b = v.get(shift,BUCKETS-1);
@@ -227,7 +298,7 @@ namespace embree
           if (unlikely(count[i] < CMP_SORT_THRESHOLD))
             insertionsort_ascending(morton + offset, count[i]);
           else
-            InPlace32BitRadixSort(morton + offset, count[i], shift-BITS);
+            InPlaceRadixSort(morton + offset, count[i], shift-BITS);
 
           for (size_t j=offset;j<offset+count[i]-1;j++)
             assert(morton[j] <= morton[j+1]);
@@ -246,7 +317,8 @@ namespace embree
       typename SetNodeBoundsFunc, 
       typename CreateLeafFunc, 
       typename CalculateBounds, 
-      typename ProgressMonitor>
+      typename ProgressMonitor,
+      typename MortonID = MortonID32Bit>
 
       class GeneralBVHBuilderMorton
     {
@@ -258,6 +330,18 @@ namespace embree
       static const size_t SINGLE_THREADED_THRESHOLD = 4*1024;  //!< threshold to switch to single threaded build
 
 
+      typedef typename MortonID::Key Key;
+
+      /*! returns index of the most significant set bit */
+      static __forceinline size_t topBit(const unsigned int x) { return __bsr(x); }
+#if defined(__X86_64__)
+      static __forceinline size_t topBit(const uint64_t x) { return __bsr(size_t(x)); }
+#else
+      static __forceinline size_t topBit(const uint64_t x) { 
+        return (x >> 32) ? 32+__bsr(unsigned(x >> 32)) : __bsr(unsigned(x)); 
+      }
+#endif
+
     public:
       
       GeneralBVHBuilderMorton (const ReductionTy& identity, 
@@ -356,7 +440,7 @@ namespace embree
         for (size_t i=current.begin; i<current.end; i++)
           centBounds.extend(center2(calculateBounds(morton[i])));
         
-        MortonCodeGenerator::MortonCodeMapping mapping(centBounds);
+        MortonCodeGenerator::MortonCodeMapping mapping(centBounds,MortonID::LATTICE_BITS_PER_DIM);
         for (size_t i=current.begin; i<current.end; i++)
         {
           const BBox3fa b = calculateBounds(morton[i]);
@@ -367,30 +451,29 @@ namespace embree
           const unsigned int bx = extract<0>(binID);
           const unsigned int by = extract<1>(binID);
           const unsigned int bz = extract<2>(binID);
-          morton[i].code = bitInterleave(bx,by,bz);
+          morton[i].code = MortonID::encode(bx,by,bz);
         }
-        //std::sort(morton+current.begin,morton+current.end); // FIXME: use radix sort
-        InPlace32BitRadixSort(morton+current.begin,current.end-current.begin);
+        InPlaceRadixSort(morton+current.begin,current.end-current.begin);
       }
       
       __forceinline void split(MortonBuildRecord<NodeRef>& current,
                                MortonBuildRecord<NodeRef>& left,
                                MortonBuildRecord<NodeRef>& right) const
       {
-        const unsigned int code_start = morton[current.begin].code;
-        const unsigned int code_end   = morton[current.end-1].code;
-        unsigned int bitpos = lzcnt(code_start^code_end);
+        const Key code_start = morton[current.begin].code;
+        const Key code_end   = morton[current.end-1].code;
+        Key diff = code_start^code_end;
         
         /* if all items mapped to same morton code, then create new morton codes for the items */
-        if (unlikely(bitpos == 32)) // FIXME: maybe go here earlier to build better tree
+        if (unlikely(diff == 0)) // FIXME: maybe go here earlier to build better tree
         {
           recreateMortonCodes(current);
-          const unsigned int code_start = morton[current.begin].code;
-          const unsigned int code_end   = morton[current.end-1].code;
-          bitpos = lzcnt(code_start^code_end);
+          const Key code_start = morton[current.begin].code;
+          const Key code_end   = morton[current.end-1].code;
+          diff = code_start^code_end;
           
           /* if the morton code is still the same, goto fall back split */
-          if (unlikely(bitpos == 32)) 
+          if (unlikely(diff == 0)) 
           {
             size_t center = (current.begin + current.end)/2; 
             left.init(current.begin,center);
@@ -400,15 +483,14 @@ namespace embree
         }
         
         /* split the items at the topmost different morton code bit */
-        const unsigned int bitpos_diff = 31-bitpos;
-        const unsigned int bitmask = 1 << bitpos_diff;
+        const Key bitmask = Key(1) << topBit(diff);
         
         /* find location where bit differs using binary search */
         size_t begin = current.begin;
         size_t end   = current.end;
         while (begin + 1 != end) {
           const size_t mid = (begin+end)/2;
-          const unsigned bit = morton[mid].code & bitmask;
+          const Key bit = morton[mid].code & bitmask;
           if (bit == 0) begin = mid; else end = mid;
         }
         size_t center = end;
@@ -506,17 +588,11 @@ namespace embree
       }
       
       /* build function */
-      std::pair<NodeRef,BBox3fa> build(MortonID32Bit* src, MortonID32Bit* tmp, size_t numPrimitives) 
+      std::pair<NodeRef,BBox3fa> build(MortonID* src, MortonID* tmp, size_t numPrimitives) 
       {
-        /* using 4 phases radix sort */
-
-        //double i0 = getSeconds();
+        /* radix sort skips the passes where all morton codes share the same digit */
         morton = src;
-
-        radix_sort_u32(src,tmp,numPrimitives);
-
-        //i0 = getSeconds() - i0;
-        //if (numPrimitives > 1000000) PRINT(i0);
+        radix_sort<MortonID,Key>(src,tmp,numPrimitives);
 
         /* build BVH */
         NodeRef root;
@@ -529,7 +605,7 @@ namespace embree
       }
       
     public:
-      MortonID32Bit* morton;
+      MortonID* morton;
       const size_t branchingFactor;
       const size_t maxDepth;
       const size_t minLeafSize;
@@ -554,7 +630,8 @@ namespace embree
       typename SetBoundsFunc, 
       typename CreateLeafFunc, 
       typename CalculateBoundsFunc, 
-      typename ProgressMonitor>
+      typename ProgressMonitor,
+      typename MortonID>
 
       std::pair<NodeRef,BBox3fa> bvh_builder_morton_internal(CreateAllocFunc createAllocator, 
                                                              const ReductionTy& identity, 
@@ -563,8 +640,8 @@ namespace embree
                                                              CreateLeafFunc createLeaf, 
                                                              CalculateBoundsFunc calculateBounds,
                                                              ProgressMonitor progressMonitor,
-                                                             MortonID32Bit* src, 
-                                                             MortonID32Bit* tmp, 
+                                                             MortonID* src, 
+                                                             MortonID* tmp, 
                                                              size_t numPrimitives,
                                                              const size_t branchingFactor, 
                                                              const size_t maxDepth, 
@@ -580,7 +657,8 @@ namespace embree
         SetBoundsFunc,
         CreateLeafFunc,
         CalculateBoundsFunc,
-        ProgressMonitor> Builder;
+        ProgressMonitor,
+        MortonID> Builder;
 
       Builder builder(identity,
                       createAllocator,
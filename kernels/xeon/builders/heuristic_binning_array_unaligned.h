@@ -61,6 +61,24 @@ namespace embree
           return frame(axis).transposed();
         }
 
+        /*! calculates a space aligned to the average direction of all curves */
+        const LinearSpace3fa computeAverageAlignedSpace(const PrimInfo& pinfo)
+        {
+          Vec3fa axis(zero), ref(0,0,1);
+          bool haveRef = false;
+          for (size_t i=pinfo.begin; i<pinfo.end; i++)
+          {
+            const BezierPrim& prim = prims[i];
+            if (sqr_length(prim.p3 - prim.p0) <= 1E-18f) continue;
+            Vec3fa axis1 = normalize(prim.p3 - prim.p0);
+            if (!haveRef) { ref = axis1; haveRef = true; }
+            if (dot(axis1,ref) < 0.0f) axis1 = -axis1; // curves are not oriented
+            axis += axis1;
+          }
+          if (sqr_length(axis) <= 1E-18f) axis = Vec3fa(0,0,1);
+          return frame(normalize(axis)).transposed();
+        }
+
         const AffineSpace3fa computeAlignedSpaceMB(Scene* scene, const PrimInfo& pinfo)
         {
           /*! find first curve that defines valid directions */
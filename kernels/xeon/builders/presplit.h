@@ -64,6 +64,60 @@ namespace embree
       new (&right_o) PrimRef(cright,prim.geomID(), prim.primID());
     }
 
+    __forceinline void splitQuad(const PrimRef& prim, int dim, float pos, 
+                                 const Vec3fa& a, const Vec3fa& b, const Vec3fa& c, const Vec3fa& d, PrimRef& left_o, PrimRef& right_o)
+    {
+      /* split both triangles of the quad, as non-planar quads are not bounded by clipping their outline */
+      PrimRef left0,right0; splitTriangle(prim,dim,pos,a,b,d,left0,right0);
+      PrimRef left1,right1; splitTriangle(prim,dim,pos,c,d,b,left1,right1);
+      new (&left_o ) PrimRef(merge(left0 .bounds(),left1 .bounds()), prim.geomID(), prim.primID());
+      new (&right_o) PrimRef(merge(right0.bounds(),right1.bounds()), prim.geomID(), prim.primID());
+    }
+
+    /* Expected SAH gain of spatially splitting a triangle. This is the
+     * bounding box area that exceeds the box area of an axis aligned
+     * triangle with the same projected areas, which is zero for
+     * triangles that cannot get bounded tighter by splitting. */
+    __forceinline float splitGainTriangle(const PrimRef& prim, const Vec3fa& a, const Vec3fa& b, const Vec3fa& c)
+    {
+      const Vec3fa N = cross(b-a,c-a);
+      const float projectedArea = abs(N.x)+abs(N.y)+abs(N.z);
+      return max(0.0f,area(prim.bounds())-2.0f*projectedArea);
+    }
+
+    __forceinline float splitGainQuad(const PrimRef& prim, const Vec3fa& a, const Vec3fa& b, const Vec3fa& c, const Vec3fa& d)
+    {
+      const Vec3fa N = cross(b-a,d-a) + cross(d-c,b-c);
+      const float projectedArea = abs(N.x)+abs(N.y)+abs(N.z);
+      return max(0.0f,area(prim.bounds())-projectedArea);
+    }
+
+    /* splits a primitive of a triangle or quad mesh at some position and dimension */
+    __forceinline void splitPrimitive(const TriangleMesh* mesh, const PrimRef& prim, int dim, float pos, PrimRef& left_o, PrimRef& right_o)
+    {
+      const TriangleMesh::Triangle& tri = mesh->triangle(prim.primID());
+      splitTriangle(prim,dim,pos,mesh->vertex(tri.v[0]),mesh->vertex(tri.v[1]),mesh->vertex(tri.v[2]),left_o,right_o);
+    }
+
+    __forceinline void splitPrimitive(const QuadMesh* mesh, const PrimRef& prim, int dim, float pos, PrimRef& left_o, PrimRef& right_o)
+    {
+      const QuadMesh::Quad& quad = mesh->quad(prim.primID());
+      splitQuad(prim,dim,pos,mesh->vertex(quad.v[0]),mesh->vertex(quad.v[1]),mesh->vertex(quad.v[2]),mesh->vertex(quad.v[3]),left_o,right_o);
+    }
+
+    /* calculates the expected SAH gain of spatially splitting a primitive of a triangle or quad mesh */
+    __forceinline float splitGain(const TriangleMesh* mesh, const PrimRef& prim)
+    {
+      const TriangleMesh::Triangle& tri = mesh->triangle(prim.primID());
+      return splitGainTriangle(prim,mesh->vertex(tri.v[0]),mesh->vertex(tri.v[1]),mesh->vertex(tri.v[2]));
+    }
+
+    __forceinline float splitGain(const QuadMesh* mesh, const PrimRef& prim)
+    {
+      const QuadMesh::Quad& quad = mesh->quad(prim.primID());
+      return splitGainQuad(prim,mesh->vertex(quad.v[0]),mesh->vertex(quad.v[1]),mesh->vertex(quad.v[2]),mesh->vertex(quad.v[3]));
+    }
+
     template<typename Split>
       inline void split_primref(const PrimInfo& pinfo, Split& split, PrimRef& prim, PrimRef* prims_o, size_t N)
     {
@@ -236,6 +236,7 @@ namespace embree
     template PrimInfo createBezierRefArray<2>(Scene* scene, mvector<BezierPrim>& prims, BuildProgressMonitor& progressMonitor);
 
     template PrimInfo createPrimRefList<TriangleMesh,1>(Scene* scene, PrimRefList& prims, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefList<QuadMesh,1>(Scene* scene, PrimRefList& prims, BuildProgressMonitor& progressMonitor);
   }
 }
 
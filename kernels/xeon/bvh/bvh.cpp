@@ -139,9 +139,8 @@ namespace embree
     if (device->verbosity(1))
       std::cout << "building BVH" << N << "<" << primTy.name << "> using " << builderName << " ..." << std::flush;
 
-    double t0 = 0.0;
-    if (device->benchmark || device->verbosity(1)) t0 = getSeconds();
-    return t0;
+    lastBuilderName = builderName;
+    return getSeconds();
   }
 
   template<int N>
@@ -150,9 +149,15 @@ namespace embree
     if (t0 == double(inf))
       return;
     
-    double dt = 0.0;
-    if (device->benchmark || device->verbosity(1)) 
-      dt = getSeconds()-t0;
+    const double dt = getSeconds()-t0;
+
+    /* record build statistics */
+    size_t bytes = bytesAllocated();
+    for (size_t i=0; i<objects.size(); i++)
+      if (objects[i]) bytes += objects[i]->bytesAllocated();
+    scene->buildStat.add(this,lastBuilderName,primTy.name,dt,numPrimitives,bytes);
+    device->statBuilds++;
+    device->statBuildTime += size_t(1E6*dt);
 
     /* print statistics */
     if (device->verbosity(1)) {
@@ -173,10 +178,232 @@ namespace embree
     }
   }
 
+  template<int N>
+  size_t BVHN<N>::cacheNodeBytes(NodeRef node)
+  {
+    if (node.isNode())            return sizeof(Node);
+    if (node.isNodeMB())          return sizeof(NodeMB);
+    if (node.isUnalignedNode())   return sizeof(UnalignedNode);
+    if (node.isUnalignedNodeMB()) return sizeof(UnalignedNodeMB);
+    if (node.isQuantizedUnalignedNode()) return sizeof(QuantizedUnalignedNode);
+#if ENABLE_32BIT_OFFSETS_FOR_QUANTIZED_NODES == 0
+    if (node.isQuantizedNode())   return sizeof(QuantizedNode);
+#endif
+    return 0; // node type cannot get relocated
+  }
+
+  template<int N>
+  void BVHN<N>::cacheBytes(NodeRef node, size_t& nodeBytes, size_t& leafBytes) const
+  {
+    if (node == emptyNode)
+      return;
+
+    if (node.isLeaf()) {
+      size_t num; node.leaf(num);
+      leafBytes += ALIGN_PTR(num*primTy.bytes,cacheAlignment);
+      return;
+    }
+
+    const size_t bytes = cacheNodeBytes(node);
+    if (bytes == 0) 
+      throw_RTCError(RTC_INVALID_OPERATION,"BVH node type does not support scene caching");
+    nodeBytes += ALIGN_PTR(bytes,cacheAlignment);
+
+    const char* ptr = (const char*)(size_t(node) & ~align_mask);
+    const NodeRef* children = node.isQuantizedNode() ? &((const QuantizedNode*)ptr)->child(0) : ((const BaseNode*)ptr)->children;
+    for (size_t i=0; i<N; i++)
+      cacheBytes(children[i],nodeBytes,leafBytes);
+  }
+
+  template<int N>
+  typename BVHN<N>::NodeRef BVHN<N>::writeCacheRecursion(NodeRef node, char* base, size_t& nodeOfs, size_t& leafOfs) const
+  {
+    if (node == emptyNode)
+      return node;
+
+    /* copy primitive blocks of leaf and encode leaf as offset */
+    if (node.isLeaf()) 
+    {
+      size_t num; const char* prims = node.leaf(num);
+      const size_t bytes = num*primTy.bytes;
+      const size_t ofs = leafOfs;
+      memcpy(base+ofs,prims,bytes);
+      leafOfs += ALIGN_PTR(bytes,cacheAlignment);
+      return NodeRef(ofs | (size_t(node) & items_mask));
+    }
+
+    /* copy node and recurse into children */
+    const size_t bytes = cacheNodeBytes(node);
+    const size_t ofs = nodeOfs;
+    char* dst = base+ofs;
+    memcpy(dst,(const char*)(size_t(node) & ~align_mask),bytes);
+    nodeOfs += ALIGN_PTR(bytes,cacheAlignment);
+
+    NodeRef* children = node.isQuantizedNode() ? &((QuantizedNode*)dst)->child(0) : ((BaseNode*)dst)->children;
+    for (size_t i=0; i<N; i++)
+      children[i] = writeCacheRecursion(children[i],base,nodeOfs,leafOfs);
+
+    return NodeRef(ofs | (size_t(node) & align_mask));
+  }
+
+  template<int N>
+  void BVHN<N>::writeCache(std::ofstream& file)
+  {
+    if (root != emptyNode && (!primTy.relocatable || objects.size() || data_mem))
+      throw_RTCError(RTC_INVALID_OPERATION,"BVH over "+primTy.name+" primitives does not support scene caching");
+
+    /* nodes are stored in depth first order before all primitive blocks */
+    size_t nodeBytes = 0, leafBytes = 0;
+    cacheBytes(root,nodeBytes,leafBytes);
+    const size_t nodeOfs = ALIGN_PTR(sizeof(CacheHeader),cacheAlignment);
+    const size_t bytes = nodeOfs+nodeBytes+leafBytes;
+
+    char* base = (char*) alignedMalloc(bytes,cacheAlignment);
+    memset(base,0,bytes);
+
+    CacheHeader* header = (CacheHeader*) base;
+    strncpy(header->primTy,primTy.name.c_str(),sizeof(header->primTy)-1);
+    header->width = N;
+    header->leafBytes = (unsigned int) primTy.bytes;
+    header->bounds = bounds;
+    header->numPrimitives = numPrimitives;
+    header->numVertices = numVertices;
+    header->bytes = bytes;
+
+    size_t curNodeOfs = nodeOfs, curLeafOfs = nodeOfs+nodeBytes;
+    header->root = writeCacheRecursion(root,base,curNodeOfs,curLeafOfs);
+    assert(curNodeOfs == nodeOfs+nodeBytes);
+    assert(curLeafOfs == bytes);
+
+    file.write(base,bytes);
+    alignedFree(base);
+  }
+
+  template<int N>
+  bool BVHN<N>::loadCacheRecursion(NodeRef node, char* base, size_t bytes) const
+  {
+    char* ptr = (char*)(size_t(node) & ~align_mask);
+    NodeRef* children = node.isQuantizedNode() ? &((QuantizedNode*)ptr)->child(0) : ((BaseNode*)ptr)->children;
+    for (size_t i=0; i<N; i++)
+    {
+      if (children[i] == emptyNode) continue;
+
+      /* turn offset into pointer into the mapped file */
+      const size_t ofs = size_t(children[i]) & ~align_mask;
+      if (ofs < sizeof(CacheHeader) || ofs >= bytes) return false;
+      children[i] = NodeRef(size_t(children[i]) + size_t(base));
+
+      if (children[i].isLeaf()) {
+        size_t num; children[i].leaf(num);
+        if (ofs+num*primTy.bytes > bytes) return false;
+        continue;
+      }
+
+      const size_t nodeBytes = cacheNodeBytes(children[i]);
+      if (nodeBytes == 0 || ofs+nodeBytes > bytes) return false;
+      if (!loadCacheRecursion(children[i],base,bytes)) return false;
+    }
+    return true;
+  }
+
+  template<int N>
+  bool BVHN<N>::loadCache(char* ptr, size_t bytes)
+  {
+    const CacheHeader* header = (const CacheHeader*) ptr;
+    if (bytes < sizeof(CacheHeader) || header->bytes > bytes) return false;
+    if (header->width != N || header->leafBytes != primTy.bytes || primTy.name != std::string(header->primTy,strnlen(header->primTy,sizeof(header->primTy)))) 
+      return false;
+
+    /* only inner nodes get relocated, primitive blocks are paged in on first access */
+    NodeRef newroot = header->root;
+    if (newroot != emptyNode) 
+    {
+      const size_t ofs = size_t(newroot) & ~align_mask;
+      if (ofs < sizeof(CacheHeader) || ofs >= header->bytes) return false;
+      newroot = NodeRef(size_t(newroot) + size_t(ptr));
+      if (newroot.isLeaf()) {
+        size_t num; newroot.leaf(num);
+        if (ofs+num*primTy.bytes > header->bytes) return false;
+      }
+      else {
+        const size_t nodeBytes = cacheNodeBytes(newroot);
+        if (nodeBytes == 0 || ofs+nodeBytes > header->bytes) return false;
+        if (!loadCacheRecursion(newroot,ptr,header->bytes)) return false;
+      }
+    }
+
+    clear();
+    set(newroot,header->bounds,header->numPrimitives);
+    numVertices = header->numVertices;
+    return true;
+  }
+
 #if defined(__AVX__)
   template class BVHN<8>;
 #else
   template class BVHN<4>;
 #endif
+
+#if !defined(__AVX__)
+
+  /*! checks that the dequantized child bounds of a quantized unaligned node contain the bounds it got built from */
+  struct quantized_unaligned_node_regression_test : public RegressionTest
+  {
+    typedef BVHN<4>::QuantizedUnalignedNode QuantizedUnalignedNode;
+
+    quantized_unaligned_node_regression_test(const char* name) : RegressionTest(name) {
+      registerRegressionTest(this);
+    }
+
+    static float random_float(float lower, float upper) {
+      return lower + (upper-lower)*float(rand())/float(RAND_MAX);
+    }
+
+    static bool check(const LinearSpace3fa& space, const BBox3fa* bounds, size_t n)
+    {
+      QuantizedUnalignedNode node;
+      node.clear();
+      node.set(space,bounds,n);
+
+      bool passed = true;
+      const LinearSpace3fa nspace = node.getSpace();
+      passed &= all(eq_mask(nspace.vx,space.vx)) && all(eq_mask(nspace.vy,space.vy)) && all(eq_mask(nspace.vz,space.vz));
+      for (size_t i=0; i<n; i++)
+        passed &= subset(bounds[i],node.bounds(i));
+      return passed;
+    }
+
+    bool run ()
+    {
+      bool passed = true;
+
+      for (size_t i=0; i<10000; i++)
+      {
+        const Vec3fa vx = normalize(Vec3fa(random_float(-1,1),random_float(-1,1),random_float(-1,1)));
+        const LinearSpace3fa space = frame(vx).transposed();
+
+        /* boxes of very different size and distance to the origin */
+        const float ofs = random_float(-1.0f,1.0f)*powf(10.0f,float(rand()%7));
+        const float ext = powf(10.0f,float(rand()%9)-4.0f);
+        const size_t n = 1+rand()%4;
+        BBox3fa bounds[4];
+        for (size_t j=0; j<n; j++)
+        {
+          const Vec3fa p0(ofs+ext*random_float(-1,1),ofs+ext*random_float(-1,1),ofs+ext*random_float(-1,1));
+          const Vec3fa p1(ofs+ext*random_float(-1,1),ofs+ext*random_float(-1,1),ofs+ext*random_float(-1,1));
+          bounds[j] = BBox3fa(min(p0,p1),max(p0,p1));
+        }
+        passed &= check(space,bounds,n);
+
+        /* children without extent along some dimension */
+        for (size_t j=0; j<n; j++) bounds[j].upper.y = bounds[j].lower.y = ofs;
+        passed &= check(space,bounds,n);
+      }
+      return passed;
+    }
+  };
+
+  quantized_unaligned_node_regression_test quantized_unaligned_node_regression("quantized_unaligned_node_regression_test");
+#endif
 }
 
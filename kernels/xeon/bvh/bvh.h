@@ -38,6 +38,7 @@ namespace embree
     BVH_FLAG_UNALIGNED_NODE_MB = 0x01000,
     BVH_FLAG_TRANSFORM_NODE = 0x10000,
     BVH_FLAG_QUANTIZED_NODE = 0x100000,
+    BVH_FLAG_QUANTIZED_UNALIGNED_NODE = 0x1000000,
 
     /* short versions */
     BVH_AN1 = BVH_FLAG_ALIGNED_NODE,
@@ -49,7 +50,8 @@ namespace embree
     BVH_AN2_UN2 = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_UNALIGNED_NODE_MB,
     BVH_TN_AN1 = BVH_FLAG_TRANSFORM_NODE | BVH_FLAG_ALIGNED_NODE,
     BVH_TN_AN1_AN2 = BVH_FLAG_TRANSFORM_NODE | BVH_FLAG_ALIGNED_NODE | BVH_FLAG_ALIGNED_NODE_MB,
-    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE
+    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE,
+    BVH_AN1_QUN1 = BVH_FLAG_ALIGNED_NODE | BVH_FLAG_QUANTIZED_UNALIGNED_NODE
   };
 
   /*! Multi BVH with N children. Each node stores the bounding box of
@@ -68,6 +70,7 @@ namespace embree
     struct UnalignedNodeMB;
     struct TransformNode;
     struct QuantizedNode;
+    struct QuantizedUnalignedNode;
 
     /*! Number of bytes the nodes and primitives are minimally aligned to.*/
     static const size_t byteAlignment = 16;
@@ -87,6 +90,7 @@ namespace embree
     static const size_t tyUnalignedNodeMB = 3;
     static const size_t tyTransformNode = 4;
     static const size_t tyQuantizedNode = 5;
+    static const size_t tyQuantizedUnalignedNode = 6;
     static const size_t tyLeaf = 8;
 
     /*! Empty node */
@@ -357,6 +361,9 @@ namespace embree
       /*! checks if this is a quantized node */
       __forceinline int isQuantizedNode() const { return (ptr & (size_t)align_mask) == tyQuantizedNode; }
 
+      /*! checks if this is a quantized node with unaligned bounding boxes */
+      __forceinline int isQuantizedUnalignedNode() const { return (ptr & (size_t)align_mask) == tyQuantizedUnalignedNode; }
+
       /*! returns base node pointer */
       __forceinline BaseNode* baseNode(int types)
       {
@@ -403,6 +410,10 @@ namespace embree
       __forceinline       QuantizedNode* quantizedNode()       { assert(isQuantizedNode()); return (      QuantizedNode*)(ptr & ~(size_t)align_mask); }
       __forceinline const QuantizedNode* quantizedNode() const { assert(isQuantizedNode()); return (const QuantizedNode*)(ptr & ~(size_t)align_mask); }
 
+      /*! returns quantized unaligned node pointer */
+      __forceinline       QuantizedUnalignedNode* quantizedUnalignedNode()       { assert(isQuantizedUnalignedNode()); return (      QuantizedUnalignedNode*)(ptr & ~(size_t)align_mask); }
+      __forceinline const QuantizedUnalignedNode* quantizedUnalignedNode() const { assert(isQuantizedUnalignedNode()); return (const QuantizedUnalignedNode*)(ptr & ~(size_t)align_mask); }
+
       /*! returns leaf pointer */
       __forceinline char* leaf(size_t& num) const {
         assert(isLeaf());
@@ -542,6 +553,7 @@ namespace embree
         upper_x = upper_y = upper_z = vfloat<N>(nan);
         lower_dx = lower_dy = lower_dz = vfloat<N>(nan); // initialize with NAN and update during refit
         upper_dx = upper_dy = upper_dz = vfloat<N>(nan);
+        lower_t = vfloat<N>(0.0f); upper_t = vfloat<N>(1.0f);
         BaseNode::clear();
       }
 
@@ -569,8 +581,8 @@ namespace embree
         lower_x[i] = bounds0.lower.x; lower_y[i] = bounds0.lower.y; lower_z[i] = bounds0.lower.z;
         upper_x[i] = bounds0.upper.x; upper_y[i] = bounds0.upper.y; upper_z[i] = bounds0.upper.z;
 
-        /*! for empty bounds we have to avoid inf-inf=nan */
-        if (unlikely(bounds0.empty())) {
+        /*! for empty bounds we have to avoid inf-inf=nan, linear bounds of a time segment may be inverted at one end of the time range only */
+        if (unlikely(bounds0.empty() && bounds1.empty())) {
           lower_dx[i] = lower_dy[i] = lower_dz[i] = zero;
           upper_dx[i] = upper_dy[i] = upper_dz[i] = zero;
         }
@@ -583,6 +595,11 @@ namespace embree
         }
       }
 
+      /*! Sets the time range the child is valid for. */
+      __forceinline void setTimeRange(size_t i, const BBox1f& time_range) {
+        lower_t[i] = time_range.lower; upper_t[i] = time_range.upper;
+      }
+
       /*! tests if the node has valid bounds */
       __forceinline bool hasBounds() const {
         return lower_dx.i[0] != cast_f2i(float(nan));
@@ -639,6 +656,9 @@ namespace embree
         std::swap(upper_dy[i],upper_dy[j]);
         std::swap(lower_dz[i],lower_dz[j]);
         std::swap(upper_dz[i],upper_dz[j]);
+
+        std::swap(lower_t[i],lower_t[j]);
+        std::swap(upper_t[i],upper_t[j]);
       }
 
       /*! Returns reference to specified child */
@@ -659,6 +679,9 @@ namespace embree
       vfloat<N> upper_dy;        //!< Y dimension of upper bounds of all N children.
       vfloat<N> lower_dz;        //!< Z dimension of lower bounds of all N children.
       vfloat<N> upper_dz;        //!< Z dimension of upper bounds of all N children.
+
+      vfloat<N> lower_t;         //!< start of the time range of all N children.
+      vfloat<N> upper_t;         //!< end of the time range of all N children.
     };
 
     /*! Node with unaligned bounds */
@@ -982,6 +1005,99 @@ namespace embree
     };
 
 
+    /*! Node with unaligned bounds quantized to 8 bits. All children
+     *  share a single orientation, which allows the node to store only
+     *  one rotation and to intersect the children like aligned boxes
+     *  after the ray got transformed into that space once. */
+    struct QuantizedUnalignedNode : public BaseNode
+    {
+      using BaseNode::children;
+
+      /*! Clears the node. */
+      __forceinline void clear()
+      {
+        space = LinearSpace3f(one);
+        start = Vec3f(zero);
+        scale = Vec3f(zero);
+        for (size_t i=0; i<N; i++) lower_x[i] = lower_y[i] = lower_z[i] = QuantizedNode::MAX_QUAN_8BIT;
+        for (size_t i=0; i<N; i++) upper_x[i] = upper_y[i] = upper_z[i] = QuantizedNode::MIN_QUAN_8BIT;
+        BaseNode::clear();
+      }
+
+      /*! Sets the shared space and the bounds of the n children in that space. */
+      __forceinline void set(const LinearSpace3fa& s, const BBox3fa* bounds, const size_t n)
+      {
+        assert(n <= N);
+        space = LinearSpace3f(Vec3f(s.vx.x,s.vx.y,s.vx.z),Vec3f(s.vy.x,s.vy.y,s.vy.z),Vec3f(s.vz.x,s.vz.y,s.vz.z));
+        Vec3vfN lower(pos_inf), upper(neg_inf);
+        for (size_t i=0; i<n; i++) {
+          lower.x[i] = bounds[i].lower.x; lower.y[i] = bounds[i].lower.y; lower.z[i] = bounds[i].lower.z;
+          upper.x[i] = bounds[i].upper.x; upper.y[i] = bounds[i].upper.y; upper.z[i] = bounds[i].upper.z;
+        }
+        init_dim(lower.x,upper.x,lower_x,upper_x,start.x,scale.x);
+        init_dim(lower.y,upper.y,lower_y,upper_y,start.y,scale.y);
+        init_dim(lower.z,upper.z,lower_z,upper_z,start.z,scale.z);
+      }
+
+      /*! Returns the shared space of all children. */
+      __forceinline LinearSpace3fa getSpace() const {
+        return LinearSpace3fa(Vec3fa(space.vx.x,space.vx.y,space.vx.z),Vec3fa(space.vy.x,space.vy.y,space.vy.z),Vec3fa(space.vz.x,space.vz.y,space.vz.z));
+      }
+
+      /*! Returns bounds of specified child in the shared space. */
+      __forceinline BBox3fa bounds(size_t i) const
+      {
+        assert(i < N);
+        const Vec3fa lower(start.x + scale.x * (float)lower_x[i],
+                           start.y + scale.y * (float)lower_y[i],
+                           start.z + scale.z * (float)lower_z[i]);
+        const Vec3fa upper(start.x + scale.x * (float)upper_x[i],
+                           start.y + scale.y * (float)upper_y[i],
+                           start.z + scale.z * (float)upper_z[i]);
+        return BBox3fa(lower,upper);
+      }
+
+      /*! Returns the extent of the bounds of the ith child */
+      __forceinline Vec3fa extend(size_t i) const {
+        return bounds(i).size();
+      }
+
+      __forceinline vfloat<N> dequantizeLowerX() const { return vfloat<N>(start.x) + vfloat<N>(vint<N>::load(lower_x)) * scale.x; }
+      __forceinline vfloat<N> dequantizeUpperX() const { return vfloat<N>(start.x) + vfloat<N>(vint<N>::load(upper_x)) * scale.x; }
+      __forceinline vfloat<N> dequantizeLowerY() const { return vfloat<N>(start.y) + vfloat<N>(vint<N>::load(lower_y)) * scale.y; }
+      __forceinline vfloat<N> dequantizeUpperY() const { return vfloat<N>(start.y) + vfloat<N>(vint<N>::load(upper_y)) * scale.y; }
+      __forceinline vfloat<N> dequantizeLowerZ() const { return vfloat<N>(start.z) + vfloat<N>(vint<N>::load(lower_z)) * scale.z; }
+      __forceinline vfloat<N> dequantizeUpperZ() const { return vfloat<N>(start.z) + vfloat<N>(vint<N>::load(upper_z)) * scale.z; }
+
+    private:
+
+      /*! quantizes one dimension, a node without extent gets slightly enlarged to keep the quantization conservative */
+      static __forceinline void init_dim(const vfloat<N>& lower, const vfloat<N>& upper, unsigned char lower_quant[N], unsigned char upper_quant[N], float& start, float& scale)
+      {
+        const vbool<N> valid = lower != vfloat<N>(pos_inf);
+        const float minF = reduce_min(lower);
+        const float maxF = reduce_max(upper);
+        if (maxF > minF) {
+          QuantizedNode::init_dim(lower,upper,lower_quant,upper_quant,start,scale);
+        } else {
+          const float eps = max(abs(minF),1.0f)*float(ulp)*16.0f;
+          QuantizedNode::init_dim(lower,select(valid,upper+vfloat<N>(eps),upper),lower_quant,upper_quant,start,scale);
+        }
+      }
+
+    public:
+      LinearSpace3f space;       //!< shared space of all N children
+      Vec3f start;               //!< lower corner of the quantization grid in the shared space
+      Vec3f scale;               //!< size of one quantization step in the shared space
+      unsigned char lower_x[N];  //!< 8bit discretized X dimension of lower bounds of all N children
+      unsigned char upper_x[N];  //!< 8bit discretized X dimension of upper bounds of all N children
+      unsigned char lower_y[N];  //!< 8bit discretized Y dimension of lower bounds of all N children
+      unsigned char upper_y[N];  //!< 8bit discretized Y dimension of upper bounds of all N children
+      unsigned char lower_z[N];  //!< 8bit discretized Z dimension of lower bounds of all N children
+      unsigned char upper_z[N];  //!< 8bit discretized Z dimension of upper bounds of all N children
+    };
+
+
     /*! swap the children of two nodes */
     __forceinline static void swap(Node* a, size_t i, Node* b, size_t j)
     {
@@ -1080,6 +1196,35 @@ namespace embree
       alloc.cleanup();
     }
 
+    /*! writes the BVH in relocatable form to a scene cache file */
+    void writeCache(std::ofstream& file);
+
+    /*! initializes the BVH from data of a mapped scene cache file */
+    bool loadCache(char* ptr, size_t bytes);
+
+  private:
+
+    /*! header of a BVH stored in a scene cache file */
+    struct CacheHeader
+    {
+      char primTy[32];         //!< name of the primitive type
+      unsigned int width;      //!< branching factor
+      unsigned int leafBytes;  //!< bytes of one primitive block
+      size_t root;             //!< root node encoded as offset relative to the header
+      BBox3fa bounds;          //!< bounds of the BVH
+      size_t numPrimitives;    //!< number of primitives the BVH is build over
+      size_t numVertices;      //!< number of vertices the BVH references
+      size_t bytes;            //!< total number of bytes including this header
+    };
+
+    /*! alignment of nodes and primitive blocks in the scene cache */
+    static const size_t cacheAlignment = 64;
+
+    static size_t cacheNodeBytes(NodeRef node);
+    void cacheBytes(NodeRef node, size_t& nodeBytes, size_t& leafBytes) const;
+    NodeRef writeCacheRecursion(NodeRef node, char* base, size_t& nodeOfs, size_t& leafOfs) const;
+    bool loadCacheRecursion(NodeRef node, char* base, size_t bytes) const;
+
   public:
 
     /*! Encodes a node */
@@ -1118,6 +1263,11 @@ namespace embree
       return NodeRef((size_t) node | tyUnalignedNodeMB);
     }
 
+    /*! Encodes a quantized unaligned node */
+    static __forceinline NodeRef encodeNode(QuantizedUnalignedNode* node) {
+      return NodeRef((size_t) node | tyQuantizedUnalignedNode);
+    }
+
     /*! Encodes a transformation node */
     static __forceinline NodeRef encodeNode(TransformNode* node) {
       return NodeRef((size_t) node | tyTransformNode);
@@ -1157,6 +1307,10 @@ namespace embree
     std::vector<BVHN*> objects;
     void* data_mem;                   //!< additional memory, currently used for subdivpatch1cached memory
     size_t size_data_mem;
+
+    /*! statistics of the last build */
+  public:
+    std::string lastBuilderName;      //!< name of the builder used for the last build
   };
 
   template<>
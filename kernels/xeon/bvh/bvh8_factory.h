@@ -31,7 +31,9 @@ namespace embree
 
   public:
     Accel* BVH8OBBBezier1v(Scene* scene, bool highQuality);
+    Accel* BVH8OBBBezier4v(Scene* scene, bool highQuality);
     Accel* BVH8OBBBezier1i(Scene* scene, bool highQuality);
+    Accel* BVH8QuantizedOBBBezier1i(Scene* scene, bool highQuality);
     Accel* BVH8OBBBezier1iMB(Scene* scene, bool highQuality);
 
     Accel* BVH8Line4i(Scene* scene);
@@ -45,6 +47,7 @@ namespace embree
     Accel* BVH8Triangle4vMB(Scene* scene);
     Accel* BVH8SubdivGridEager(Scene* scene);
     Accel* BVH8Quad4v(Scene* scene);
+    Accel* BVH8Quad4vSpatialSplit(Scene* scene);
     Accel* BVH8Quad4i(Scene* scene);
     Accel* BVH8Quad4iMB(Scene* scene);
 
@@ -55,7 +58,9 @@ namespace embree
     Accel::Intersectors BVH8Line4iIntersectors(BVH8* bvh);
     Accel::Intersectors BVH8Line4iMBIntersectors(BVH8* bvh);
     Accel::Intersectors BVH8Bezier1vIntersectors_OBB(BVH8* bvh);
+    Accel::Intersectors BVH8Bezier4vIntersectors_OBB(BVH8* bvh);
     Accel::Intersectors BVH8Bezier1iIntersectors_OBB(BVH8* bvh);
+    Accel::Intersectors QBVH8Bezier1iIntersectors_OBB(BVH8* bvh);
     Accel::Intersectors BVH8Bezier1iMBIntersectors_OBB(BVH8* bvh);
     Accel::Intersectors BVH8Triangle4Intersectors(BVH8* bvh);
     Accel::Intersectors BVH8Triangle4vMBIntersectors(BVH8* bvh);
@@ -71,7 +76,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector1,BVH8Line4iIntersector1);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH8Line4iMBIntersector1);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH8Bezier1vIntersector1_OBB);
+    DEFINE_SYMBOL2(Accel::Intersector1,BVH8Bezier4vIntersector1_OBB);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH8Bezier1iIntersector1_OBB);
+    DEFINE_SYMBOL2(Accel::Intersector1,QBVH8Bezier1iIntersector1_OBB);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH8Bezier1iMBIntersector1_OBB);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH8Triangle4Intersector1Moeller);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH8Triangle4vMBIntersector1Moeller);
@@ -85,7 +92,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8Line4iIntersector4);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8Line4iMBIntersector4);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8Bezier1vIntersector4Single_OBB);
+    DEFINE_SYMBOL2(Accel::Intersector4,BVH8Bezier4vIntersector4Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8Bezier1iIntersector4Single_OBB);
+    DEFINE_SYMBOL2(Accel::Intersector4,QBVH8Bezier1iIntersector4Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8Bezier1iMBIntersector4Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8Triangle4Intersector4HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8Triangle4Intersector4HybridMoellerNoFilter);
@@ -100,7 +109,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8Line4iIntersector8);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8Line4iMBIntersector8);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8Bezier1vIntersector8Single_OBB);
+    DEFINE_SYMBOL2(Accel::Intersector8,BVH8Bezier4vIntersector8Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8Bezier1iIntersector8Single_OBB);
+    DEFINE_SYMBOL2(Accel::Intersector8,QBVH8Bezier1iIntersector8Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8Bezier1iMBIntersector8Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8Triangle4Intersector8HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8Triangle4Intersector8HybridMoellerNoFilter);
@@ -115,7 +126,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8Line4iIntersector16);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8Line4iMBIntersector16);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8Bezier1vIntersector16Single_OBB);
+    DEFINE_SYMBOL2(Accel::Intersector16,BVH8Bezier4vIntersector16Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8Bezier1iIntersector16Single_OBB);
+    DEFINE_SYMBOL2(Accel::Intersector16,QBVH8Bezier1iIntersector16Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8Bezier1iMBIntersector16Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8Triangle4Intersector16HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8Triangle4Intersector16HybridMoellerNoFilter);
@@ -143,7 +156,9 @@ namespace embree
     //DEFINE_SYMBOL2(Accel::IntersectorN,QBVH8Triangle4StreamIntersectorMoeller);
 
     DEFINE_BUILDER2(void,Scene,size_t,BVH8Bezier1vBuilder_OBB_New);
+    DEFINE_BUILDER2(void,Scene,size_t,BVH8Bezier4vBuilder_OBB_New);
     DEFINE_BUILDER2(void,Scene,size_t,BVH8Bezier1iBuilder_OBB_New);
+    DEFINE_BUILDER2(void,Scene,size_t,BVH8QuantizedBezier1iBuilder_OBB_New);
     DEFINE_BUILDER2(void,Scene,size_t,BVH8Bezier1iMBBuilder_OBB_New);
 
     DEFINE_BUILDER2(void,Scene,size_t,BVH8Line4iSceneBuilderSAH);
@@ -160,6 +175,7 @@ namespace embree
     DEFINE_BUILDER2(void,Scene,size_t,BVH8QuantizedQuad4iSceneBuilderSAH);
     
     DEFINE_BUILDER2(void,Scene,size_t,BVH8Triangle4SceneBuilderSpatialSAH);
+    DEFINE_BUILDER2(void,Scene,size_t,BVH8Quad4vSceneBuilderSpatialSAH);
 
     DEFINE_BUILDER2(void,Scene,size_t,BVH8SubdivGridEagerBuilderBinnedSAH);
   };
@@ -18,6 +18,7 @@
 #include "../builders/primrefgen.h"
 
 #include "../geometry/bezier1v.h"
+#include "../geometry/bezierv.h"
 #include "../geometry/bezier1i.h"
 
 #if defined(RTCORE_GEOMETRY_HAIR)
@@ -26,12 +27,12 @@ namespace embree
 {
   namespace isa
   {
-    template<int N, typename Primitive>
+    template<int N, typename Primitive, typename UnalignedNode = typename BVHN<N>::UnalignedNode>
     struct BVHNHairBuilderSAH : public Builder
     {
       typedef BVHN<N> BVH;
       typedef typename BVH::Node Node;
-      typedef typename BVH::UnalignedNode UnalignedNode;
+      typedef typename BVH::QuantizedUnalignedNode QuantizedUnalignedNode;
       typedef typename BVH::NodeRef NodeRef;
 
       BVH* bvh;
@@ -84,18 +85,13 @@ namespace embree
                  FastAllocator::ThreadLocal2* alloc) -> UnalignedNode*
             {
               UnalignedNode* node = (UnalignedNode*) alloc->alloc0.malloc(sizeof(UnalignedNode),16); node->clear();
-              for (size_t i=0; i<numChildren; i++) 
-              {
-                const LinearSpace3fa space = unalignedHeuristic.computeAlignedSpace(children[i]); 
-                const PrimInfo       sinfo = unalignedHeuristic.computePrimInfo(children[i],space);
-                node->set(i,OBBox3fa(space,sinfo.geomBounds));
-              }
+              setBounds(node,children,numChildren,unalignedHeuristic);
               return node;
             },
 
             [&] (size_t depth, const PrimInfo& pinfo, FastAllocator::ThreadLocal2* alloc) -> NodeRef
             {
-              size_t items = pinfo.size();
+              size_t items = Primitive::blocks(pinfo.size());
               size_t start = pinfo.begin;
               Primitive* accel = (Primitive*) alloc->alloc1.malloc(items*sizeof(Primitive));
               NodeRef node = bvh->encodeLeaf((char*)accel,items);
@@ -105,7 +101,7 @@ namespace embree
               return node;
             },
             progress,
-            prims.data(),pinfo,N,BVH::maxBuildDepthLeaf,1,1,BVH::maxLeafBlocks);
+            prims.data(),pinfo,N,BVH::maxBuildDepthLeaf,1,Primitive::max_size(),BVH::maxLeafBlocks*Primitive::max_size());
         
         bvh->set(root,pinfo.geomBounds,pinfo.size());
         
@@ -123,6 +119,38 @@ namespace embree
       void clear() {
         prims.clear();
       }
+
+    private:
+
+      /*! each child of an unaligned node gets its own space */
+      static __forceinline void setBounds(typename BVH::UnalignedNode* node, const PrimInfo* children, const size_t numChildren,
+                                          UnalignedHeuristicArrayBinningSAH<BezierPrim>& unalignedHeuristic)
+      {
+        for (size_t i=0; i<numChildren; i++) 
+        {
+          const LinearSpace3fa space = unalignedHeuristic.computeAlignedSpace(children[i]); 
+          const PrimInfo       sinfo = unalignedHeuristic.computePrimInfo(children[i],space);
+          node->set(i,OBBox3fa(space,sinfo.geomBounds));
+        }
+      }
+
+      /*! all children of a quantized unaligned node share the space aligned to the average curve direction */
+      static __forceinline void setBounds(QuantizedUnalignedNode* node, const PrimInfo* children, const size_t numChildren,
+                                          UnalignedHeuristicArrayBinningSAH<BezierPrim>& unalignedHeuristic)
+      {
+        /* the children partition the primitive range of the node */
+        PrimInfo pinfo = children[0];
+        for (size_t i=1; i<numChildren; i++) {
+          pinfo.begin = min(pinfo.begin,children[i].begin);
+          pinfo.end   = max(pinfo.end  ,children[i].end);
+        }
+        const LinearSpace3fa space = unalignedHeuristic.computeAverageAlignedSpace(pinfo);
+
+        BBox3fa bounds[N];
+        for (size_t i=0; i<numChildren; i++)
+          bounds[i] = unalignedHeuristic.computePrimInfo(children[i],space).geomBounds;
+        node->set(space,bounds,numChildren);
+      }
     };
 
 
@@ -225,12 +253,16 @@ namespace embree
     
     /*! entry functions for the builder */
     Builder* BVH4Bezier1vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Bezier1v>((BVH4*)bvh,scene); }
+    Builder* BVH4Bezier4vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Bezier4v>((BVH4*)bvh,scene); }
     Builder* BVH4Bezier1iBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Bezier1i>((BVH4*)bvh,scene); }
+    Builder* BVH4QuantizedBezier1iBuilder_OBB_New (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Bezier1i,BVH4::QuantizedUnalignedNode>((BVH4*)bvh,scene); }
     Builder* BVH4Bezier1iMBBuilder_OBB_New (void* bvh, Scene* scene, size_t mode) { return new BVHNHairMBBuilderSAH<4,Bezier1i>((BVH4*)bvh,scene); }
 
 #if defined(__AVX__)
     Builder* BVH8Bezier1vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<8,Bezier1v>((BVH8*)bvh,scene); }
+    Builder* BVH8Bezier4vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<8,Bezier4v>((BVH8*)bvh,scene); }
     Builder* BVH8Bezier1iBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<8,Bezier1i>((BVH8*)bvh,scene); }
+    Builder* BVH8QuantizedBezier1iBuilder_OBB_New (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<8,Bezier1i,BVH8::QuantizedUnalignedNode>((BVH8*)bvh,scene); }
     Builder* BVH8Bezier1iMBBuilder_OBB_New (void* bvh, Scene* scene, size_t mode) { return new BVHNHairMBBuilderSAH<8,Bezier1i>((BVH8*)bvh,scene); }
 #endif
 
@@ -96,16 +96,16 @@ namespace embree
       }
     };
 
-    template<int N, typename Primitive>
+    template<int N, typename Primitive, typename MortonID>
     struct CreateMortonLeaf;
 
-    template<int N>
-    struct CreateMortonLeaf<N,Triangle4>
+    template<int N, typename MortonID>
+    struct CreateMortonLeaf<N,Triangle4,MortonID>
     {
       typedef BVHN<N> BVH;
       typedef typename BVH::NodeRef NodeRef;
 
-      __forceinline CreateMortonLeaf (TriangleMesh* mesh, MortonID32Bit* morton)
+      __forceinline CreateMortonLeaf (TriangleMesh* mesh, MortonID* morton)
         : mesh(mesh), morton(morton) {}
 
       __noinline void operator() (MortonBuildRecord<NodeRef>& current, FastAllocator::ThreadLocal2* alloc, BBox3fa& box_o)
@@ -151,16 +151,16 @@ namespace embree
     
     private:
       TriangleMesh* mesh;
-      MortonID32Bit* morton;
+      MortonID* morton;
     };
     
-    template<int N>
-    struct CreateMortonLeaf<N,Triangle4v>
+    template<int N, typename MortonID>
+    struct CreateMortonLeaf<N,Triangle4v,MortonID>
     {
       typedef BVHN<N> BVH;
       typedef typename BVH::NodeRef NodeRef;
 
-      __forceinline CreateMortonLeaf (TriangleMesh* mesh, MortonID32Bit* morton)
+      __forceinline CreateMortonLeaf (TriangleMesh* mesh, MortonID* morton)
         : mesh(mesh), morton(morton) {}
       
       __noinline void operator() (MortonBuildRecord<NodeRef>& current, FastAllocator::ThreadLocal2* alloc, BBox3fa& box_o)
@@ -205,16 +205,16 @@ namespace embree
       }
     private:
       TriangleMesh* mesh;
-      MortonID32Bit* morton;
+      MortonID* morton;
     };
 
-    template<int N>
-    struct CreateMortonLeaf<N,Triangle4i>
+    template<int N, typename MortonID>
+    struct CreateMortonLeaf<N,Triangle4i,MortonID>
     {
       typedef BVHN<N> BVH;
       typedef typename BVH::NodeRef NodeRef;
 
-      __forceinline CreateMortonLeaf (TriangleMesh* mesh, MortonID32Bit* morton)
+      __forceinline CreateMortonLeaf (TriangleMesh* mesh, MortonID* morton)
         : mesh(mesh), morton(morton) {}
       
       __noinline void operator() (MortonBuildRecord<NodeRef>& current, FastAllocator::ThreadLocal2* alloc, BBox3fa& box_o)
@@ -270,7 +270,7 @@ namespace embree
       }
     private:
       TriangleMesh* mesh;
-      MortonID32Bit* morton;
+      MortonID* morton;
     };
     
     template<typename Mesh>
@@ -279,7 +279,8 @@ namespace embree
       __forceinline CalculateMeshBounds (Mesh* mesh)
         : mesh(mesh) {}
       
-      __forceinline const BBox3fa operator() (const MortonID32Bit& morton) {
+      template<typename MortonID>
+      __forceinline const BBox3fa operator() (const MortonID& morton) {
         return mesh->bounds(morton.index);
       }
       
@@ -294,16 +295,36 @@ namespace embree
       typedef typename BVH::Node Node;
       typedef typename BVH::NodeRef NodeRef;
 
+      static const size_t MORTON_64BIT_THRESHOLD = 1024*1024; //!< number of primitives where 32 bit codes start to saturate a surface
+      static const size_t MORTON_64BIT_MIN_PRIMITIVES = 64*1024; //!< minimal number of primitives to consider 64 bit codes
+
     public:
       
       BVHNMeshBuilderMorton (BVH* bvh, Mesh* mesh, const size_t minLeafSize, const size_t maxLeafSize)
-        : bvh(bvh), mesh(mesh), minLeafSize(minLeafSize), maxLeafSize(maxLeafSize), morton(bvh->device), numPrimitives(0) {}
+        : bvh(bvh), mesh(mesh), minLeafSize(minLeafSize), maxLeafSize(maxLeafSize), morton(bvh->device), morton64(bvh->device), numPrimitives(0) {}
       
       /*! Destruction */
       ~BVHNMeshBuilderMorton () {
         //bvh->shrink();
       }
-      
+
+      /*! selects 64 bit morton codes if the 32 bit lattice is too coarse for the primitives */
+      bool useMortonCode64Bit(const BBox3fa& centBounds, const float sumPrimSize, const size_t numPrimitivesGen) const
+      {
+        const int bits = bvh->device->morton_code_bits;
+        if (bits == 32) return false;
+        if (bits == 64) return true;
+        
+        if (numPrimitivesGen >= MORTON_64BIT_THRESHOLD) return true;
+        if (numPrimitivesGen <  MORTON_64BIT_MIN_PRIMITIVES) return false;
+
+        /* primitives are on average much smaller than a lattice cell,
+         * thus many of them will end up in the same cell */
+        const float cellSize = reduce_max(centBounds.size())/float(MortonCodeGenerator::LATTICE_SIZE_PER_DIM);
+        const float avgPrimSize = sumPrimSize/float(numPrimitivesGen);
+        return 8.0f*avgPrimSize < cellSize;
+      }
+
       /* build function */
       void build(size_t threadIndex, size_t threadCount) 
       {
@@ -320,51 +341,92 @@ namespace embree
           bvh->set(BVH::emptyNode,empty,0);
           return;
         }
-        
-        auto progress = [&] (size_t dn) { bvh->scene->progressMonitor(dn); };
-        
-        /* preallocate arrays */
-        morton.resize(numPrimitives);
-        size_t bytesAllocated = numPrimitives*sizeof(Node)/(4*N) + size_t(1.2f*Primitive::blocks(numPrimitives)*sizeof(Primitive));
-        size_t bytesMortonCodes = numPrimitives*sizeof(MortonID32Bit);
-        bytesAllocated = max(bytesAllocated,bytesMortonCodes); // the first allocation block is reused to sort the morton codes
-        bvh->alloc.init(bytesAllocated,2*bytesAllocated);
+
+        double t0 = bvh->preBuild(bvh->device->benchmark ? TOSTRING(isa) "::BVH" + toString(N) + "BuilderMorton" : "");
 
         size_t block_size = size_t(BLOCK_SIZE);
 
-        /* compute scene bounds */
-        BBox3fa cb_empty(empty); cb_empty.lower.a = 0;
+        /* compute scene bounds, number of valid primitives, and sum of primitive sizes */
+        BBox3fa cb_empty(empty); cb_empty.lower.a = 0; cb_empty.upper.a = 0;
         const BBox3fa centBounds = parallel_reduce 
           ( size_t(0), numPrimitives, block_size, cb_empty, [&](const range<size_t>& r) -> BBox3fa
             {
               BBox3fa bounds = empty;
 
               size_t num = 0;
+              float size = 0.0f;
               for (ssize_t j=r.begin(); j<r.end(); j++)
               {
                 BBox3fa prim_bounds = empty;
                 if (unlikely(!mesh->valid(j,&prim_bounds))) continue;
                 bounds.extend(center2(prim_bounds));
+                size += 2.0f*reduce_max(prim_bounds.size());
                 num++;
               }
               bounds.lower.a = num;
-              //for (size_t i=r.begin(); i<r.end(); i++) bounds.extend(center2(mesh->bounds(i)));
+              bounds.upper.a = size;
               return bounds;
-            }, [] (const BBox3fa& a, const BBox3fa& b) { BBox3fa c = merge(a,b); c.lower.a = a.lower.a + b.lower.a; return c; });
+            }, [] (const BBox3fa& a, const BBox3fa& b) { 
+              BBox3fa c = merge(a,b); 
+              c.lower.a = a.lower.a + b.lower.a; 
+              c.upper.a = a.upper.a + b.upper.a; 
+              return c; 
+            });
 
         size_t numPrimitivesGen = centBounds.lower.a;
 
-        /* compute morton codes */
+        /* build with 64 bit codes only when required, as they need twice the sorting passes */
+        if (useMortonCode64Bit(centBounds,centBounds.upper.a,numPrimitivesGen)) {
+          morton.clear();
+          build(morton64,centBounds,numPrimitivesGen);
+        } else {
+          morton64.clear();
+          build(morton,centBounds,numPrimitivesGen);
+        }
+        
+#if ROTATE_TREE
+        if (N == 4)
+        {
+          for (int i=0; i<ROTATE_TREE; i++)
+            BVHNRotate<N>::rotate(bvh->root);
+          bvh->clearBarrier(bvh->root);
+        }
+#endif
 
-        MortonID32Bit* dest = (MortonID32Bit*) bvh->alloc.specialAlloc(bytesMortonCodes);
+        /* clear temporary data for static geometry */
+        if (mesh->isStatic()) 
+        {
+          morton.clear();
+          morton64.clear();
+          bvh->shrink();
+        }
+        bvh->cleanup();
+        bvh->postBuild(t0);
+      }
 
+      template<typename MortonID>
+      void build(mvector<MortonID>& morton, const BBox3fa& centBounds, const size_t numPrimitivesGen)
+      {
+        auto progress = [&] (size_t dn) { bvh->scene->progressMonitor(dn); };
+        
+        /* preallocate arrays */
+        morton.resize(numPrimitives);
+        size_t bytesAllocated = numPrimitives*sizeof(Node)/(4*N) + size_t(1.2f*Primitive::blocks(numPrimitives)*sizeof(Primitive));
+        size_t bytesMortonCodes = numPrimitives*sizeof(MortonID);
+        bytesAllocated = max(bytesAllocated,bytesMortonCodes); // the first allocation block is reused to sort the morton codes
+        bvh->alloc.init(bytesAllocated,2*bytesAllocated);
+
+        size_t block_size = size_t(BLOCK_SIZE);
+
+        /* compute morton codes */
+        MortonID* dest = (MortonID*) bvh->alloc.specialAlloc(bytesMortonCodes);
+        MortonCodeGenerator::MortonCodeMapping mapping(centBounds,MortonID::LATTICE_BITS_PER_DIM);
 
         if (likely(numPrimitivesGen == numPrimitives))
         {
           /* fast path */
-          MortonCodeGenerator::MortonCodeMapping mapping(centBounds);
           parallel_for( size_t(0), numPrimitives, block_size, [&](const range<size_t>& r) -> void {
-              MortonCodeGenerator generator(mapping,&morton.data()[r.begin()]);
+              typename MortonCodeGeneratorT<MortonID>::Type generator(mapping,&morton.data()[r.begin()]);
               for (ssize_t j=r.begin(); j<r.end(); j++)
                 generator(mesh->bounds(j),j);
             });
@@ -375,10 +437,9 @@ namespace embree
           /* slow path, fallback in case some primitives were invalid */
 
           ParallelPrefixSumState<size_t> pstate;
-          MortonCodeGenerator::MortonCodeMapping mapping(centBounds);
           size_t numPrimitivesGen2 = parallel_prefix_sum( pstate, size_t(0), numPrimitives, block_size, size_t(0), [&](const range<size_t>& r, const size_t base) -> size_t {
               size_t num = 0;
-              MortonCodeGenerator generator(mapping,&morton.data()[r.begin()]);
+              typename MortonCodeGeneratorT<MortonID>::Type generator(mapping,&morton.data()[r.begin()]);
               for (ssize_t j=r.begin(); j<r.end(); j++)
               {
                 BBox3fa bounds = empty;
@@ -391,7 +452,7 @@ namespace embree
 
           numPrimitivesGen2 = parallel_prefix_sum( pstate, size_t(0), numPrimitives, block_size, size_t(0), [&](const range<size_t>& r, const size_t base) -> size_t {
               size_t num = 0;
-              MortonCodeGenerator generator(mapping,&morton.data()[base]);
+              typename MortonCodeGeneratorT<MortonID>::Type generator(mapping,&morton.data()[base]);
               for (ssize_t j=r.begin(); j<r.end(); j++)
               {
                 BBox3fa bounds = empty;
@@ -406,7 +467,7 @@ namespace embree
         /* create BVH */
         AllocBVHNNode<N> allocNode;
         SetBVHNBounds<N> setBounds(bvh);
-        CreateMortonLeaf<N,Primitive> createLeaf(mesh,morton.data());
+        CreateMortonLeaf<N,Primitive,MortonID> createLeaf(mesh,morton.data());
         CalculateMeshBounds<Mesh> calculateBounds(mesh);
         auto node_bounds = bvh_builder_morton_internal<NodeRef>(
           typename BVH::CreateAlloc(bvh), BBox3fa(empty),
@@ -414,27 +475,11 @@ namespace embree
           morton.data(),dest,numPrimitivesGen,N,BVH::maxBuildDepth,minLeafSize,maxLeafSize);
         
         bvh->set(node_bounds.first,node_bounds.second,numPrimitives);
-        
-#if ROTATE_TREE
-        if (N == 4)
-        {
-          for (int i=0; i<ROTATE_TREE; i++)
-            BVHNRotate<N>::rotate(bvh->root);
-          bvh->clearBarrier(bvh->root);
-        }
-#endif
-
-        /* clear temporary data for static geometry */
-        if (mesh->isStatic()) 
-        {
-          morton.clear();
-          bvh->shrink();
-        }
-        bvh->cleanup();
       }
       
       void clear() {
         morton.clear();
+        morton64.clear();
       }
       
     private:
@@ -444,6 +489,7 @@ namespace embree
       const size_t maxLeafSize;
       size_t numPrimitives;
       mvector<MortonID32Bit> morton;
+      mvector<MortonID64Bit> morton64;
     };
 
 #if defined(RTCORE_GEOMETRY_TRIANGLES)
@@ -19,6 +19,7 @@
 
 #include "../builders/primrefgen.h"
 #include "../builders/presplit.h"
+#include "../../algorithms/parallel_reduce.h"
 
 #include "../geometry/bezier1v.h"
 #include "../geometry/bezier1i.h"
@@ -27,6 +28,7 @@
 #include "../geometry/trianglev.h"
 #include "../geometry/trianglei.h"
 #include "../geometry/trianglev_mb.h"
+#include "../geometry/triangleq.h"
 #include "../geometry/quadv.h"
 #include "../geometry/quadi.h"
 #include "../geometry/quadi_mb.h"
@@ -313,12 +315,12 @@ namespace embree
       const float intCost;
       const size_t minLeafSize;
       const size_t maxLeafSize;
-      const float presplitFactor;
+      const float replicationFactor;
 
       BVHNBuilderSpatialSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize,
                              const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(scene), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
-          presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f) {}
+          replicationFactor(max(1.0f,float(scene->device->tri_builder_replication_factor))) {}
 
       void build(size_t, size_t) 
       {
@@ -335,21 +337,27 @@ namespace embree
         PrimRefList prims;
         PrimInfo pinfo = createPrimRefList<Mesh,1>(scene,prims,bvh->scene->progressInterface);
         
-        /* calculate total surface area */
+        /* calculate total expected SAH gain of spatial splits */
         PrimRefList::iterator iter = prims;
         const size_t threadCount = TaskScheduler::threadCount();
-        const double A = parallel_reduce(size_t(0),threadCount,0.0, [&] (const range<size_t>& r) -> double // FIXME: this sum is not deterministic
+        const double G = parallel_reduce(size_t(0),threadCount,0.0, [&] (const range<size_t>& r) -> double // FIXME: this sum is not deterministic
         {
-          double A = 0.0f;
+          double G = 0.0f;
           while (PrimRefList::item* block = iter.next()) {
-            for (size_t i=0; i<block->size(); i++) 
-              A += area(block->at(i).bounds());
+            for (size_t i=0; i<block->size(); i++) {
+              const PrimRef& prim = block->at(i);
+              G += splitGain((Mesh*)scene->get(prim.geomID()),prim);
+            }
           }
-          return A;
+          return G;
         },std::plus<double>());
         
-        /* calculate maximal number of spatial splits per primitive */
-        float f = 10.0f;
+        /* distribute the budget of additional primitive references
+         * over the primitives by their expected SAH gain. A primitive
+         * with n splits can never produce more than n references,
+         * thus the builder never exceeds replicationFactor*N many
+         * references. */
+        const double numSplits = double(replicationFactor-1.0f)*double(pinfo.size());
         iter = prims;
         parallel_reduce(size_t(0),threadCount,size_t(0), [&] (const range<size_t>& r) -> size_t
         {
@@ -358,10 +366,8 @@ namespace embree
             for (size_t i=0; i<block->size(); i++) {
               PrimRef& prim = block->at(i);
               assert((prim.lower.a & 0xFF000000) == 0);
-              const float nf = ceil(f*pinfo.size()*area(prim.bounds())/A);
-              //const size_t n = 64;
-              //const size_t n = min(ssize_t(127), max(ssize_t(1), ssize_t(nf)));
-              const size_t n = 4+min(ssize_t(127-4), max(ssize_t(1), ssize_t(nf)));
+              const double nf = G > 0.0 ? floor(numSplits*splitGain((Mesh*)scene->get(prim.geomID()),prim)/G) : 0.0;
+              const size_t n = 1+min(ssize_t(127-1), ssize_t(nf));
               num += n;
               prim.lower.a |= n << 24;
             }
@@ -370,18 +376,13 @@ namespace embree
         },std::plus<size_t>());
         
         /* function that splits a primitive at some position and dimension */
-        auto splitPrimitive = [&] (const PrimRef& prim, int dim, float pos, PrimRef& left_o, PrimRef& right_o) {
-          TriangleMesh* mesh = (TriangleMesh*) scene->get(prim.geomID() & 0x00FFFFFF); 
-          TriangleMesh::Triangle tri = mesh->triangle(prim.primID());
-          const Vec3fa v0 = mesh->vertex(tri.v[0]);
-          const Vec3fa v1 = mesh->vertex(tri.v[1]);
-          const Vec3fa v2 = mesh->vertex(tri.v[2]);
-          splitTriangle(prim,dim,pos,v0,v1,v2,left_o,right_o);
+        auto splitPrimRef = [&] (const PrimRef& prim, int dim, float pos, PrimRef& left_o, PrimRef& right_o) {
+          splitPrimitive((Mesh*)scene->get(prim.geomID() & 0x00FFFFFF),prim,dim,pos,left_o,right_o);
         };
              
         /* call BVH builder */
         bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
-        BVHNBuilderSpatial<N>::build(bvh,splitPrimitive,CreateListLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,prims,pinfo,
+        BVHNBuilderSpatial<N>::build(bvh,splitPrimRef,CreateListLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,prims,pinfo,
                                     sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
         
         /* clear temporary data for static geometry */
@@ -404,7 +405,8 @@ namespace embree
     struct CreateLeafMB
     {
       typedef BVHN<N> BVH;
-      __forceinline CreateLeafMB (BVH* bvh, PrimRef* prims) : bvh(bvh), prims(prims) {}
+      __forceinline CreateLeafMB (BVH* bvh, PrimRef* prims, const BBox1f& time_range = BBox1f(0.0f,1.0f)) 
+        : bvh(bvh), prims(prims), time_range(time_range) {}
       
       __forceinline std::pair<BBox3fa,BBox3fa> operator() (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc)
       {
@@ -415,7 +417,7 @@ namespace embree
 	BBox3fa bounds0 = empty;
 	BBox3fa bounds1 = empty;
         for (size_t i=0; i<items; i++) {
-          auto bounds = accel[i].fill_mblur(prims,start,current.prims.end(),bvh->scene,false);
+          auto bounds = accel[i].fill_mblur(prims,start,current.prims.end(),bvh->scene,false,time_range);
 	  bounds0.extend(bounds.first);
 	  bounds1.extend(bounds.second);
         }
@@ -425,12 +427,15 @@ namespace embree
 
       BVH* bvh;
       PrimRef* prims;
+      BBox1f time_range;
     };
 
     template<int N, typename Mesh, typename Primitive>
     struct BVHNBuilderMblurSAH : public Builder
     {
       typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::NodeMB NodeMB;
       BVH* bvh;
       Scene* scene;
       Mesh* mesh;
@@ -466,10 +471,34 @@ namespace embree
           createPrimRefArray<Mesh>(mesh,prims,bvh->scene->progressInterface) : 
           createPrimRefArray<Mesh,2>(scene,prims,bvh->scene->progressInterface);
         
+        /* gather the time intervals of all motion blurred meshes */
+        const std::vector<BBox1f> timeIntervals = getTimeIntervals();
+
         /* call BVH builder */
-        bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
-        BVHNBuilderMblur<N>::build(bvh,CreateLeafMB<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,
-                                  sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+        bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef)*timeIntervals.size());
+        if (timeIntervals.size() == 1)
+        {
+          BVHNBuilderMblur<N>::build(bvh,CreateLeafMB<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,
+                                    sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+        }
+
+        /* build one BVH per time interval and join them with nodes that store the time range of each child */
+        else
+        {
+          std::vector<NodeRef> roots(timeIntervals.size());
+          std::vector<BBox3fa> bounds(timeIntervals.size());
+          for (size_t i=0; i<timeIntervals.size(); i++) 
+          {
+            const PrimInfo pinfo_i = updatePrimRefBounds(pinfo.size(),timeIntervals[i]);
+            BVHNBuilderMblur<N>::build(bvh,CreateLeafMB<N,Primitive>(bvh,prims.data(),timeIntervals[i]),bvh->scene->progressInterface,prims.data(),pinfo_i,
+                                      sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+            roots[i] = bvh->root;
+            bounds[i] = pinfo_i.geomBounds;
+          }
+          BBox3fa rootBounds;
+          const NodeRef root = createTimeSplitTree(roots.data(),bounds.data(),timeIntervals.data(),timeIntervals.size(),rootBounds);
+          bvh->set(root,rootBounds,pinfo.size());
+        }
         
 	/* clear temporary data for static geometry */
 	bool staticGeom = mesh ? mesh->isStatic() : scene->isStatic();
@@ -484,6 +513,75 @@ namespace embree
       void clear() {
         prims.clear();
       }
+
+      /*! splits the [0,1] time range at the time steps of all motion blurred meshes */
+      std::vector<BBox1f> getTimeIntervals() const
+      {
+        std::set<unsigned> numTimeSteps;
+        if (mesh) numTimeSteps.insert(mesh->numTimeSteps);
+        else 
+        {
+          Scene::Iterator<Mesh,2> iter(scene);
+          for (size_t i=0; i<iter.size(); i++)
+            if (iter[i]) numTimeSteps.insert(iter[i]->numTimeSteps);
+        }
+
+        std::set<float> times;
+        times.insert(0.0f); times.insert(1.0f);
+        for (unsigned numSteps : numTimeSteps)
+          for (unsigned i=1; i+1<numSteps; i++)
+            times.insert(float(i)/float(numSteps-1));
+
+        std::vector<BBox1f> intervals;
+        for (auto t0 = times.begin(), t1 = std::next(t0); t1 != times.end(); t0++, t1++)
+          intervals.push_back(BBox1f(*t0,*t1));
+        return intervals;
+      }
+
+      /*! sets the bounds of each primitive to its bounds over the time segment that contains the time interval */
+      PrimInfo updatePrimRefBounds(const size_t numPrims, const BBox1f& time_range)
+      {
+        const float time = 0.5f*(time_range.lower+time_range.upper);
+        return parallel_reduce(size_t(0), numPrims, size_t(1024), PrimInfo(empty), [&] (const range<size_t>& r) -> PrimInfo 
+        {
+          PrimInfo pinfo(empty);
+          for (size_t i=r.begin(); i<r.end(); i++)
+          {
+            const unsigned geomID = prims[i].geomID();
+            const unsigned primID = prims[i].primID();
+            const Mesh* m = mesh ? mesh : (Mesh*) scene->get(geomID);
+            float ftime; const int itime = m->timeSegment(time,ftime);
+            const BBox3fa bounds = merge(m->bounds(primID,itime+0),m->bounds(primID,itime+1));
+            prims[i] = PrimRef(bounds,geomID,primID);
+            pinfo.add(bounds,bounds.center2());
+          }
+          return pinfo;
+        }, [] (const PrimInfo& a, const PrimInfo& b) { return PrimInfo::merge(a,b); });
+      }
+
+      /*! joins the BVHs of consecutive time intervals into a tree of nodes that store the time range of each child */
+      NodeRef createTimeSplitTree(const NodeRef* roots, const BBox3fa* bounds, const BBox1f* times, const size_t num, BBox3fa& bounds_o)
+      {
+        if (num == 1) {
+          bounds_o = bounds[0];
+          return roots[0];
+        }
+
+        NodeMB* node = (NodeMB*) bvh->alloc.threadLocal2()->alloc0.malloc(sizeof(NodeMB),BVH::byteNodeAlignment); node->clear();
+        const size_t numChildren = min(num,size_t(N));
+        bounds_o = empty;
+        for (size_t i=0; i<numChildren; i++)
+        {
+          const size_t begin = (i+0)*num/numChildren;
+          const size_t end   = (i+1)*num/numChildren;
+          BBox3fa cbounds;
+          node->set(i,createTimeSplitTree(roots+begin,bounds+begin,times+begin,end-begin,cbounds));
+          node->set(i,cbounds,cbounds);
+          node->setTimeRange(i,BBox1f(times[begin].lower,times[end-1].upper));
+          bounds_o.extend(cbounds);
+        }
+        return bvh->encodeNode(node);
+      }
     };
 
 #if defined(RTCORE_GEOMETRY_LINES)
@@ -510,6 +608,7 @@ namespace embree
     Builder* BVH4Triangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4Triangle4vSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4Triangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH4Triangle4qSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4q>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
 
     Builder* BVH4Triangle4vMBMeshBuilderSAH  (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderMblurSAH<4,TriangleMesh,Triangle4vMB>((BVH4*)bvh,mesh ,4,1.0f,4,inf); }
     Builder* BVH4Triangle4vMBSceneBuilderSAH (void* bvh, Scene* scene,       size_t mode) { return new BVHNBuilderMblurSAH<4,TriangleMesh,Triangle4vMB>((BVH4*)bvh,scene,4,1.0f,4,inf); }
@@ -537,12 +636,15 @@ namespace embree
     Builder* BVH4Quad4iMBMeshBuilderSAH  (void* bvh, QuadMesh* mesh, size_t mode) { return new BVHNBuilderMblurSAH<4,QuadMesh,Quad4iMB>((BVH4*)bvh,mesh ,4,1.0f,4,inf); }
     Builder* BVH4QuantizedQuad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4QuantizedQuad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+
+    Builder* BVH4Quad4vSceneBuilderSpatialSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSpatialSAH<4,QuadMesh,Quad4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
 #if defined(__AVX__)
     Builder* BVH8Quad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,QuadMesh,Quad4v>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8Quad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,QuadMesh,Quad4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8Quad4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMblurSAH<8,QuadMesh,Quad4iMB>((BVH8*)bvh,scene,4,1.0f,4,inf); }
     Builder* BVH8QuantizedQuad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,QuadMesh,Quad4v>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8QuantizedQuad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,QuadMesh,Quad4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH8Quad4vSceneBuilderSpatialSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSpatialSAH<8,QuadMesh,Quad4v>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
 #endif
 #endif
 
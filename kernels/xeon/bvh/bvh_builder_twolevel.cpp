@@ -31,7 +31,7 @@ namespace embree
   {
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::BVHNBuilderTwoLevel (BVH* bvh, Scene* scene, const createMeshAccelTy createMeshAccel)
-      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device), prims(scene->device) {}
+      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device), prims(scene->device), topRoot(-1), topLevelSAH(0.0f) {}
     
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::~BVHNBuilderTwoLevel ()
@@ -46,6 +46,7 @@ namespace embree
       /* delete some objects */
       size_t num = scene->size();
       if (num < objects.size()) {
+        topRoot = -1;
         parallel_for(num, objects.size(), [&] (const range<size_t>& r) {
             for (size_t i=r.begin(); i<r.end(); i++) {
               delete builders[i]; builders[i] = nullptr;
@@ -53,14 +54,13 @@ namespace embree
             }
           });
       }
-
-      /* reset memory allocator */
-      bvh->alloc.reset();
       
       /* skip build for empty scene */
       const size_t numPrimitives = scene->getNumPrimitives<Mesh,1>();
       if (numPrimitives == 0) {
+        bvh->alloc.reset();
         prims.resize(0);
+        topRoot = -1;
         bvh->set(BVH::emptyNode,empty,0);
         return;
       }
@@ -108,7 +108,6 @@ namespace embree
           if (mesh == nullptr || !mesh->isEnabled() || mesh->numTimeSteps != 1) 
             continue;
         
-          BVH*     object  = objects [objectID]; assert(object);
           Builder* builder = builders[objectID]; assert(builder);
           
           /* build object if it got modified */
@@ -116,10 +115,32 @@ namespace embree
           if (mesh->isModified()) 
 #endif
             builder->build(0,0);
-          
-          /* create build primitive */
-          if (!object->bounds.empty())
-            refs[nextRef++] = BVHNBuilderTwoLevel::BuildRef(object->bounds,object->root);
+        }
+      });
+
+      /* try to update the top level if only few objects got modified */
+#if !PROFILE 
+      if (update(numPrimitives)) {
+        bvh->postBuild(t0);
+        return;
+      }
+#endif
+      topRoot = -1;
+
+      /* reset memory allocator */
+      bvh->alloc.reset();
+
+      /* create build primitives */
+      inTopLevel.resize(num);
+      parallel_for(size_t(0), num, [&] (const range<size_t>& r)
+      {
+        for (size_t objectID=r.begin(); objectID<r.end(); objectID++)
+        {
+          Mesh* mesh = scene->getSafe<Mesh>(objectID);
+          BVH* object = objects[objectID];
+          inTopLevel[objectID] = mesh && mesh->isEnabled() && mesh->numTimeSteps == 1 && !object->bounds.empty();
+          if (inTopLevel[objectID])
+            refs[nextRef++] = BVHNBuilderTwoLevel::BuildRef(object->bounds,object->root,(unsigned)objectID);
         }
       });
       
@@ -146,7 +167,7 @@ namespace embree
         PrimInfo pinfo(empty);
         for (size_t i=r.begin(); i<r.end(); i++) {
           pinfo.add(refs[i].bounds());
-          prims[i] = PrimRef(refs[i].bounds(),(size_t)refs[i].node);
+          prims[i] = PrimRef(refs[i].bounds(),i);
         }
         return pinfo;
       }, [] (const PrimInfo& a, const PrimInfo& b) { return PrimInfo::merge(a,b); });
@@ -158,10 +179,15 @@ namespace embree
       /* otherwise build toplevel hierarchy */
       else
       {
+        /* each node has at least 2 children, thus there are less nodes than references */
+        topNodes.resize(refs.size());
+        nextTopNode.store(0);
+
         NodeRef root;
-        BVHBuilderBinnedSAH::build<NodeRef>
+        const int rootID = BVHBuilderBinnedSAH::build_reduce<NodeRef>
           (root,
            [&] { return bvh->alloc.threadLocal2(); },
+           int(-1),
            [&] (const isa::BVHBuilderBinnedSAH::BuildRecord& current, BVHBuilderBinnedSAH::BuildRecord* children, const size_t n, FastAllocator::ThreadLocal2* alloc) -> int
            {
              Node* node = (Node*) alloc->alloc0.malloc(sizeof(Node)); node->clear();
@@ -170,18 +196,34 @@ namespace embree
                children[i].parent = (size_t*)&node->child(i);
              }
              *current.parent = bvh->encodeNode(node);
-             return 0;
+             const int nodeID = nextTopNode++;
+             topNodes[nodeID].node = node;
+             topNodes[nodeID].numChildren = n;
+             return nodeID;
+           },
+           [&] (int nodeID, int* children, const size_t n) -> int
+           {
+             for (size_t i=0; i<n; i++)
+               topNodes[nodeID].children[i] = children[i];
+             return nodeID;
            },
            [&] (const BVHBuilderBinnedSAH::BuildRecord& current, FastAllocator::ThreadLocal2* alloc) -> int
            {
              assert(current.prims.size() == 1);
-             *current.parent = (NodeRef) prims[current.prims.begin()].ID();
-             return 1;
+             const size_t refID = prims[current.prims.begin()].ID();
+             *current.parent = refs[refID].node;
+             return ~int(refID);
            },
            [&] (size_t dn) { bvh->scene->progressMonitor(0); },
            prims.data(),pinfo,N,BVH::maxBuildDepthLeaf,N,1,1,1.0f,1.0f);
         
         bvh->set(root,pinfo.geomBounds,numPrimitives);
+
+        /* remember SAH cost of the top level to decide when updates have to get replaced by a rebuild */
+        topRoot = rootID;
+        BBox3fa bounds = empty;
+        objectState.assign(num,OBJECT_UNMODIFIED);
+        topLevelSAH = update(topRoot,bounds)/max(halfArea(bounds),float(min_rcp_input));
       }
 
 #if PROFILE
@@ -192,9 +234,88 @@ namespace embree
       bvh->postBuild(t0);
     }
 
+    template<int N, typename Mesh>
+    bool BVHNBuilderTwoLevel<N,Mesh>::update(size_t numPrimitives)
+    {
+      const float sahFactor = scene->device->toplevel_update_sah_factor;
+      if (topRoot < 0 || sahFactor <= 0.0f)
+        return false;
+
+      /* geometries got added, enabled, disabled or got empty, thus rebuild top level */
+      const size_t num = scene->size();
+      if (inTopLevel.size() != num) 
+        return false;
+
+      objectState.resize(num);
+      for (size_t objectID=0; objectID<num; objectID++)
+      {
+        Mesh* mesh = scene->getSafe<Mesh>(objectID);
+        const bool valid = mesh && mesh->isEnabled() && mesh->numTimeSteps == 1 && !objects[objectID]->bounds.empty();
+        if (valid != inTopLevel[objectID]) 
+          return false;
+        objectState[objectID] = valid && mesh->isModified() ? OBJECT_MODIFIED : OBJECT_UNMODIFIED;
+      }
+
+      /* reinsert modified objects and refit, rebuild if SAH cost got too high */
+      BBox3fa bounds = empty;
+      const float sah = update(topRoot,bounds)/max(halfArea(bounds),float(min_rcp_input));
+      if (sah > sahFactor*topLevelSAH) 
+        return false;
+
+      bvh->set(bvh->encodeNode(topNodes[topRoot].node),bounds,numPrimitives);
+      return true;
+    }
+
+    template<int N, typename Mesh>
+    float BVHNBuilderTwoLevel<N,Mesh>::update(int nodeID, BBox3fa& bounds_o)
+    {
+      TopLevelNode& top = topNodes[nodeID];
+      Node* node = top.node;
+      float sah = 0.0f;
+      
+      for (size_t i=0; i<top.numChildren; i++)
+      {
+        const int child = top.children[i];
+        if (child >= 0) 
+        {
+          BBox3fa bounds = empty;
+          sah += update(child,bounds);
+          if (topNodes[child].numChildren) node->set(i,bounds);
+          else node->set(i,BBox3fa(empty),BVH::emptyNode);
+          continue;
+        }
+        
+        /* modified objects get reinserted at their first reference, all other references get removed */
+        const unsigned objectID = refs[~child].objectID;
+        if (objectState[objectID] == OBJECT_UNMODIFIED) 
+          continue;
+
+        if (objectState[objectID] == OBJECT_MODIFIED) {
+          node->set(i,objects[objectID]->bounds,objects[objectID]->root);
+          objectState[objectID] = OBJECT_REINSERTED;
+        }
+        else
+          node->set(i,BBox3fa(empty),BVH::emptyNode);
+      }
+
+      /* move removed children to the end as traversal stops at the first empty child */
+      size_t numChildren = 0;
+      for (size_t i=0; i<top.numChildren; i++) 
+      {
+        if (node->child(i) == BVH::emptyNode) continue;
+        node->swap(numChildren,i);
+        std::swap(top.children[numChildren],top.children[i]);
+        bounds_o.extend(node->bounds(numChildren));
+        numChildren++;
+      }
+      top.numChildren = numChildren;
+      return numChildren ? sah + halfArea(bounds_o) : sah;
+    }
+
     template<int N, typename Mesh>
     void BVHNBuilderTwoLevel<N,Mesh>::deleteGeometry(size_t geomID)
     {
+      topRoot = -1;
       if (geomID >= objects.size()) return;
       delete builders[geomID]; builders[geomID] = nullptr;
       delete objects [geomID]; objects [geomID] = nullptr;
@@ -210,6 +331,7 @@ namespace embree
 	if (builders[i]) builders[i]->clear();
 
       refs.clear();
+      topRoot = -1;
     }
 
     template<int N, typename Mesh>
@@ -236,12 +358,13 @@ namespace embree
         std::pop_heap (refs.begin(),refs.end()); 
         NodeRef ref = refs.back().node;
         if (ref.isLeaf()) break;
+        const unsigned objectID = refs.back().objectID;
         refs.pop_back();    
         
         Node* node = ref.node();
         for (size_t i=0; i<N; i++) {
           if (node->child(i) == BVH::emptyNode) continue;
-          refs.push_back(BuildRef(node->bounds(i),node->child(i)));
+          refs.push_back(BuildRef(node->bounds(i),node->child(i),objectID));
          
 #if 1
           NodeRef ref_pre = node->child(i);
@@ -40,8 +40,8 @@ namespace embree
       public:
         __forceinline BuildRef () {}
 
-        __forceinline BuildRef (const BBox3fa& bounds, NodeRef node)
-          : lower(bounds.lower), upper(bounds.upper), node(node)
+        __forceinline BuildRef (const BBox3fa& bounds, NodeRef node, unsigned objectID)
+          : lower(bounds.lower), upper(bounds.upper), node(node), objectID(objectID)
         {
           if (node.isLeaf())
             lower.w = 0.0f;
@@ -61,6 +61,18 @@ namespace embree
         Vec3fa lower;
         Vec3fa upper;
         NodeRef node;
+        unsigned objectID;
+      };
+
+      /*! state of objects during top level update */
+      enum { OBJECT_UNMODIFIED = 0, OBJECT_MODIFIED = 1, OBJECT_REINSERTED = 2 };
+
+      /*! node of the top level hierarchy, references child nodes by index and leaves by ~index into refs */
+      struct TopLevelNode
+      {
+        Node* node;
+        int children[N];
+        size_t numChildren;
       };
       
       /*! Constructor. */
@@ -75,6 +87,10 @@ namespace embree
       void clear();
 
       void open_sequential(size_t numPrimitives);
+
+      /*! updates the top level hierarchy after some objects got rebuild, returns false if it has to get rebuild */
+      bool update(size_t numPrimitives);
+      float update(int nodeID, BBox3fa& bounds_o);
       
     public:
       BVH* bvh;
@@ -88,6 +104,14 @@ namespace embree
       mvector<BuildRef> refs;
       mvector<PrimRef> prims;
       std::atomic<int> nextRef;
+
+    public:
+      std::vector<TopLevelNode> topNodes;  //!< top level nodes of last rebuild
+      std::atomic<int> nextTopNode;
+      int topRoot;                         //!< index of root in topNodes, -1 if top level cannot get updated
+      std::vector<char> inTopLevel;        //!< true for objects referenced by the top level
+      std::vector<char> objectState;       //!< per object state during update
+      float topLevelSAH;                   //!< SAH cost of the top level after last rebuild
     };
   }
 }
@@ -24,6 +24,7 @@
 #include "../geometry/trianglei.h"
 #include "../geometry/intersector_iterators.h"
 #include "../geometry/bezier1v_intersector.h"
+#include "../geometry/bezierv_intersector.h"
 #include "../geometry/bezier1i_intersector.h"
 #include "../geometry/linei_intersector.h"
 #include "../geometry/triangle_intersector_moeller.h"
@@ -77,6 +78,9 @@ namespace embree
       /*! initialize the node traverser */
       BVHNNodeTraverser1<N,Nx,types> nodeTraverser(vray);
 
+      /*! traversal statistics, accumulated locally and counted once per ray */
+      size_t numNodes = 0, numLeaves = 0;
+
       /* pop loop */
       while (true) pop:
       {
@@ -98,6 +102,7 @@ namespace embree
           /*! stop if we found a leaf node */
           if (unlikely(cur.isLeaf())) break;
           STAT3(normal.trav_nodes,1,1,1);
+          numNodes++;
 
           /* intersect node */
           bool nodeIntersected = BVHNNodeIntersector1<N,Nx,types,robust>::intersect(cur,vray,ray_near,ray_far,ray.time,tNear,mask);
@@ -118,6 +123,7 @@ namespace embree
         /*! this is a leaf node */
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves,1,1,1);
+        numLeaves++;
         size_t num; Primitive* prim = (Primitive*) cur.leaf(num);
         size_t lazy_node = 0;
         PrimitiveIntersector1::intersect(pre,ray,context,leafType,prim,num,bvh->scene,geomID_to_instID,lazy_node);
@@ -139,6 +145,10 @@ namespace embree
         }
         stackPtr = left;*/
       }
+      bvh->scene->stat.add(ShardedStat::NODES_VISITED,numNodes);
+      bvh->scene->stat.add(ShardedStat::LEAVES_VISITED,numLeaves);
+      bvh->device->stat.add(ShardedStat::NODES_VISITED,numNodes);
+      bvh->device->stat.add(ShardedStat::LEAVES_VISITED,numLeaves);
       AVX_ZERO_UPPER();
     }
     
@@ -178,6 +188,9 @@ namespace embree
       /*! initialize the node traverser */
       BVHNNodeTraverser1<N,Nx,types> nodeTraverser(vray);
 
+      /*! traversal statistics, accumulated locally and counted once per ray */
+      size_t numNodes = 0, numLeaves = 0;
+
       /* pop loop */
       while (true) pop:
       {
@@ -195,6 +208,7 @@ namespace embree
           /*! stop if we found a leaf node */
           if (unlikely(cur.isLeaf())) break;
           STAT3(shadow.trav_nodes,1,1,1);
+          numNodes++;
 
           /* intersect node */
           bool nodeIntersected = BVHNNodeIntersector1<N,Nx,types,robust>::intersect(cur,vray,ray_near,ray_far,ray.time,tNear,mask);
@@ -215,6 +229,7 @@ namespace embree
         /*! this is a leaf node */
         assert(cur != BVH::emptyNode);
         STAT3(shadow.trav_leaves,1,1,1);
+        numLeaves++;
         size_t num; Primitive* prim = (Primitive*) cur.leaf(num);
         size_t lazy_node = 0;
         if (PrimitiveIntersector1::occluded(pre,ray,context,leafType,prim,num,bvh->scene,geomID_to_instID,lazy_node)) {
@@ -228,6 +243,10 @@ namespace embree
           stackPtr++;
         }
       }
+      bvh->scene->stat.add(ShardedStat::NODES_VISITED,numNodes);
+      bvh->scene->stat.add(ShardedStat::LEAVES_VISITED,numLeaves);
+      bvh->device->stat.add(ShardedStat::NODES_VISITED,numNodes);
+      bvh->device->stat.add(ShardedStat::LEAVES_VISITED,numLeaves);
       AVX_ZERO_UPPER();
     }
 
@@ -241,7 +260,9 @@ namespace embree
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1vIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<Bezier1vIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1iIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1vIntersector1_OBB,BVHNIntersector1<4 COMMA BVH_AN1_UN1 COMMA false COMMA ArrayIntersector1<Bezier1vIntersector1> >));
+    IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier4vIntersector1_OBB,BVHNIntersector1<4 COMMA BVH_AN1_UN1 COMMA false COMMA ArrayIntersector1<BezierMvIntersector1<4> > >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1iIntersector1_OBB,BVHNIntersector1<4 COMMA BVH_AN1_UN1 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1> >));
+    IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(QBVH4Bezier1iIntersector1_OBB,BVHNIntersector1<4 COMMA BVH_AN1_QUN1 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1iMBIntersector1_OBB,BVHNIntersector1<4 COMMA BVH_AN2_UN2 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1MB> >));
   
 #if 1
@@ -257,6 +278,7 @@ namespace embree
     IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4vIntersector1Pluecker,BVHNIntersector1<4 COMMA BVH_AN1 COMMA true COMMA ArrayIntersector1<TriangleMvIntersector1Pluecker<4 COMMA 4 COMMA true> > >));
     IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4iIntersector1Pluecker,BVHNIntersector1<4 COMMA BVH_AN1 COMMA true COMMA ArrayIntersector1<Triangle4iIntersector1Pluecker<4 COMMA 4 COMMA true> > >));
     IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4vMBIntersector1Moeller,BVHNIntersector1<4 COMMA BVH_AN2 COMMA false COMMA ArrayIntersector1<TriangleMvMBIntersector1MoellerTrumbore<4 COMMA 4 COMMA true> > >));
+    IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4qIntersector1Moeller,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<TriangleMqIntersector1MoellerTrumbore<4 COMMA true> > >));
 
     IF_ENABLED_SUBDIV(DEFINE_INTERSECTOR1(BVH4Subdivpatch1CachedIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA true COMMA SubdivPatch1CachedIntersector1>));
     IF_ENABLED_SUBDIV(DEFINE_INTERSECTOR1(BVH4GridAOSIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA true COMMA GridAOSIntersector1>));
@@ -287,7 +309,9 @@ namespace embree
     IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(QBVH8Quad4iIntersector1Pluecker,BVHNIntersector1<8 COMMA BVH_QN1 COMMA false COMMA ArrayIntersector1<QuadMiIntersector1Pluecker<4 COMMA true> > >));
 
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH8Bezier1vIntersector1_OBB,BVHNIntersector1<8 COMMA BVH_AN1_UN1 COMMA false COMMA ArrayIntersector1<Bezier1vIntersector1> >));
+    IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH8Bezier4vIntersector1_OBB,BVHNIntersector1<8 COMMA BVH_AN1_UN1 COMMA false COMMA ArrayIntersector1<BezierMvIntersector1<4> > >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH8Bezier1iIntersector1_OBB,BVHNIntersector1<8 COMMA BVH_AN1_UN1 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1> >));
+    IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(QBVH8Bezier1iIntersector1_OBB,BVHNIntersector1<8 COMMA BVH_AN1_QUN1 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH8Bezier1iMBIntersector1_OBB,BVHNIntersector1<8 COMMA BVH_AN2_UN2 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1MB> >));
     IF_ENABLED_LINES(DEFINE_INTERSECTOR1(BVH8Line4iIntersector1,BVHNIntersector1<8 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<LineMiIntersector1<4 COMMA 4 COMMA true> > >));
     IF_ENABLED_LINES(DEFINE_INTERSECTOR1(BVH8Line4iMBIntersector1,BVHNIntersector1<8 COMMA BVH_AN2 COMMA false COMMA ArrayIntersector1<LineMiMBIntersector1<4 COMMA 4 COMMA true> > >));
@@ -507,7 +507,8 @@ namespace embree
       const vfloat<N> tFarY = (vfloat<N>(pFarY[0]) + time*pFarY[6] - ray.org.y) * ray.rdir.y;
       const vfloat<N> tFarZ = (vfloat<N>(pFarZ[0]) + time*pFarZ[6] - ray.org.z) * ray.rdir.z;
       const vfloat<N> tFar = min(tfar,tFarX,tFarY,tFarZ);
-      const size_t mask = movemask(tNear <= tFar);
+      const vbool<N> vmask = (tNear <= tFar) & (node->lower_t <= vfloat<N>(time)) & (vfloat<N>(time) <= node->upper_t);
+      const size_t mask = movemask(vmask);
       dist = tNear;
       return mask;
     }
@@ -542,7 +543,7 @@ namespace embree
 
       const vfloat<K> lnearP = maxi(maxi(mini(lclipMinX, lclipMaxX), mini(lclipMinY, lclipMaxY)), mini(lclipMinZ, lclipMaxZ));
       const vfloat<K> lfarP  = mini(mini(maxi(lclipMinX, lclipMaxX), maxi(lclipMinY, lclipMaxY)), maxi(lclipMinZ, lclipMaxZ));
-      const vbool<K> lhit   = maxi(lnearP,tnear) <= mini(lfarP,tfar);
+      const vbool<K> lhit   = (maxi(lnearP,tnear) <= mini(lfarP,tfar)) & (vfloat<K>(node->lower_t[i]) <= time) & (time <= vfloat<K>(node->upper_t[i]));
       dist = lnearP;
       return lhit;
     }
@@ -604,6 +605,38 @@ namespace embree
       return movemask(vmask);
     }
 
+    /*! intersect N quantized OBBs that share a single space with single ray */
+    template<int N>
+      __forceinline size_t intersectNode(const typename BVHN<N>::QuantizedUnalignedNode* node, const TravRay<N,N>& ray, const vfloat<N>& tnear, const vfloat<N>& tfar, vfloat<N>& dist)
+    {
+      /* transform ray only once into the space of all children */
+      const LinearSpace3f& xfm = node->space;
+      const Vec3<vfloat<N>> org(madd(ray.org.x,vfloat<N>(xfm.vx.x),madd(ray.org.y,vfloat<N>(xfm.vy.x),ray.org.z*vfloat<N>(xfm.vz.x))),
+                                madd(ray.org.x,vfloat<N>(xfm.vx.y),madd(ray.org.y,vfloat<N>(xfm.vy.y),ray.org.z*vfloat<N>(xfm.vz.y))),
+                                madd(ray.org.x,vfloat<N>(xfm.vx.z),madd(ray.org.y,vfloat<N>(xfm.vy.z),ray.org.z*vfloat<N>(xfm.vz.z))));
+      const Vec3<vfloat<N>> dir(madd(ray.dir.x,vfloat<N>(xfm.vx.x),madd(ray.dir.y,vfloat<N>(xfm.vy.x),ray.dir.z*vfloat<N>(xfm.vz.x))),
+                                madd(ray.dir.x,vfloat<N>(xfm.vx.y),madd(ray.dir.y,vfloat<N>(xfm.vy.y),ray.dir.z*vfloat<N>(xfm.vz.y))),
+                                madd(ray.dir.x,vfloat<N>(xfm.vx.z),madd(ray.dir.y,vfloat<N>(xfm.vy.z),ray.dir.z*vfloat<N>(xfm.vz.z))));
+      const Vec3<vfloat<N>> rdir = rcp_safe(dir);
+
+      /* select near and far planes by ray direction, thus empty children with lower > upper never get hit */
+      const vfloat<N> lower_x = node->dequantizeLowerX(), upper_x = node->dequantizeUpperX();
+      const vfloat<N> lower_y = node->dequantizeLowerY(), upper_y = node->dequantizeUpperY();
+      const vfloat<N> lower_z = node->dequantizeLowerZ(), upper_z = node->dequantizeUpperZ();
+      const vbool<N> posX = rdir.x >= 0.0f, posY = rdir.y >= 0.0f, posZ = rdir.z >= 0.0f;
+      const vfloat<N> tNearX = (select(posX,lower_x,upper_x) - org.x) * rdir.x;
+      const vfloat<N> tNearY = (select(posY,lower_y,upper_y) - org.y) * rdir.y;
+      const vfloat<N> tNearZ = (select(posZ,lower_z,upper_z) - org.z) * rdir.z;
+      const vfloat<N> tFarX  = (select(posX,upper_x,lower_x) - org.x) * rdir.x;
+      const vfloat<N> tFarY  = (select(posY,upper_y,lower_y) - org.y) * rdir.y;
+      const vfloat<N> tFarZ  = (select(posZ,upper_z,lower_z) - org.z) * rdir.z;
+      const vfloat<N> tNear  = max(tnear, tNearX,tNearY,tNearZ);
+      const vfloat<N> tFar   = min(tfar,  tFarX ,tFarY ,tFarZ );
+      const vbool<N> vmask = tNear <= tFar;
+      dist = tNear;
+      return movemask(vmask);
+    }
+
     /*! Intersects N nodes with 1 ray */
     template<int N, int Nx, int types, bool robust>
     struct BVHNNodeIntersector1;
@@ -649,6 +682,17 @@ namespace embree
       }
     };
 
+    template<int N, int Nx>
+      struct BVHNNodeIntersector1<N,Nx,BVH_AN1_QUN1,false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,Nx>& ray, const vfloat<N>& tnear, const vfloat<N>& tfar, const float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (likely(node.isNode()))                          mask = intersectNode<N,N>(node.node(),ray,tnear,tfar,dist);
+        else if (unlikely(node.isQuantizedUnalignedNode())) mask = intersectNode<N>(node.quantizedUnalignedNode(),ray,tnear,tfar,dist);
+        return true;
+      }
+    };
+
     template<int N, int Nx>
       struct BVHNNodeIntersector1<N,Nx,BVH_AN2_UN2,false>
     {
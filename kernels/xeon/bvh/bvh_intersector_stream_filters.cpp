@@ -23,9 +23,93 @@ namespace embree
     static const size_t MAX_RAYS_PER_OCTANT = 8*sizeof(size_t);
     static_assert(MAX_RAYS_PER_OCTANT <= MAX_INTERNAL_STREAM_SIZE,"maximal internal stream size exceeded");
 
+    /*! number of rays that get reordered together in sort mode */
+    static const size_t MAX_SORTED_RAYS = 1024;
+
+    /*! Sort key of a ray for the sort mode of streams. The direction
+     *  octant forms the most significant bits, followed by the morton
+     *  code of the cell of the ray origin inside the scene bounds. */
+    struct RaySortKey
+    {
+      __forceinline RaySortKey (const BBox3fa& bounds) 
+        : lower(bounds.lower), scale(255.0f*rcp(max(bounds.size(),Vec3fa(1E-18f)))) {}
+
+      __forceinline unsigned int operator() (const Vec3fa& org, const Vec3fa& dir) const
+      {
+        const unsigned int octant = movemask(vfloat4(dir) < 0.0f) & 0x7;
+        const Vec3fa p = (org-lower)*scale;
+        const unsigned int x = (unsigned int) clamp(p.x,0.0f,255.0f);
+        const unsigned int y = (unsigned int) clamp(p.y,0.0f,255.0f);
+        const unsigned int z = (unsigned int) clamp(p.z,0.0f,255.0f);
+        return (octant << 24) | bitInterleave(x,y,z);
+      }
+
+      Vec3fa lower, scale;
+    };
+
+    /*! sorts items of the form (key << 32 | rayID) and invokes the trace
+     *  function for groups of rays of the same octant */
+    template<typename TraceFunc>
+    __forceinline void traceSorted(uint64_t* items, const size_t numItems, const TraceFunc& trace)
+    {
+      std::sort(items,items+numItems);
+
+      size_t rayIDs[MAX_RAYS_PER_OCTANT];
+      for (size_t i=0; i<numItems;)
+      {
+        const uint64_t octant = items[i] >> 56;
+        size_t numRays = 0;
+        while (i<numItems && numRays<MAX_RAYS_PER_OCTANT && (items[i] >> 56) == octant)
+          rayIDs[numRays++] = items[i++] & 0xFFFFFFFF;
+        trace(rayIDs,numRays);
+      }
+    }
+
     __forceinline void RayStream::filterAOS(Scene *scene, RTCRay* _rayN, const size_t N, const size_t stride, const RTCIntersectContext* context, const bool intersect)
     {
       Ray* __restrict__ rayN = (Ray*)_rayN;
+
+      /* reorder rays by octant and origin for coherence, hits are written back in place */
+      if (unlikely(isSortStream(context->flags)))
+      {
+        const RaySortKey sortKey(scene->bounds);
+        uint64_t items[MAX_SORTED_RAYS];
+        for (size_t s=0; s<N; s+=MAX_SORTED_RAYS)
+        {
+          const size_t numRays = min(N-s,MAX_SORTED_RAYS);
+          size_t numItems = 0;
+          for (size_t i=0; i<numRays; i++)
+          {
+            Ray &ray = *(Ray*)((char*)rayN + (s+i) * stride);
+            if (unlikely(ray.tnear > ray.tfar)) continue;
+            if (unlikely(!intersect && ray.geomID == 0)) continue; // ignore already occluded rays
+#if defined(RTCORE_IGNORE_INVALID_RAYS)
+            if (unlikely(!ray.valid())) continue;
+#endif
+            items[numItems++] = (uint64_t(sortKey(ray.org,ray.dir)) << 32) | i;
+          }
+
+          traceSorted(items,numItems,[&] (const size_t* rayIDs, const size_t numSortedRays) 
+          {
+            Ray* rays[MAX_RAYS_PER_OCTANT];
+            for (size_t j=0; j<numSortedRays; j++)
+              rays[j] = (Ray*)((char*)rayN + (s+rayIDs[j]) * stride);
+
+            if (numSortedRays == 1)
+            {
+              if (intersect) scene->intersect((RTCRay&)*rays[0],context);
+              else           scene->occluded ((RTCRay&)*rays[0],context);
+            }
+            else
+            {
+              if (intersect) scene->intersectN((RTCRay**)rays,numSortedRays,context);
+              else           scene->occludedN((RTCRay**)rays,numSortedRays,context);
+            }
+          });
+        }
+        return;
+      }
+
       __aligned(64) Ray* octants[8][MAX_RAYS_PER_OCTANT];
       unsigned int rays_in_octant[8];
 
@@ -121,6 +205,51 @@ namespace embree
       /* otherwise use stream intersector */
       __aligned(64) Ray rays[MAX_RAYS_PER_OCTANT];
       __aligned(64) Ray *rays_ptr[MAX_RAYS_PER_OCTANT];
+
+      /* reorder rays by octant and origin for coherence */
+      if (unlikely(isSortStream(context->flags)))
+      {
+        const RaySortKey sortKey(scene->bounds);
+        uint64_t items[MAX_SORTED_RAYS];
+        const size_t numTotalRays = streams*N;
+        for (size_t s=0; s<numTotalRays; s+=MAX_SORTED_RAYS)
+        {
+          const size_t numRays = min(numTotalRays-s,MAX_SORTED_RAYS);
+          size_t numItems = 0;
+          for (size_t i=0; i<numRays; i++)
+          {
+            const size_t offset = ((s+i)/N)*stream_offset + sizeof(float)*((s+i)%N);
+            if (unlikely(!rayN.isValid(offset))) continue;
+            __aligned(64) Ray ray = rayN.gather(offset);
+#if defined(RTCORE_IGNORE_INVALID_RAYS)
+            if (unlikely(!ray.valid())) continue; 
+#endif
+            items[numItems++] = (uint64_t(sortKey(ray.org,ray.dir)) << 32) | i;
+          }
+
+          traceSorted(items,numItems,[&] (const size_t* rayIDs, const size_t numSortedRays) 
+          {
+            for (size_t j=0; j<numSortedRays; j++)
+            {
+              const size_t offset = ((s+rayIDs[j])/N)*stream_offset + sizeof(float)*((s+rayIDs[j])%N);
+              rays_ptr[j] = &rays[j]; // rays_ptr might get reordered for occludedN
+              rays[j] = rayN.gather(offset);
+            }
+
+            if (intersect)
+              scene->intersectN((RTCRay**)rays_ptr,numSortedRays,context);
+            else
+              scene->occludedN((RTCRay**)rays_ptr,numSortedRays,context);
+
+            for (size_t j=0; j<numSortedRays; j++) 
+            {
+              const size_t offset = ((s+rayIDs[j])/N)*stream_offset + sizeof(float)*((s+rayIDs[j])%N);
+              rayN.scatter(offset,rays[j],intersect);
+            }
+          });
+        }
+        return;
+      }
       
       size_t octants[8][MAX_RAYS_PER_OCTANT];
       unsigned int rays_in_octant[8];
@@ -220,6 +349,46 @@ namespace embree
       __aligned(64) Ray rays[MAX_RAYS_PER_OCTANT];
       __aligned(64) Ray *rays_ptr[MAX_RAYS_PER_OCTANT];
 
+      /* reorder rays by octant and origin for coherence */
+      if (unlikely(isSortStream(context->flags)))
+      {
+        const RaySortKey sortKey(scene->bounds);
+        uint64_t items[MAX_SORTED_RAYS];
+        for (size_t s=0; s<N; s+=MAX_SORTED_RAYS)
+        {
+          const size_t numRays = min(N-s,MAX_SORTED_RAYS);
+          size_t numItems = 0;
+          for (size_t i=0; i<numRays; i++)
+          {
+            const size_t offset = sizeof(float)*(s+i);
+            if (unlikely(!rayN.isValidByOffset(offset))) continue;
+            __aligned(64) Ray ray = rayN.gatherByOffset(offset);
+#if defined(RTCORE_IGNORE_INVALID_RAYS)
+            if (unlikely(!ray.valid())) continue; 
+#endif
+            items[numItems++] = (uint64_t(sortKey(ray.org,ray.dir)) << 32) | i;
+          }
+
+          traceSorted(items,numItems,[&] (const size_t* rayIDs, const size_t numSortedRays) 
+          {
+            for (size_t j=0; j<numSortedRays; j++)
+            {
+              rays_ptr[j] = &rays[j]; // rays_ptr might get reordered for occludedN
+              rays[j] = rayN.gatherByOffset(sizeof(float)*(s+rayIDs[j]));
+            }
+
+            if (intersect)
+              scene->intersectN((RTCRay**)rays_ptr,numSortedRays,context);
+            else
+              scene->occludedN((RTCRay**)rays_ptr,numSortedRays,context);
+
+            for (size_t j=0; j<numSortedRays; j++) 
+              rayN.scatterByOffset(sizeof(float)*(s+rayIDs[j]),rays[j],intersect);
+          });
+        }
+        return;
+      }
+
       size_t octants[8][MAX_RAYS_PER_OCTANT];
       unsigned int rays_in_octant[8];
 
@@ -29,11 +29,11 @@ namespace embree
   {
     numAlignedNodes = numUnalignedNodes = 0;
     numAlignedNodesMB = numUnalignedNodesMB = 0;
-    numTransformNodes = numQuantizedNodes = 0;
+    numTransformNodes = numQuantizedNodes = numQuantizedUnalignedNodes = 0;
     numLeaves = numPrims = numPrimBlocks = depth = 0;
     childrenAlignedNodes = childrenUnalignedNodes = 0;
     childrenAlignedNodesMB = childrenUnalignedNodesMB = 0;
-    childrenQuantizedNodes = 0;
+    childrenQuantizedNodes = childrenQuantizedUnalignedNodes = 0;
     bvhSAH = 0.0f; leafSAH = 0.0f;
     float A = max(0.0f,halfArea(bvh->bounds));
     statistics(bvh->root,A,depth);
@@ -51,10 +51,16 @@ namespace embree
     size_t bytesUnalignedNodesMB = numUnalignedNodesMB*sizeof(UnalignedNodeMB);
     size_t bytesTransformNodes = numTransformNodes*sizeof(TransformNode);
     size_t bytesQuantizedNodes = numQuantizedNodes*sizeof(QuantizedNode);
+    size_t bytesQuantizedUnalignedNodes = numQuantizedUnalignedNodes*sizeof(QuantizedUnalignedNode);
     size_t bytesPrims  = numPrimBlocks*bvh->primTy.bytes;
     size_t numVertices = bvh->numVertices;
     size_t bytesVertices = numVertices*sizeof(Vec3fa); 
-    return bytesAlignedNodes+bytesUnalignedNodes+bytesAlignedNodesMB+bytesUnalignedNodesMB+bytesTransformNodes+bytesQuantizedNodes+bytesPrims+bytesVertices;
+    return bytesAlignedNodes+bytesUnalignedNodes+bytesAlignedNodesMB+bytesUnalignedNodesMB+bytesTransformNodes+bytesQuantizedNodes+bytesQuantizedUnalignedNodes+bytesPrims+bytesVertices;
+  }
+  
+  template<int N>
+  ssize_t BVHNStatistics<N>::bytesSaved() const {
+    return ssize_t(numPrimBlocks)*(ssize_t(bvh->primTy.bytesUncompressed)-ssize_t(bvh->primTy.bytes));
   }
   
   template<int N>
@@ -67,10 +73,11 @@ namespace embree
     size_t bytesUnalignedNodesMB = numUnalignedNodesMB*sizeof(UnalignedNodeMB);
     size_t bytesTransformNodes = numTransformNodes*sizeof(TransformNode);
     size_t bytesQuantizedNodes = numQuantizedNodes*sizeof(QuantizedNode);
+    size_t bytesQuantizedUnalignedNodes = numQuantizedUnalignedNodes*sizeof(QuantizedUnalignedNode);
     size_t bytesPrims  = numPrimBlocks*bvh->primTy.bytes;
     size_t numVertices = bvh->numVertices;
     size_t bytesVertices = numVertices*sizeof(Vec3fa); 
-    size_t bytesTotal = bytesAlignedNodes+bytesUnalignedNodes+bytesAlignedNodesMB+bytesUnalignedNodesMB+bytesTransformNodes+bytesQuantizedNodes+bytesPrims+bytesVertices;
+    size_t bytesTotal = bytesAlignedNodes+bytesUnalignedNodes+bytesAlignedNodesMB+bytesUnalignedNodesMB+bytesTransformNodes+bytesQuantizedNodes+bytesQuantizedUnalignedNodes+bytesPrims+bytesVertices;
     //size_t bytesTotalAllocated = bvh->alloc.bytes();
     stream.setf(std::ios::fixed, std::ios::floatfield);
     stream << "  primitives = " << bvh->numPrimitives << ", vertices = " << bvh->numVertices << std::endl;
@@ -122,12 +129,25 @@ namespace embree
 	     << "(" << 100.0*double(bytesQuantizedNodes)/double(bytesTotal) << "% of total)"
 	     << std::endl;
     }
+    if (numQuantizedUnalignedNodes) {
+      stream << "  quantizedUnalignedNodes = "  << numQuantizedUnalignedNodes << " "
+             << "(" << 100.0*double(childrenQuantizedUnalignedNodes)/double(N*numQuantizedUnalignedNodes) << "% filled) "
+	     << "(" << bytesQuantizedUnalignedNodes/1E6  << " MB) " 
+	     << "(" << 100.0*double(bytesQuantizedUnalignedNodes)/double(bytesTotal) << "% of total)"
+	     << std::endl;
+    }
 
     stream << "  leaves = " << numLeaves << " "
            << "(" << bytesPrims/1E6  << " MB) "
            << "(" << 100.0*double(bytesPrims)/double(bytesTotal) << "% of total)"
            << "(" << 100.0*double(numPrims)/double(bvh->primTy.blockSize*numPrimBlocks) << "% used)" 
            << std::endl;
+    if (bvh->primTy.bytesUncompressed != bvh->primTy.bytes) {
+      const ssize_t bytesSavedPrims = bytesSaved();
+      stream << "  compressed leaves save " << bytesSavedPrims/1E6 << " MB "
+             << "(" << 100.0*double(bytesSavedPrims)/double(ssize_t(bytesPrims)+bytesSavedPrims) << "% of uncompressed leaves)"
+             << std::endl;
+    }
     stream << "  vertices = " << numVertices << " "
            << "(" << bytesVertices/1E6 << " MB) " 
            << "(" << 100.0*double(bytesVertices)/double(bytesTotal) << "% of total) "
@@ -170,6 +190,22 @@ namespace embree
       }
       depth++;
     }
+    else if (node.isQuantizedUnalignedNode())
+    {
+      numQuantizedUnalignedNodes++;
+      QuantizedUnalignedNode* n = node.quantizedUnalignedNode();
+      bvhSAH += A*travCostUnaligned;
+      
+      depth = 0;
+      for (size_t i=0; i<N; i++) {
+        if (n->child(i) == BVH::emptyNode) continue;
+        childrenQuantizedUnalignedNodes++;
+        const float Ai = max(0.0f,halfArea(n->extend(i)));
+        size_t cdepth; statistics(n->child(i),Ai,cdepth); 
+        depth=max(depth,cdepth);
+      }
+      depth++;
+    }
     else if (node.isNodeMB())
     {
       numAlignedNodesMB++;
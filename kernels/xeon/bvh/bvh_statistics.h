@@ -30,6 +30,7 @@ namespace embree
     typedef typename BVH::UnalignedNodeMB UnalignedNodeMB;
     typedef typename BVH::TransformNode TransformNode;
     typedef typename BVH::QuantizedNode QuantizedNode;
+    typedef typename BVH::QuantizedUnalignedNode QuantizedUnalignedNode;
 
     typedef typename BVH::NodeRef NodeRef;
 
@@ -45,6 +46,9 @@ namespace embree
 
     size_t bytesUsed() const;
 
+    /*! Returns the number of bytes saved by compressed leaves compared to full precision leaves, negative if they need more. */
+    ssize_t bytesSaved() const;
+
   private:
     void statistics(NodeRef node, const float A, size_t& depth);
 
@@ -58,11 +62,13 @@ namespace embree
     size_t numUnalignedNodesMB;        //!< Number of unaligned internal nodes.
     size_t numTransformNodes;          //!< Number of transformation nodes;
     size_t numQuantizedNodes;          //!< Number of transformation nodes;
+    size_t numQuantizedUnalignedNodes; //!< Number of quantized unaligned internal nodes.
     size_t childrenAlignedNodes;       //!< Number of children of aligned nodes
     size_t childrenUnalignedNodes;     //!< Number of children of unaligned internal nodes.
     size_t childrenAlignedNodesMB;     //!< Number of children of aligned nodes
     size_t childrenUnalignedNodesMB;   //!< Number of children of unaligned internal nodes.
     size_t childrenQuantizedNodes;     //!< Number of children of quantized internal nodes.
+    size_t childrenQuantizedUnalignedNodes; //!< Number of children of quantized unaligned internal nodes.
     size_t numLeaves;                  //!< Number of leaf nodes.
     size_t numPrims;                   //!< Number of primitives.
     size_t numPrimBlocks;              //!< Number of primitive blocks.
@@ -0,0 +1,274 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "bezierv.h"
+#include "bezier1v_intersector.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Culls M curves against a ray and prepares the surviving curves for intersection. */
+    template<int M>
+      struct BezierMvRaySpace
+    {
+      typedef Vec4<vfloat<M>> Vec4vfM;
+
+      /* maximal allowed deviation of the tessellated curve from the real curve relative to the curve radius */
+      static __forceinline float flatnessTolerance() { return 0.25f; }
+
+      /* transforms the control points of all curves into ray space */
+      __forceinline BezierMvRaySpace(const BezierMv<M>& prim, const Vec3fa& org, const LinearSpace3fa& space)
+      {
+        w0 = xfm(prim.p0,org,space);
+        w1 = xfm(prim.p1,org,space);
+        w2 = xfm(prim.p2,org,space);
+        w3 = xfm(prim.p3,org,space);
+      }
+
+      static __forceinline Vec4vfM xfm(const Vec4vfM& p, const Vec3fa& org, const LinearSpace3fa& space)
+      {
+        const vfloat<M> dx = p.x-vfloat<M>(org.x);
+        const vfloat<M> dy = p.y-vfloat<M>(org.y);
+        const vfloat<M> dz = p.z-vfloat<M>(org.z);
+        return Vec4vfM(dx*space.vx.x + dy*space.vy.x + dz*space.vz.x,
+                       dx*space.vx.y + dy*space.vy.y + dz*space.vz.y,
+                       dx*space.vx.z + dy*space.vy.z + dz*space.vz.z,
+                       p.w);
+      }
+
+      /* returns mask of all curves whose convex hull enlarged by the curve radius overlaps the ray */
+      __forceinline size_t cull(const BezierMv<M>& prim, const float depth_scale, const float tnear, const float tfar) const
+      {
+        const vfloat<M> r = max(abs(w0.w),abs(w1.w),abs(w2.w),abs(w3.w));
+        const vfloat<M> lower_x = min(w0.x,w1.x,w2.x,w3.x)-r, upper_x = max(w0.x,w1.x,w2.x,w3.x)+r;
+        const vfloat<M> lower_y = min(w0.y,w1.y,w2.y,w3.y)-r, upper_y = max(w0.y,w1.y,w2.y,w3.y)+r;
+        const vfloat<M> lower_t = (min(w0.z,w1.z,w2.z,w3.z)-r)*depth_scale;
+        const vfloat<M> upper_t = (max(w0.z,w1.z,w2.z,w3.z)+r)*depth_scale;
+        vbool<M> valid = prim.valid();
+        valid &= (lower_x <= vfloat<M>(zero)) & (upper_x >= vfloat<M>(zero));
+        valid &= (lower_y <= vfloat<M>(zero)) & (upper_y >= vfloat<M>(zero));
+        valid &= (lower_t <= vfloat<M>(tfar)) & (upper_t >= vfloat<M>(tnear));
+        return movemask(valid);
+      }
+
+      /* returns the ray space curve with index i */
+      __forceinline BezierCurve3fa curve2D(const size_t i) const
+      {
+        return BezierCurve3fa(Vec3fa(w0.x[i],w0.y[i],w0.z[i],w0.w[i]),
+                              Vec3fa(w1.x[i],w1.y[i],w1.z[i],w1.w[i]),
+                              Vec3fa(w2.x[i],w2.y[i],w2.z[i],w2.w[i]),
+                              Vec3fa(w3.x[i],w3.y[i],w3.z[i],w3.w[i]),
+                              0.0f,1.0f,4);
+      }
+
+      /* Selects the number of line segments for the i'th curve. The
+       * distance of a cubic bezier curve to its polyline with N
+       * segments is bounded by 3/4*L/N^2, with L the largest second
+       * difference of the control points. We measure L in the ray
+       * space xy plane, which only takes the projected size of the
+       * curve into account, and pick the smallest divisor of the
+       * tessellation rate that keeps this distance below a fraction of
+       * the curve radius. As all vertices of such a polyline are also
+       * vertices of the polyline with maxN segments, the curve stays
+       * inside the bounds used to build the BVH. */
+      __forceinline int tessellationRate(const size_t i, const int maxN) const
+      {
+        const float ax = w0.x[i]-2.0f*w1.x[i]+w2.x[i], ay = w0.y[i]-2.0f*w1.y[i]+w2.y[i];
+        const float bx = w1.x[i]-2.0f*w2.x[i]+w3.x[i], by = w1.y[i]-2.0f*w2.y[i]+w3.y[i];
+        const float L = sqrt(max(ax*ax+ay*ay,bx*bx+by*by));
+        const float r = max(abs(w0.w[i]),abs(w1.w[i]),abs(w2.w[i]),abs(w3.w[i]));
+        const float n = ceilf(sqrt(0.75f*L/(flatnessTolerance()*r)));
+        if (!(n < float(maxN))) return maxN; // also handles zero radius
+        int N = max(int(n),1);
+        while (maxN % N) N++;
+        return N;
+      }
+
+    public:
+      Vec4vfM w0,w1,w2,w3; // control points in ray space
+    };
+
+    /*! Intersects the ray space curve tessellated into N line segments. */
+    template<typename Epilog>
+      __forceinline bool intersectBezierSegments(const BezierCurve3fa& curve2D, const int N, const float depth_scale,
+                                                 const float ray_tnear, const float& ray_tfar,
+                                                 const Vec3fa& v0, const Vec3fa& v1, const Vec3fa& v2, const Vec3fa& v3,
+                                                 const Epilog& epilog)
+    {
+      /* process SIMD-size many segments per iteration */
+      bool ishit = false;
+      for (int i=0; i<N; i+=VSIZEX)
+      {
+        /* evaluate the bezier curve */
+        vboolx valid = vintx(i)+vintx(step) < vintx(N);
+        const Vec4vfx p0 = curve2D.eval0(valid,i,N);
+        const Vec4vfx p1 = curve2D.eval1(valid,i,N);
+
+        /* approximative intersection with cone */
+        const Vec4vfx v = p1-p0;
+        const Vec4vfx w = -p0;
+        const vfloatx d0 = w.x*v.x + w.y*v.y;
+        const vfloatx d1 = v.x*v.x + v.y*v.y;
+        const vfloatx u = clamp(d0*rcp(d1),vfloatx(zero),vfloatx(one));
+        const Vec4vfx p = p0 + u*v;
+        const vfloatx t = p.z*depth_scale;
+        const vfloatx d2 = p.x*p.x + p.y*p.y;
+        const vfloatx r = p.w;
+        const vfloatx r2 = r*r;
+        valid &= d2 <= r2 & vfloatx(ray_tnear) < t & t < vfloatx(ray_tfar);
+        if (likely(none(valid))) continue;
+
+        /* update hit information */
+        BezierHit<VSIZEX> hit(valid,u,0.0f,t,i,N,v0,v1,v2,v3);
+        ishit |= epilog(valid,hit);
+      }
+      return ishit;
+    }
+
+    /*! Intersector for a single ray with M bezier curves. */
+    template<int M>
+      struct BezierMvIntersector1
+    {
+      typedef BezierMv<M> Primitive;
+      typedef Bezier1vIntersector1 Precalculations;
+
+      static __forceinline void intersect(const Precalculations& pre, Ray& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene, const unsigned* geomID_to_instID)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        const float depth_scale = pre.intersectorHair.depth_scale;
+        const BezierMvRaySpace<M> rs(prim,ray.org,pre.intersectorHair.ray_space);
+        size_t mask = rs.cull(prim,depth_scale,ray.tnear,ray.tfar);
+        while (mask)
+        {
+          const size_t i = __bscf(mask);
+          const unsigned geomID = prim.geomID(i);
+          const unsigned primID = prim.primID(i);
+          const BezierCurves* geom = (BezierCurves*)scene->get(geomID);
+          Vec3fa v0,v1,v2,v3; prim.gather(i,v0,v1,v2,v3);
+          if (likely(geom->subtype == BezierCurves::HAIR))
+            intersectBezierSegments(rs.curve2D(i),rs.tessellationRate(i,geom->tessellationRate),depth_scale,ray.tnear,ray.tfar,v0,v1,v2,v3,
+                                    Intersect1EpilogMU<VSIZEX,true>(ray,context,geomID,primID,scene,geomID_to_instID));
+          else
+            pre.intersectorCurve.intersect(ray,v0,v1,v2,v3,Intersect1Epilog1<true>(ray,context,geomID,primID,scene,geomID_to_instID));
+        }
+      }
+
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene, const unsigned* geomID_to_instID)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        const float depth_scale = pre.intersectorHair.depth_scale;
+        const BezierMvRaySpace<M> rs(prim,ray.org,pre.intersectorHair.ray_space);
+        size_t mask = rs.cull(prim,depth_scale,ray.tnear,ray.tfar);
+        while (mask)
+        {
+          const size_t i = __bscf(mask);
+          const unsigned geomID = prim.geomID(i);
+          const unsigned primID = prim.primID(i);
+          const BezierCurves* geom = (BezierCurves*)scene->get(geomID);
+          Vec3fa v0,v1,v2,v3; prim.gather(i,v0,v1,v2,v3);
+          if (likely(geom->subtype == BezierCurves::HAIR)) {
+            if (intersectBezierSegments(rs.curve2D(i),rs.tessellationRate(i,geom->tessellationRate),depth_scale,ray.tnear,ray.tfar,v0,v1,v2,v3,
+                                        Occluded1EpilogMU<VSIZEX,true>(ray,context,geomID,primID,scene,geomID_to_instID)))
+              return true;
+          }
+          else {
+            if (pre.intersectorCurve.intersect(ray,v0,v1,v2,v3,Occluded1Epilog1<true>(ray,context,geomID,primID,scene,geomID_to_instID)))
+              return true;
+          }
+        }
+        return false;
+      }
+    };
+
+    /*! Intersector for a single ray from a ray packet with M bezier curves. */
+    template<int M, int K>
+      struct BezierMvIntersectorK
+    {
+      typedef BezierMv<M> Primitive;
+      typedef Bezier1vIntersectorK<K> Precalculations;
+
+      static __forceinline void intersect(Precalculations& pre, RayK<K>& ray, const size_t k, const RTCIntersectContext* context, const Primitive& prim, Scene* scene)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        const Vec3fa ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        const float depth_scale = pre.intersectorHair.depth_scale[k];
+        const BezierMvRaySpace<M> rs(prim,ray_org,pre.intersectorHair.ray_space[k]);
+        size_t mask = rs.cull(prim,depth_scale,ray.tnear[k],ray.tfar[k]);
+        while (mask)
+        {
+          const size_t i = __bscf(mask);
+          const unsigned geomID = prim.geomID(i);
+          const unsigned primID = prim.primID(i);
+          const BezierCurves* geom = (BezierCurves*)scene->get(geomID);
+          Vec3fa v0,v1,v2,v3; prim.gather(i,v0,v1,v2,v3);
+          if (likely(geom->subtype == BezierCurves::HAIR))
+            intersectBezierSegments(rs.curve2D(i),rs.tessellationRate(i,geom->tessellationRate),depth_scale,ray.tnear[k],ray.tfar[k],v0,v1,v2,v3,
+                                    Intersect1KEpilogMU<VSIZEX,K,true>(ray,k,context,geomID,primID,scene));
+          else
+            pre.intersectorCurve.intersect(ray,k,v0,v1,v2,v3,Intersect1KEpilog1<K,true>(ray,k,context,geomID,primID,scene));
+        }
+      }
+
+      static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene)
+      {
+        int mask = movemask(valid_i);
+        while (mask) intersect(pre,ray,__bscf(mask),context,prim,scene);
+      }
+
+      static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, const size_t k, const RTCIntersectContext* context, const Primitive& prim, Scene* scene)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        const Vec3fa ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        const float depth_scale = pre.intersectorHair.depth_scale[k];
+        const BezierMvRaySpace<M> rs(prim,ray_org,pre.intersectorHair.ray_space[k]);
+        size_t mask = rs.cull(prim,depth_scale,ray.tnear[k],ray.tfar[k]);
+        while (mask)
+        {
+          const size_t i = __bscf(mask);
+          const unsigned geomID = prim.geomID(i);
+          const unsigned primID = prim.primID(i);
+          const BezierCurves* geom = (BezierCurves*)scene->get(geomID);
+          Vec3fa v0,v1,v2,v3; prim.gather(i,v0,v1,v2,v3);
+          if (likely(geom->subtype == BezierCurves::HAIR)) {
+            if (intersectBezierSegments(rs.curve2D(i),rs.tessellationRate(i,geom->tessellationRate),depth_scale,ray.tnear[k],ray.tfar[k],v0,v1,v2,v3,
+                                        Occluded1KEpilogMU<VSIZEX,K,true>(ray,k,context,geomID,primID,scene)))
+              return true;
+          }
+          else {
+            if (pre.intersectorCurve.intersect(ray,k,v0,v1,v2,v3,Occluded1KEpilog1<K,true>(ray,k,context,geomID,primID,scene)))
+              return true;
+          }
+        }
+        return false;
+      }
+
+      static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene)
+      {
+        vbool<K> valid_o = false;
+        int mask = movemask(valid_i);
+        while (mask) {
+          size_t k = __bscf(mask);
+          if (occluded(pre,ray,k,context,prim,scene))
+            set(valid_o, k);
+        }
+        return valid_o;
+      }
+    };
+  }
+}
@@ -39,19 +39,19 @@ namespace embree
     template<> __forceinline void occludedObject <16>(vint16* valid, Scene* object, Ray16& ray) { object->occluded16 (valid,(RTCRay16&)ray,nullptr); }
 #endif
 
+    /* ray packets only record the ID of the outermost instance, thus
+     * nested instances keep the instance ID of their parent */
     template<int K>
     void FastInstanceIntersectorK<K>::intersect(vint<K>* valid, const Instance* instance, RayK<K>& ray, size_t item)
     {
+      const size_t level = Instance::level;
+      if (unlikely(level >= instance->maxLevel)) return;
+
       typedef Vec3<vfloat<K>> Vec3vfK;
       typedef AffineSpaceT<LinearSpace3<Vec3vfK>> AffineSpace3vfK;
       
-      AffineSpace3vfK world2local;
-      if (likely(instance->numTimeSteps == 1)) {
-        world2local = instance->world2local[0];
-      } else {
-        vfloat<K> t1 = ray.time, t0 = vfloat<K>(1.0f)-t1;
-        world2local = rcp(t0*AffineSpace3vfK(instance->local2world[0]) + t1*AffineSpace3vfK(instance->local2world[1]));
-      }
+      const vbool<K> valid0 = *valid == vint<K>(-1);
+      const AffineSpace3vfK world2local = instance->getWorld2Local<K>(valid0,ray.time);
       
       const Vec3vfK ray_org = ray.org;
       const Vec3vfK ray_dir = ray.dir;
@@ -60,8 +60,10 @@ namespace embree
       ray.org = xfmPoint (world2local,ray_org);
       ray.dir = xfmVector(world2local,ray_dir);
       ray.geomID = -1;
-      ray.instID = instance->id;
+      if (level == 0) ray.instID = instance->id;
+      Instance::level = level+1;
       intersectObject(valid,instance->object,ray);
+      Instance::level = level;
       ray.org = ray_org;
       ray.dir = ray_dir;
       vbool<K> nohit = ray.geomID == vint<K>(-1);
@@ -72,24 +74,24 @@ namespace embree
     template<int K>
     void FastInstanceIntersectorK<K>::occluded(vint<K>* valid, const Instance* instance, RayK<K>& ray, size_t item)
     {
+      const size_t level = Instance::level;
+      if (unlikely(level >= instance->maxLevel)) return;
+
       typedef Vec3<vfloat<K>> Vec3vfK;
       typedef AffineSpaceT<LinearSpace3<Vec3vfK>> AffineSpace3vfK;
 
-      AffineSpace3vfK world2local;
-      if (likely(instance->numTimeSteps == 1)) {
-        world2local = instance->world2local[0];
-      } else {
-        vfloat<K> t1 = ray.time, t0 = vfloat<K>(1.0f)-t1;
-        world2local = rcp(t0*AffineSpace3vfK(instance->local2world[0]) + t1*AffineSpace3vfK(instance->local2world[1]));
-      }
+      const vbool<K> valid0 = *valid == vint<K>(-1);
+      const AffineSpace3vfK world2local = instance->getWorld2Local<K>(valid0,ray.time);
 
       const Vec3vfK ray_org = ray.org;
       const Vec3vfK ray_dir = ray.dir;
       const vint<K> ray_geomID = ray.geomID;
       ray.org = xfmPoint (world2local,ray_org);
       ray.dir = xfmVector(world2local,ray_dir);
-      ray.instID = instance->id;
+      if (level == 0) ray.instID = instance->id;
+      Instance::level = level+1;
       occludedObject(valid,instance->object,ray);
+      Instance::level = level;
       ray.org = ray_org;
       ray.dir = ray_dir;
     }
@@ -26,42 +26,62 @@ namespace embree
       if (instance->numTimeSteps == 1) {
         bounds_o[0] = xfmBounds(instance->local2world[0],instance->object->bounds);
       } else {
-        bounds_o[0] = xfmBounds(instance->local2world[0],instance->object->bounds);
-        bounds_o[1] = xfmBounds(instance->local2world[1],instance->object->bounds);
+        /* the interpolated rotation does not move linearly, thus both
+         * bounds have to contain the instance over the whole time range */
+        bounds_o[0] = bounds_o[1] = instance->boundsMotionBlur();
       }
     }
 
     RTCBoundsFunc2 InstanceBoundsFunc = (RTCBoundsFunc2) InstanceBoundsFunction;
 
+    /* sets the instance ID of some nesting level and clears the IDs of all deeper levels */
+    __forceinline void pushInstanceID(Ray& ray, const size_t level, const int instID)
+    {
+      ray.instIDLevel(level) = instID;
+      for (size_t l=level+1; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+        ray.instIDLevel(l) = -1;
+    }
+
     void FastInstanceIntersector1::intersect(const Instance* instance, Ray& ray, size_t item)
     {
+      const size_t level = Instance::level;
+      if (unlikely(level >= instance->maxLevel)) return;
+
       const AffineSpace3fa world2local = instance->getWorld2LocalSpecial(ray.time);
       const Vec3fa ray_org = ray.org;
       const Vec3fa ray_dir = ray.dir;
       const int ray_geomID = ray.geomID;
-      const int ray_instID = ray.instID;
+      int ray_instIDs[RTC_MAX_INSTANCE_LEVEL_COUNT];
+      for (size_t l=level; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) ray_instIDs[l] = ray.instIDLevel(l);
       ray.org = xfmPoint (world2local,ray_org);
       ray.dir = xfmVector(world2local,ray_dir);
       ray.geomID = -1;
-      ray.instID = instance->id;
+      pushInstanceID(ray,level,instance->id);
+      Instance::level = level+1;
       instance->object->intersect((RTCRay&)ray,nullptr);
+      Instance::level = level;
       ray.org = ray_org;
       ray.dir = ray_dir;
       if (ray.geomID == -1) {
         ray.geomID = ray_geomID;
-        ray.instID = ray_instID;
+        for (size_t l=level; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) ray.instIDLevel(l) = ray_instIDs[l];
       }
     }
     
     void FastInstanceIntersector1::occluded (const Instance* instance, Ray& ray, size_t item)
     {
+      const size_t level = Instance::level;
+      if (unlikely(level >= instance->maxLevel)) return;
+
       const AffineSpace3fa world2local = instance->getWorld2LocalSpecial(ray.time);
       const Vec3fa ray_org = ray.org;
       const Vec3fa ray_dir = ray.dir;
       ray.org = xfmPoint (world2local,ray_org);
       ray.dir = xfmVector(world2local,ray_dir);
-      ray.instID = instance->id;
+      pushInstanceID(ray,level,instance->id);
+      Instance::level = level+1;
       instance->object->occluded((RTCRay&)ray,nullptr);
+      Instance::level = level;
       ray.org = ray_org;
       ray.dir = ray_dir;
     }
@@ -71,6 +91,9 @@ namespace embree
     void FastInstanceIntersector1M::intersect(const Instance* instance, const RTCIntersectContext* context, Ray** rays, size_t M, size_t item)
     {
       assert(M<MAX_INTERNAL_STREAM_SIZE);
+      const size_t level = Instance::level;
+      if (unlikely(level >= instance->maxLevel)) return;
+
       Ray lrays[MAX_INTERNAL_STREAM_SIZE];
       AffineSpace3fa world2local = instance->getWorld2Local();
 
@@ -86,15 +109,17 @@ namespace embree
         lrays[i].time = rays[i]->time;
         lrays[i].mask = rays[i]->mask;
         lrays[i].geomID = -1;
-        lrays[i].instID = instance->id;
+        pushInstanceID(lrays[i],level,instance->id);
       }
 
+      Instance::level = level+1;
       rtcIntersect1M((RTCScene)instance->object,context,(RTCRay*)lrays,M,sizeof(Ray));
+      Instance::level = level;
         
       for (size_t i=0; i<M; i++)
       {
         if (lrays[i].geomID == -1) continue;
-        rays[i]->instID = lrays[i].instID;
+        for (size_t l=level; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) rays[i]->instIDLevel(l) = lrays[i].instIDLevel(l);
         rays[i]->geomID = lrays[i].geomID;
         rays[i]->primID = lrays[i].primID;
         rays[i]->u = lrays[i].u;
@@ -107,6 +132,9 @@ namespace embree
     void FastInstanceIntersector1M::occluded (const Instance* instance, const RTCIntersectContext* context, Ray** rays, size_t M, size_t item)
     {
       assert(M<MAX_INTERNAL_STREAM_SIZE);
+      const size_t level = Instance::level;
+      if (unlikely(level >= instance->maxLevel)) return;
+
       Ray lrays[MAX_INTERNAL_STREAM_SIZE];
       AffineSpace3fa world2local = instance->getWorld2Local();
       
@@ -122,10 +150,12 @@ namespace embree
         lrays[i].time = rays[i]->time;
         lrays[i].mask = rays[i]->mask;
         lrays[i].geomID = -1;
-        lrays[i].instID = instance->id;
+        pushInstanceID(lrays[i],level,instance->id);
       }
 
+      Instance::level = level+1;
       rtcOccluded1M((RTCScene)instance->object,context,(RTCRay*)lrays,M,sizeof(Ray));
+      Instance::level = level;
         
       for (size_t i=0; i<M; i++)
       {
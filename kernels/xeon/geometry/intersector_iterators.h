@@ -44,8 +44,16 @@ namespace embree
           return false;
         }
 
+        /*! primitives get intersected right away, thus nothing gets batched */
+        struct StreamBatch {};
+
+        template<typename Context>
+        static __forceinline size_t flushIntersect(StreamBatch& batch, Ray** rays, const RTCIntersectContext* context, Context* ctx) { return 0; }
+
+        static __forceinline size_t flushOccluded(StreamBatch& batch, Ray** rays, const RTCIntersectContext* context) { return 0; }
+
         template<typename Context>
-        static __forceinline size_t intersect(Precalculations* pre, size_t valid, Ray** rays, const RTCIntersectContext* context, Context* ctx, size_t ty, const Primitive* prim, size_t num, Scene* scene, const unsigned* geomID_to_instID, size_t& lazy_node)
+        static __forceinline size_t intersect(Precalculations* pre, size_t valid, Ray** rays, const RTCIntersectContext* context, Context* ctx, size_t ty, const Primitive* prim, size_t num, Scene* scene, const unsigned* geomID_to_instID, size_t& lazy_node, StreamBatch& batch)
         {
           size_t valid_isec = 0;
           do {
@@ -57,7 +65,7 @@ namespace embree
           return valid_isec;
         }
 
-        static __forceinline size_t occluded(Precalculations* pre, size_t valid, Ray** rays, const RTCIntersectContext* context, size_t ty, const Primitive* prim, size_t num, Scene* scene, const unsigned* geomID_to_instID, size_t& lazy_node) 
+        static __forceinline size_t occluded(Precalculations* pre, size_t valid, Ray** rays, const RTCIntersectContext* context, size_t ty, const Primitive* prim, size_t num, Scene* scene, const unsigned* geomID_to_instID, size_t& lazy_node, StreamBatch& batch) 
         {
           size_t hit = 0;
           do {
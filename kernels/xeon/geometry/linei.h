@@ -160,7 +160,7 @@ namespace embree
     }
 
     /* Fill line segment from line segment list */
-    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, const BBox1f& time_range = BBox1f(0.0f,1.0f))
     {
       fill(prims,begin,end,scene,list);
       return bounds(scene);
@@ -51,7 +51,7 @@ namespace embree
     }
 
     /*! fill triangle from triangle list */
-    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& i, size_t end, Scene* scene, const bool list)
+    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& i, size_t end, Scene* scene, const bool list, const BBox1f& time_range = BBox1f(0.0f,1.0f))
     {
       const PrimRef& prim = prims[i]; i++;
       const size_t geomID = prim.geomID();
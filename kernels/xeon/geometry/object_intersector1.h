@@ -61,10 +61,81 @@ namespace embree
         return ray.geomID == 0;
       }
       
+      /*! Collects the ray/item pairs of a user geometry with batched
+       *  callbacks, such that the user can process many rays and
+       *  items at once. */
+      struct StreamBatch
+      {
+        enum { MAX_SIZE = 4*MAX_INTERNAL_STREAM_SIZE };
+
+        __forceinline StreamBatch () : accel(nullptr), size(0) {}
+
+        __forceinline bool full() const { return size == MAX_SIZE; }
+
+        __forceinline void add(Ray* ray, unsigned item, size_t i)
+        {
+          rays [size] = (RTCRay*) ray;
+          items[size] = item;
+          index[size] = (unsigned char) i;
+          size++;
+        }
+
+      public:
+        AccelSet* accel;                //!< user geometry all pairs belong to
+        size_t size;                    //!< number of collected pairs
+        RTCRay* rays[MAX_SIZE];         //!< ray of each pair
+        unsigned items[MAX_SIZE];       //!< item of each pair
+        unsigned char index[MAX_SIZE];  //!< index of the ray in the stream
+      };
+
       template<typename Context>
-      static __forceinline size_t intersect(Precalculations* pre, size_t valid_in, Ray** rays, const RTCIntersectContext* context, Context* ctx, size_t ty, const Primitive* prims, size_t num, Scene* scene, const unsigned* geomID_to_instID, size_t& lazy_node)
+      static __forceinline size_t flushIntersect(StreamBatch& batch, Ray** rays, const RTCIntersectContext* context, Context* ctx)
+      {
+        if (likely(batch.size == 0)) return 0;
+        AVX_ZERO_UPPER();
+
+        /* call user batched intersection function */
+        batch.accel->intersectNM(batch.rays,batch.items,batch.size,context);
+
+        size_t valid = 0;
+        for (size_t i=0; i<batch.size; i++)
+          valid |= (size_t)1 << batch.index[i];
+        batch.size = 0;
+
+        /* update contexts of all processed rays */
+        size_t valid_isec = 0;
+        while (unlikely(valid)) {
+          const size_t i = __bscf(valid);
+          valid_isec |= (rays[i]->tfar < ctx[i].tfar()) ? ((size_t)1 << i) : 0;
+          ctx[i].update(rays[i]);
+        }
+        return valid_isec;
+      }
+
+      static __forceinline size_t flushOccluded(StreamBatch& batch, Ray** rays, const RTCIntersectContext* context)
       {
+        if (likely(batch.size == 0)) return 0;
         AVX_ZERO_UPPER();
+
+        /* call user batched occluded function */
+        batch.accel->occludedNM(batch.rays,batch.items,batch.size,context);
+
+        /* mark occluded rays */
+        size_t hit = 0;
+        for (size_t i=0; i<batch.size; i++) {
+          if (batch.rays[i]->geomID == 0)
+            hit |= (size_t)1 << batch.index[i];
+        }
+        batch.size = 0;
+        return hit;
+      }
+      
+      template<typename Context>
+      static __forceinline size_t intersect(Precalculations* pre, size_t valid_in, Ray** rays, const RTCIntersectContext* context, Context* ctx, size_t ty, const Primitive* prims, size_t num, Scene* scene, const unsigned* geomID_to_instID, size_t& lazy_node, StreamBatch& batch)
+      {
+        AVX_ZERO_UPPER();
+        size_t valid_isec = 0;
+        bool immediate = false;
         
         /* intersect all primitives */
         for (size_t i=0; i<num; i++)
@@ -72,6 +143,32 @@ namespace embree
           const Primitive& prim = prims[i];
           AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
 
+          /* geometries with batched callback get intersected when the batch is flushed */
+          if (accel->intersectors.intersectorNM.intersect)
+          {
+            if (batch.accel != accel) {
+              valid_isec |= flushIntersect(batch,rays,context,ctx);
+              batch.accel = accel;
+            }
+            size_t valid = valid_in;
+            while (unlikely(valid)) 
+            {
+              const size_t i = __bscf(valid);
+              Ray* ray = rays[i];
+
+              /* perform ray mask test */
+#if defined(RTCORE_RAY_MASK)
+              if ((ray->mask & accel->mask) == 0) 
+                continue;
+#endif
+              if (unlikely(batch.full()))
+                valid_isec |= flushIntersect(batch,rays,context,ctx);
+              batch.add(ray,prim.primID,i);
+            }
+            continue;
+          }
+          immediate = true;
+
           size_t N = 0, valid = valid_in;
           Ray* rays_filtered[64];
           while (unlikely(valid)) 
@@ -93,15 +190,16 @@ namespace embree
         }
 
         /* update all contexts */
-        size_t valid = valid_in;
+        size_t valid = immediate ? valid_in : 0;
         while (unlikely(valid)) {
           const size_t i = __bscf(valid);
+          valid_isec |= (rays[i]->tfar < ctx[i].tfar()) ? ((size_t)1 << i) : 0;
           ctx[i].update(rays[i]);
         }
-        return valid;
+        return valid_isec;
       }
 
-      static __forceinline size_t occluded(Precalculations* pre, size_t valid_in, Ray** rays, const RTCIntersectContext* context, size_t ty, const Primitive* prims, size_t num, Scene* scene, const unsigned* geomID_to_instID, size_t& lazy_node)
+      static __forceinline size_t occluded(Precalculations* pre, size_t valid_in, Ray** rays, const RTCIntersectContext* context, size_t ty, const Primitive* prims, size_t num, Scene* scene, const unsigned* geomID_to_instID, size_t& lazy_node, StreamBatch& batch)
       {
         AVX_ZERO_UPPER();
         size_t hit = 0;
@@ -112,7 +210,32 @@ namespace embree
           const Primitive& prim = prims[i];
           AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
 
-          size_t N = 0, valid = valid_in;
+          /* geometries with batched callback get tested when the batch is flushed */
+          if (accel->intersectors.intersectorNM.occluded)
+          {
+            if (batch.accel != accel) {
+              hit |= flushOccluded(batch,rays,context);
+              batch.accel = accel;
+            }
+            size_t valid = valid_in & ~hit;
+            while (unlikely(valid)) 
+            {
+              const size_t i = __bscf(valid);
+              Ray* ray = rays[i];
+
+              /* perform ray mask test */
+#if defined(RTCORE_RAY_MASK)
+              if ((ray->mask & accel->mask) == 0) 
+                continue;
+#endif
+              if (unlikely(batch.full()))
+                hit |= flushOccluded(batch,rays,context);
+              batch.add(ray,prim.primID,i);
+            }
+            continue;
+          }
+
+          size_t N = 0, valid = valid_in & ~hit;
           Ray* rays_filtered[64];
           size_t index_filtered[64];
           while (unlikely(valid)) 
@@ -141,7 +264,6 @@ namespace embree
               hit |= (size_t)1 << index_filtered[i];
             }
           }
-          valid_in &= ~hit;
         }
         return hit;
       }
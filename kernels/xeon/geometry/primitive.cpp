@@ -16,11 +16,13 @@
 
 #include "primitive.h"
 #include "bezier1v.h"
+#include "bezierv.h"
 #include "bezier1i.h"
 #include "linei.h"
 #include "triangle.h"
 #include "trianglev.h"
 #include "trianglei.h"
+#include "triangleq.h"
 #include "trianglev_mb.h"
 #include "quadv.h"
 #include "quadi.h"
@@ -35,7 +37,7 @@ namespace embree
 
 #if !defined(__AVX__)
   Bezier1v::Type::Type () 
-    : PrimitiveType("bezier1v",sizeof(Bezier1v),1) {} 
+    : PrimitiveType("bezier1v",sizeof(Bezier1v),1,true) {} 
   
   size_t Bezier1v::Type::size(const char* This) const {
     return 1;
@@ -44,11 +46,24 @@ namespace embree
   Bezier1v::Type Bezier1v::type;
 #endif
 
+  /********************** Bezier4v **************************/
+
+#if !defined(__AVX__)
+  template<>
+  Bezier4v::Type::Type ()
+    : PrimitiveType("bezier4v",sizeof(Bezier4v),4,true) {}
+
+  template<>
+  size_t Bezier4v::Type::size(const char* This) const {
+    return ((Bezier4v*)This)->size();
+  }
+#endif
+
   /********************** Bezier1i **************************/
 
 #if !defined(__AVX__)
   Bezier1i::Type::Type () 
-    : PrimitiveType("bezier1i",sizeof(Bezier1i),1) {} 
+    : PrimitiveType("bezier1i",sizeof(Bezier1i),1,true) {} 
   
   size_t Bezier1i::Type::size(const char* This) const {
     return 1;
@@ -62,7 +77,7 @@ namespace embree
 #if !defined(__AVX__)
   template<>
   Line4i::Type::Type ()
-    : PrimitiveType("line4i",sizeof(Line4i),4) {}
+    : PrimitiveType("line4i",sizeof(Line4i),4,true) {}
 
   template<>
   size_t Line4i::Type::size(const char* This) const {
@@ -75,7 +90,7 @@ namespace embree
 #if !defined(__AVX__)
   template<>
   Triangle4::Type::Type () 
-    : PrimitiveType("triangle4",sizeof(Triangle4),4) {} 
+    : PrimitiveType("triangle4",sizeof(Triangle4),4,true) {} 
 
   template<>
   size_t Triangle4::Type::size(const char* This) const {
@@ -88,7 +103,7 @@ namespace embree
 #if !defined(__AVX__)
   template<>
   Triangle4v::Type::Type () 
-  : PrimitiveType("triangle4v",sizeof(Triangle4v),4) {} 
+  : PrimitiveType("triangle4v",sizeof(Triangle4v),4,true) {} 
   
   template<>
   size_t Triangle4v::Type::size(const char* This) const {
@@ -109,12 +124,25 @@ namespace embree
   }
 #endif
 
+  /********************** Triangle4q **************************/
+
+#if !defined(__AVX__)
+  template<>
+  Triangle4q::Type::Type () 
+    : PrimitiveType("triangle4q",sizeof(Triangle4q),4,true,sizeof(Triangle4i)) {} 
+
+  template<>
+  size_t Triangle4q::Type::size(const char* This) const {
+    return ((Triangle4q*)This)->size();
+  }
+#endif
+
   /********************** Triangle4vMB **************************/
 
 #if !defined(__AVX__)
   template<>
   Triangle4vMB::Type::Type () 
-  : PrimitiveType("triangle4vmb",sizeof(Triangle4vMB),4) {} 
+  : PrimitiveType("triangle4vmb",sizeof(Triangle4vMB),4,true) {} 
   
   template<>
   size_t Triangle4vMB::Type::size(const char* This) const {
@@ -127,7 +155,7 @@ namespace embree
 #if !defined(__AVX__)
   template<>
   Quad4v::Type::Type () 
-    : PrimitiveType("quad4v",sizeof(Quad4v),4) {}
+    : PrimitiveType("quad4v",sizeof(Quad4v),4,true) {}
 
   template<>
   size_t Quad4v::Type::size(const char* This) const {
@@ -140,7 +168,7 @@ namespace embree
 #if !defined(__AVX__)
   template<>
   Quad4i::Type::Type () 
-    : PrimitiveType("quad4i",sizeof(Quad4i),4) {} 
+    : PrimitiveType("quad4i",sizeof(Quad4i),4,true) {} 
 
   template<>
   size_t Quad4i::Type::size(const char* This) const {
@@ -153,7 +181,7 @@ namespace embree
 #if !defined(__AVX__)
   template<>
   Quad4iMB::Type::Type () 
-  : PrimitiveType("quad4imb",sizeof(Quad4iMB),4) {} 
+  : PrimitiveType("quad4imb",sizeof(Quad4iMB),4,true) {} 
   
   template<>
   size_t Quad4iMB::Type::size(const char* This) const {
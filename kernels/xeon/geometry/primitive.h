@@ -25,8 +25,8 @@ namespace embree
   struct PrimitiveType
   {
     /*! constructs the primitive type */
-    PrimitiveType (const std::string& name, size_t bytes, size_t blockSize) 
-    : name(name), bytes(bytes), blockSize(blockSize) {} 
+    PrimitiveType (const std::string& name, size_t bytes, size_t blockSize, bool relocatable = false, size_t bytesUncompressed = 0) 
+    : name(name), bytes(bytes), blockSize(blockSize), relocatable(relocatable), bytesUncompressed(bytesUncompressed ? bytesUncompressed : bytes) {} 
 
     /*! Returns the number of stored primitives in a block. */
     virtual size_t size(const char* This) const = 0;
@@ -35,5 +35,7 @@ namespace embree
     std::string name;       //!< name of this primitive type
     size_t bytes;           //!< number of bytes of the triangle data
     size_t blockSize;       //!< block size
+    bool relocatable;       //!< true if primitive blocks store no pointers and can get copied to a different location
+    size_t bytesUncompressed; //!< number of bytes of a block of the full precision type this type replaces
   };
 }
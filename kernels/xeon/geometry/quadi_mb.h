@@ -82,24 +82,52 @@ namespace embree
       return *(Vec3fa*)mesh->vertexPtr(v[index]);
     }
 
-     template<typename T>
-     __forceinline Vec3<T> getVertex(const vint<M> &v, const size_t index, const Scene *const scene, const T& time) const
+     template<int K>
+     __forceinline Vec3<vfloat<K>> getVertex(const vint<M> &v, const size_t index, const Scene *const scene, const vfloat<K>& time) const
     {
       const QuadMesh* mesh = scene->getQuadMesh(geomID(index));
-      const Vec3fa v0  = *(Vec3fa*)mesh->vertexPtr(v[index],0);
-      const Vec3fa v1  = *(Vec3fa*)mesh->vertexPtr(v[index],1);
-      const Vec3<T> p0(v0.x,v0.y,v0.z);
-      const Vec3<T> p1(v1.x,v1.y,v1.z);
-      return (T(one)-time)*p0 + time*p1;
+
+      /* fast path for single segment motion blur */
+      if (likely(mesh->numTimeSteps == 2))
+      {
+        const Vec3fa v0  = *(Vec3fa*)mesh->vertexPtr(v[index],0);
+        const Vec3fa v1  = *(Vec3fa*)mesh->vertexPtr(v[index],1);
+        const Vec3<vfloat<K>> p0(v0.x,v0.y,v0.z);
+        const Vec3<vfloat<K>> p1(v1.x,v1.y,v1.z);
+        return (vfloat<K>(one)-time)*p0 + time*p1;
+      }
+
+      /* each ray may fall into a different time segment */
+      vfloat<K> ftime;
+      const vint<K> itime = mesh->timeSegment(time,ftime);
+      Vec3<vfloat<K>> p0, p1;
+      for (size_t k=0; k<K; k++)
+      {
+        const Vec3fa v0 = mesh->vertex(v[index],itime[k]+0);
+        const Vec3fa v1 = mesh->vertex(v[index],itime[k]+1);
+        p0.x[k] = v0.x; p0.y[k] = v0.y; p0.z[k] = v0.z;
+        p1.x[k] = v1.x; p1.y[k] = v1.y; p1.z[k] = v1.z;
+      }
+      return (vfloat<K>(one)-ftime)*p0 + ftime*p1;
     }
 
+    /* gather the quads of the itime'th timestep of each quad */
+    __forceinline void gather(Vec3<vfloat<M>>& p0, 
+                              Vec3<vfloat<M>>& p1, 
+                              Vec3<vfloat<M>>& p2, 
+                              Vec3<vfloat<M>>& p3,
+                              const Scene *const scene,
+                              const vint<M>& itime) const;
+
     /* gather the quads */
     __forceinline void gather(Vec3<vfloat<M>>& p0, 
                               Vec3<vfloat<M>>& p1, 
                               Vec3<vfloat<M>>& p2, 
                               Vec3<vfloat<M>>& p3,
                               const Scene *const scene,
-                              const size_t j) const;
+                              const size_t j) const {
+      gather(p0,p1,p2,p3,scene,vint<M>(int(j)));
+    }
 
     __forceinline void gather(Vec3<vfloat<M>>& p0, 
                               Vec3<vfloat<M>>& p1, 
@@ -146,8 +174,28 @@ namespace embree
     }
 
     
+    /* Calculate the linear bounds of the quads for the time segment that contains the specified time */
+    __forceinline std::pair<BBox3fa,BBox3fa> linearBounds(const Scene *const scene, const float time) const
+    {
+      BBox3fa bounds0 = empty;
+      BBox3fa bounds1 = empty;
+      for (size_t i=0; i<M && valid(i); i++)
+      {
+	const QuadMesh* mesh = scene->getQuadMesh(geomID(i));
+        float ftime; const int itime = mesh->timeSegment(time,ftime);
+        const BBox3fa b0(min(mesh->vertex(v0[i],itime+0),mesh->vertex(v1[i],itime+0),mesh->vertex(v2[i],itime+0),mesh->vertex(v3[i],itime+0)),
+                         max(mesh->vertex(v0[i],itime+0),mesh->vertex(v1[i],itime+0),mesh->vertex(v2[i],itime+0),mesh->vertex(v3[i],itime+0)));
+        const BBox3fa b1(min(mesh->vertex(v0[i],itime+1),mesh->vertex(v1[i],itime+1),mesh->vertex(v2[i],itime+1),mesh->vertex(v3[i],itime+1)),
+                         max(mesh->vertex(v0[i],itime+1),mesh->vertex(v1[i],itime+1),mesh->vertex(v2[i],itime+1),mesh->vertex(v3[i],itime+1)));
+        const std::pair<BBox3fa,BBox3fa> b = mesh->linearBounds(itime,b0,b1);
+        bounds0.extend(b.first);
+        bounds1.extend(b.second);
+      }
+      return std::make_pair(bounds0,bounds1);
+    }
+    
     /* Fill quad from quad list */
-    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, const BBox1f& time_range = BBox1f(0.0f,1.0f))
     {
       vint<M> geomID = -1, primID = -1;
       vint<M> v0 = zero, v1 = zero, v2 = zero, v3 = zero;
@@ -178,7 +226,7 @@ namespace embree
       }
       
       new (this) QuadMiMB(v0,v1,v2,v3,geomID,primID); // FIXME: use non temporal store
-      return bounds(scene);
+      return linearBounds(scene,0.5f*(time_range.lower+time_range.upper));
     }
     
     /* Updates the primitive */
@@ -215,38 +263,38 @@ namespace embree
                                            Vec3vf4& p2, 
                                            Vec3vf4& p3,
                                            const Scene *const scene,
-                                           const size_t j) const
+                                           const vint4& itime) const
   {
     const QuadMesh* mesh0 = scene->getQuadMesh(geomIDs[0]);
     const QuadMesh* mesh1 = scene->getQuadMesh(geomIDs[1]);
     const QuadMesh* mesh2 = scene->getQuadMesh(geomIDs[2]);
     const QuadMesh* mesh3 = scene->getQuadMesh(geomIDs[3]);
 
-    const vfloat4 a0 = vfloat4::loadu(mesh0->vertexPtr(v0[0],j));
-    const vfloat4 a1 = vfloat4::loadu(mesh1->vertexPtr(v0[1],j));
-    const vfloat4 a2 = vfloat4::loadu(mesh2->vertexPtr(v0[2],j));
-    const vfloat4 a3 = vfloat4::loadu(mesh3->vertexPtr(v0[3],j));
+    const vfloat4 a0 = vfloat4::loadu(mesh0->vertexPtr(v0[0],itime[0]));
+    const vfloat4 a1 = vfloat4::loadu(mesh1->vertexPtr(v0[1],itime[1]));
+    const vfloat4 a2 = vfloat4::loadu(mesh2->vertexPtr(v0[2],itime[2]));
+    const vfloat4 a3 = vfloat4::loadu(mesh3->vertexPtr(v0[3],itime[3]));
 
     transpose(a0,a1,a2,a3,p0.x,p0.y,p0.z);
 
-    const vfloat4 b0 = vfloat4::loadu(mesh0->vertexPtr(v1[0],j));
-    const vfloat4 b1 = vfloat4::loadu(mesh1->vertexPtr(v1[1],j));
-    const vfloat4 b2 = vfloat4::loadu(mesh2->vertexPtr(v1[2],j));
-    const vfloat4 b3 = vfloat4::loadu(mesh3->vertexPtr(v1[3],j));
+    const vfloat4 b0 = vfloat4::loadu(mesh0->vertexPtr(v1[0],itime[0]));
+    const vfloat4 b1 = vfloat4::loadu(mesh1->vertexPtr(v1[1],itime[1]));
+    const vfloat4 b2 = vfloat4::loadu(mesh2->vertexPtr(v1[2],itime[2]));
+    const vfloat4 b3 = vfloat4::loadu(mesh3->vertexPtr(v1[3],itime[3]));
 
     transpose(b0,b1,b2,b3,p1.x,p1.y,p1.z);
 
-    const vfloat4 c0 = vfloat4::loadu(mesh0->vertexPtr(v2[0],j));
-    const vfloat4 c1 = vfloat4::loadu(mesh1->vertexPtr(v2[1],j));
-    const vfloat4 c2 = vfloat4::loadu(mesh2->vertexPtr(v2[2],j));
-    const vfloat4 c3 = vfloat4::loadu(mesh3->vertexPtr(v2[3],j));
+    const vfloat4 c0 = vfloat4::loadu(mesh0->vertexPtr(v2[0],itime[0]));
+    const vfloat4 c1 = vfloat4::loadu(mesh1->vertexPtr(v2[1],itime[1]));
+    const vfloat4 c2 = vfloat4::loadu(mesh2->vertexPtr(v2[2],itime[2]));
+    const vfloat4 c3 = vfloat4::loadu(mesh3->vertexPtr(v2[3],itime[3]));
 
     transpose(c0,c1,c2,c3,p2.x,p2.y,p2.z);
 
-    const vfloat4 d0 = vfloat4::loadu(mesh0->vertexPtr(v3[0],j));
-    const vfloat4 d1 = vfloat4::loadu(mesh1->vertexPtr(v3[1],j));
-    const vfloat4 d2 = vfloat4::loadu(mesh2->vertexPtr(v3[2],j));
-    const vfloat4 d3 = vfloat4::loadu(mesh3->vertexPtr(v3[3],j));
+    const vfloat4 d0 = vfloat4::loadu(mesh0->vertexPtr(v3[0],itime[0]));
+    const vfloat4 d1 = vfloat4::loadu(mesh1->vertexPtr(v3[1],itime[1]));
+    const vfloat4 d2 = vfloat4::loadu(mesh2->vertexPtr(v3[2],itime[2]));
+    const vfloat4 d3 = vfloat4::loadu(mesh3->vertexPtr(v3[3],itime[3]));
 
     transpose(d0,d1,d2,d3,p3.x,p3.y,p3.z);
   }
@@ -261,12 +309,23 @@ namespace embree
                                            const Scene *const scene,
                                            const float t) const
   {
-    const vfloat4 t0 = 1.0f - t;
-    const vfloat4 t1 = t;
+    const QuadMesh* mesh0 = scene->getQuadMesh(geomIDs[0]);
+    const QuadMesh* mesh1 = scene->getQuadMesh(geomIDs[1]);
+    const QuadMesh* mesh2 = scene->getQuadMesh(geomIDs[2]);
+    const QuadMesh* mesh3 = scene->getQuadMesh(geomIDs[3]);
+
+    /* the quads may come from meshes with different number of time steps */
+    float ftime0, ftime1, ftime2, ftime3;
+    const vint4 itime(mesh0->timeSegment(t,ftime0),
+                      mesh1->timeSegment(t,ftime1),
+                      mesh2->timeSegment(t,ftime2),
+                      mesh3->timeSegment(t,ftime3));
+    const vfloat4 t1(ftime0,ftime1,ftime2,ftime3);
+    const vfloat4 t0 = 1.0f - t1;
     Vec3vf4 a0,a1,a2,a3;
-    gather(a0,a1,a2,a3,scene,(size_t)0);
+    gather(a0,a1,a2,a3,scene,itime);
     Vec3vf4 b0,b1,b2,b3;
-    gather(b0,b1,b2,b3,scene,(size_t)1);
+    gather(b0,b1,b2,b3,scene,itime+1);
     p0 = t0 * a0 + t1 * b0;
     p1 = t0 * a1 + t1 * b1;
     p2 = t0 * a2 + t1 * b2;
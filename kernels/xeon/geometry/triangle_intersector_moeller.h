@@ -18,6 +18,7 @@
 
 #include "triangle.h"
 #include "trianglev_mb.h"
+#include "triangleq.h"
 #include "intersector_epilog.h"
 
 /*! This intersector implements a modified version of the Moeller
@@ -478,5 +479,87 @@ namespace embree
           return pre.intersect1(ray,k,v0,v1,v2,Occluded1KEpilogM<M,Mx,K,filter>(ray,k,context,tri.geomIDs,tri.primIDs,scene)); 
         }
       };
+
+    /*! Intersects M quantized triangles with 1 ray */
+    template<int M, bool filter>
+      struct TriangleMqIntersector1MoellerTrumbore
+      {
+        typedef TriangleMq<M> Primitive;
+        typedef MoellerTrumboreIntersector1<M> Precalculations;
+        
+        /*! Intersect a ray with the M triangles and updates the hit. */
+        static __forceinline void intersect(const Precalculations& pre, Ray& ray, const RTCIntersectContext* context, const TriangleMq<M>& tri, Scene* scene, const unsigned* geomID_to_instID)
+        {
+          STAT3(normal.trav_prims,1,1,1);
+          Vec3<vfloat<M>> v0,v1,v2; tri.gather(v0,v1,v2);
+          pre.intersect(ray,v0,v1,v2,Intersect1EpilogM<M,M,filter>(ray,context,tri.geomIDs,tri.primIDs,scene,geomID_to_instID)); 
+        }
+        
+        /*! Test if the ray is occluded by one of M triangles. */
+        static __forceinline bool occluded(const Precalculations& pre, Ray& ray, const RTCIntersectContext* context, const TriangleMq<M>& tri, Scene* scene, const unsigned* geomID_to_instID)
+        {
+          STAT3(shadow.trav_prims,1,1,1);
+          Vec3<vfloat<M>> v0,v1,v2; tri.gather(v0,v1,v2);
+          return pre.intersect(ray,v0,v1,v2,Occluded1EpilogM<M,M,filter>(ray,context,tri.geomIDs,tri.primIDs,scene,geomID_to_instID)); 
+        }
+      };
+    
+    /*! Intersects M quantized triangles with K rays. */
+    template<int M, int K, bool filter>
+      struct TriangleMqIntersectorKMoellerTrumbore
+      {
+        typedef TriangleMq<M> Primitive;
+        typedef MoellerTrumboreIntersectorK<M,K> Precalculations;
+        
+        /*! Intersects K rays with M triangles. */
+        static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, const RTCIntersectContext* context, const TriangleMq<M>& tri, Scene* scene)
+        {
+          Vec3<vfloat<M>> v0,v1,v2; tri.gather(v0,v1,v2);
+          for (size_t i=0; i<TriangleMq<M>::max_size(); i++)
+          {
+            if (!tri.valid(i)) break;
+            STAT3(normal.trav_prims,1,popcnt(valid_i),K);
+            const Vec3<vfloat<K>> p0 = broadcast<vfloat<K>>(v0,i);
+            const Vec3<vfloat<K>> p1 = broadcast<vfloat<K>>(v1,i);
+            const Vec3<vfloat<K>> p2 = broadcast<vfloat<K>>(v2,i);
+            pre.intersectK(valid_i,ray,p0,p1,p2,IntersectKEpilogM<M,K,filter>(ray,context,tri.geomIDs,tri.primIDs,i,scene));
+          }
+        }
+        
+        /*! Test for K rays if they are occluded by any of the M triangles. */
+        static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, const RTCIntersectContext* context, const TriangleMq<M>& tri, Scene* scene)
+        {
+          vbool<K> valid0 = valid_i;
+          Vec3<vfloat<M>> v0,v1,v2; tri.gather(v0,v1,v2);
+          
+          for (size_t i=0; i<TriangleMq<M>::max_size(); i++)
+          {
+            if (!tri.valid(i)) break;
+            STAT3(shadow.trav_prims,1,popcnt(valid0),K);
+            const Vec3<vfloat<K>> p0 = broadcast<vfloat<K>>(v0,i);
+            const Vec3<vfloat<K>> p1 = broadcast<vfloat<K>>(v1,i);
+            const Vec3<vfloat<K>> p2 = broadcast<vfloat<K>>(v2,i);
+            pre.intersectK(valid0,ray,p0,p1,p2,OccludedKEpilogM<M,K,filter>(valid0,ray,context,tri.geomIDs,tri.primIDs,i,scene));
+            if (none(valid0)) break;
+          }
+          return !valid0;
+        }
+        
+        /*! Intersect a ray with M triangles and updates the hit. */
+        static __forceinline void intersect(Precalculations& pre, RayK<K>& ray, size_t k, const RTCIntersectContext* context, const TriangleMq<M>& tri, Scene* scene)
+        {
+          STAT3(normal.trav_prims,1,1,1);
+          Vec3<vfloat<M>> v0,v1,v2; tri.gather(v0,v1,v2);
+          pre.intersect1(ray,k,v0,v1,v2,Intersect1KEpilogM<M,M,K,filter>(ray,k,context,tri.geomIDs,tri.primIDs,scene)); 
+        }
+        
+        /*! Test if the ray is occluded by one of the M triangles. */
+        static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, const RTCIntersectContext* context, const TriangleMq<M>& tri, Scene* scene)
+        {
+          STAT3(shadow.trav_prims,1,1,1);
+          Vec3<vfloat<M>> v0,v1,v2; tri.gather(v0,v1,v2);
+          return pre.intersect1(ray,k,v0,v1,v2,Occluded1KEpilogM<M,M,K,filter>(ray,k,context,tri.geomIDs,tri.primIDs,scene)); 
+        }
+      };
   }
 }
@@ -0,0 +1,204 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "primitive.h"
+#include "trianglev.h"
+
+namespace embree
+{
+  /* Stores the vertices of M triangles quantized to 16 bits relative
+   * to the bounds of the M triangles */
+  template <int M>
+  struct TriangleMq
+  {
+    typedef Vec3<vfloat<M>> Vec3vfM;
+
+  public:
+    struct Type : public PrimitiveType
+    {
+      Type();
+      size_t size(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximal number of stored triangles */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N primitives */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+  public:
+
+    /* Default constructor */
+    __forceinline TriangleMq() {}
+
+    /* Construction from vertices and IDs */
+    __forceinline TriangleMq(const Vec3vfM& v0, const Vec3vfM& v1, const Vec3vfM& v2, const vint<M>& geomIDs, const vint<M>& primIDs)
+      : geomIDs(geomIDs), primIDs(primIDs)
+    {
+      /* calculate quantization frame from the bounds of the valid triangles */
+      const vbool<M> mask = geomIDs != vint<M>(-1);
+      const Vec3vfM vlower = min(v0,v1,v2);
+      const Vec3vfM vupper = max(v0,v1,v2);
+      const Vec3fa lower(reduce_min(select(mask,vlower.x,vfloat<M>(pos_inf))),
+                         reduce_min(select(mask,vlower.y,vfloat<M>(pos_inf))),
+                         reduce_min(select(mask,vlower.z,vfloat<M>(pos_inf))));
+      const Vec3fa upper(reduce_max(select(mask,vupper.x,vfloat<M>(neg_inf))),
+                         reduce_max(select(mask,vupper.y,vfloat<M>(neg_inf))),
+                         reduce_max(select(mask,vupper.z,vfloat<M>(neg_inf))));
+      const Vec3fa extent = upper-lower;
+      this->lower = Vec3f(lower.x,lower.y,lower.z);
+      this->extent = Vec3f(extent.x,extent.y,extent.z);
+
+      /* quantize all vertices, invalid triangles get mapped to the lower corner */
+      const Vec3vfM vlo(lower.x,lower.y,lower.z);
+      const Vec3vfM vscale(quantizationScale(extent.x),quantizationScale(extent.y),quantizationScale(extent.z));
+      quantize(qv0,v0,vlo,vscale,mask);
+      quantize(qv1,v1,vlo,vscale,mask);
+      quantize(qv2,v2,vlo,vscale,mask);
+    }
+
+    /* Returns a mask that tells which triangles are valid */
+    __forceinline vbool<M> valid() const { return geomIDs != vint<M>(-1); }
+
+    /* Returns true if the specified triangle is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return geomIDs[i] != -1; }
+
+    /* Returns the number of stored triangles */
+    __forceinline size_t size() const { return __bsf(~movemask(valid())); }
+
+    /* Returns the geometry IDs */
+    __forceinline vint<M> geomID() const { return geomIDs; }
+    __forceinline int geomID(const size_t i) const { assert(i<M); return geomIDs[i]; }
+
+    /* Returns the primitive IDs */
+    __forceinline vint<M> primID() const { return primIDs; }
+    __forceinline int  primID(const size_t i) const { assert(i<M); return primIDs[i]; }
+
+    /* Dequantizes the vertices of the triangles */
+    __forceinline void gather(Vec3vfM& v0, Vec3vfM& v1, Vec3vfM& v2) const
+    {
+      const Vec3vfM vlower(lower.x,lower.y,lower.z);
+      const Vec3vfM vextent(extent.x,extent.y,extent.z);
+      v0 = dequantize(qv0,vlower,vextent);
+      v1 = dequantize(qv1,vlower,vextent);
+      v2 = dequantize(qv2,vlower,vextent);
+    }
+
+    /* Calculate the bounds of the triangles */
+    __forceinline BBox3fa bounds() const
+    {
+      Vec3vfM v0,v1,v2; gather(v0,v1,v2);
+      return TriangleMv<M>(v0,v1,v2,geomIDs,primIDs).bounds();
+    }
+
+    /* Fill triangle from triangle list */
+    __forceinline void fill(atomic_set<PrimRefBlock>::block_iterator_unsafe& prims, Scene* scene, const bool list)
+    {
+      vint<M> vgeomID = -1, vprimID = -1;
+      Vec3vfM v0 = zero, v1 = zero, v2 = zero;
+
+      for (size_t i=0; i<M && prims; i++, prims++)
+      {
+	const PrimRef& prim = *prims;
+	const size_t geomID = prim.geomID();
+        const size_t primID = prim.primID();
+        const TriangleMesh* __restrict__ const mesh = scene->getTriangleMesh(geomID);
+        const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+        const Vec3fa& p0 = mesh->vertex(tri.v[0]);
+        const Vec3fa& p1 = mesh->vertex(tri.v[1]);
+        const Vec3fa& p2 = mesh->vertex(tri.v[2]);
+        vgeomID [i] = geomID;
+        vprimID [i] = primID;
+        v0.x[i] = p0.x; v0.y[i] = p0.y; v0.z[i] = p0.z;
+        v1.x[i] = p1.x; v1.y[i] = p1.y; v1.z[i] = p1.z;
+        v2.x[i] = p2.x; v2.y[i] = p2.y; v2.z[i] = p2.z;
+      }
+      new (this) TriangleMq(v0,v1,v2,vgeomID,vprimID);
+    }
+
+    /* Fill triangle from triangle list */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    {
+      vint<M> vgeomID = -1, vprimID = -1;
+      Vec3vfM v0 = zero, v1 = zero, v2 = zero;
+
+      for (size_t i=0; i<M && begin<end; i++, begin++)
+      {
+	const PrimRef& prim = prims[begin];
+        const size_t geomID = prim.geomID();
+        const size_t primID = prim.primID();
+        const TriangleMesh* __restrict__ const mesh = scene->getTriangleMesh(geomID);
+        const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+        const Vec3fa& p0 = mesh->vertex(tri.v[0]);
+        const Vec3fa& p1 = mesh->vertex(tri.v[1]);
+        const Vec3fa& p2 = mesh->vertex(tri.v[2]);
+        vgeomID [i] = geomID;
+        vprimID [i] = primID;
+        v0.x[i] = p0.x; v0.y[i] = p0.y; v0.z[i] = p0.z;
+        v1.x[i] = p1.x; v1.y[i] = p1.y; v1.z[i] = p1.z;
+        v2.x[i] = p2.x; v2.y[i] = p2.y; v2.z[i] = p2.z;
+      }
+      new (this) TriangleMq(v0,v1,v2,vgeomID,vprimID);
+    }
+
+  private:
+
+    /* scale that maps the extent of the bounds to the 16 bit range */
+    static __forceinline float quantizationScale(const float extent) {
+      return extent > 0.0f ? 65535.0f/extent : 0.0f;
+    }
+
+    static __forceinline void quantize(unsigned short q[3][M], const Vec3vfM& v, const Vec3vfM& lower, const Vec3vfM& scale, const vbool<M>& mask)
+    {
+      const Vec3vfM p = (v-lower)*scale;
+      const vint<M> qx = select(mask,vint<M>(clamp(floor(p.x+vfloat<M>(0.5f)),vfloat<M>(zero),vfloat<M>(65535.0f))),vint<M>(zero));
+      const vint<M> qy = select(mask,vint<M>(clamp(floor(p.y+vfloat<M>(0.5f)),vfloat<M>(zero),vfloat<M>(65535.0f))),vint<M>(zero));
+      const vint<M> qz = select(mask,vint<M>(clamp(floor(p.z+vfloat<M>(0.5f)),vfloat<M>(zero),vfloat<M>(65535.0f))),vint<M>(zero));
+      for (size_t i=0; i<M; i++) {
+        q[0][i] = (unsigned short) qx[i];
+        q[1][i] = (unsigned short) qy[i];
+        q[2][i] = (unsigned short) qz[i];
+      }
+    }
+
+    /* loads the normalized 16 bit coordinates and scales them into the bounds */
+    static __forceinline Vec3vfM dequantize(const unsigned short q[3][M], const Vec3vfM& lower, const Vec3vfM& extent)
+    {
+      return Vec3vfM(madd(vfloat<M>::load(q[0]),extent.x,lower.x),
+                     madd(vfloat<M>::load(q[1]),extent.y,lower.y),
+                     madd(vfloat<M>::load(q[2]),extent.z,lower.z));
+    }
+
+  public:
+    unsigned short qv0[3][M]; // 1st vertex of the triangles quantized in x,y,z
+    unsigned short qv1[3][M]; // 2nd vertex of the triangles quantized in x,y,z
+    unsigned short qv2[3][M]; // 3rd vertex of the triangles quantized in x,y,z
+    Vec3f lower;              // lower bounds of the triangles
+    Vec3f extent;             // extent of the bounds of the triangles
+    vint<M> geomIDs;          // geometry ID
+    vint<M> primIDs;          // primitive ID
+  };
+
+  template<int M>
+  typename TriangleMq<M>::Type TriangleMq<M>::type;
+
+  typedef TriangleMq<4> Triangle4q;
+}
@@ -144,8 +144,8 @@ namespace embree
       new (this) TriangleMvMB(va0,va1,vb0,vb1,vc0,vc1,vgeomID,vprimID); // FIXME: store_nt
     }
     
-    /* Fill triangle from triangle list */
-    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    /* Fill triangle from triangle list, the triangles move linearly inside the time segment that contains the specified time range */
+    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, const BBox1f& time_range = BBox1f(0.0f,1.0f))
     {
       vint<M> vgeomID = -1, vprimID = -1;
       Vec3vfM va0 = zero, vb0 = zero, vc0 = zero;
@@ -153,6 +153,7 @@ namespace embree
 
       BBox3fa bounds0 = empty;
       BBox3fa bounds1 = empty;
+      const float time = 0.5f*(time_range.lower+time_range.upper);
       
       for (size_t i=0; i<M && begin<end; i++, begin++)
       {
@@ -161,12 +162,16 @@ namespace embree
         const size_t primID = prim.primID();
         const TriangleMesh* __restrict__ const mesh = scene->getTriangleMesh(geomID);
         const TriangleMesh::Triangle& tri = mesh->triangle(primID);
-	const Vec3fa& a0 = mesh->vertex(tri.v[0],0); bounds0.extend(a0);
-	const Vec3fa& a1 = mesh->vertex(tri.v[0],1); bounds1.extend(a1);
-        const Vec3fa& b0 = mesh->vertex(tri.v[1],0); bounds0.extend(b0);
-	const Vec3fa& b1 = mesh->vertex(tri.v[1],1); bounds1.extend(b1);
-        const Vec3fa& c0 = mesh->vertex(tri.v[2],0); bounds0.extend(c0);
-	const Vec3fa& c1 = mesh->vertex(tri.v[2],1); bounds1.extend(c1);
+        float ftime; const int itime = mesh->timeSegment(time,ftime);
+	Vec3fa a0 = mesh->vertex(tri.v[0],itime+0);
+	Vec3fa a1 = mesh->vertex(tri.v[0],itime+1);
+        Vec3fa b0 = mesh->vertex(tri.v[1],itime+0);
+	Vec3fa b1 = mesh->vertex(tri.v[1],itime+1);
+        Vec3fa c0 = mesh->vertex(tri.v[2],itime+0);
+	Vec3fa c1 = mesh->vertex(tri.v[2],itime+1);
+        mesh->linearMotion(itime,a0,a1); bounds0.extend(a0); bounds1.extend(a1);
+        mesh->linearMotion(itime,b0,b1); bounds0.extend(b0); bounds1.extend(b1);
+        mesh->linearMotion(itime,c0,c1); bounds0.extend(c0); bounds1.extend(c1);
         vgeomID [i] = geomID;
         vprimID [i] = primID;
         va0.x[i] = a0.x; va0.y[i] = a0.y; va0.z[i] = a0.z;
@@ -18,6 +18,7 @@
 #include "../include/embree2/rtcore.h"
 #include "../include/embree2/rtcore_ray.h"
 #include "../kernels/algorithms/parallel_for.h"
+#include "../kernels/algorithms/sort.h"
 #include <vector>
 
 #if defined(RTCORE_RAY_PACKETS)
@@ -457,6 +458,65 @@ namespace embree
 
   char* benchmark_bandwidth::ptr = nullptr;
 
+  class benchmark_parallel_for : public Benchmark
+  {
+  public:
+    size_t N; size_t blockSize; size_t work;
+    benchmark_parallel_for (const std::string& name, size_t N, size_t blockSize, size_t work) 
+      : Benchmark(name,"Mitems/s"), N(N), blockSize(blockSize), work(work) {}
+
+    double run (size_t numThreads)
+    {
+      RTCDevice device = rtcNewDevice((g_rtcore+",threads="+toString(numThreads)).c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      std::vector<float> data(N,1.0f);
+      auto body = [&](const range<size_t>& r) {
+        for (size_t i=r.begin(); i<r.end(); i++) {
+          float x = data[i];
+          for (size_t j=0; j<work; j++) x = x*0.999f+0.001f;
+          data[i] = x;
+        }
+      };
+
+      /* first run starts the worker threads */
+      parallel_for(size_t(0),N,blockSize,body);
+      double t0 = getSeconds();
+      parallel_for(size_t(0),N,blockSize,body);
+      double t1 = getSeconds();
+      rtcDeleteDevice(device);
+
+      return 1E-6*double(N)/(t1-t0);
+    }
+  };
+
+  class benchmark_radix_sort : public Benchmark
+  {
+  public:
+    size_t N;
+    benchmark_radix_sort (const std::string& name, size_t N) 
+      : Benchmark(name,"Mkeys/s"), N(N) {}
+
+    double run (size_t numThreads)
+    {
+      RTCDevice device = rtcNewDevice((g_rtcore+",threads="+toString(numThreads)).c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      std::vector<uint64_t> keys(N), tmp(N);
+      for (size_t i=0; i<N; i++) keys[i] = uint64_t(rand())*uint64_t(rand());
+
+      /* first run starts the worker threads */
+      radix_sort<uint64_t>(keys.data(),tmp.data(),N);
+      for (size_t i=0; i<N; i++) keys[i] = uint64_t(rand())*uint64_t(rand());
+      double t0 = getSeconds();
+      radix_sort<uint64_t>(keys.data(),tmp.data(),N);
+      double t1 = getSeconds();
+      rtcDeleteDevice(device);
+
+      return 1E-6*double(N)/(t1-t0);
+    }
+  };
+
 
   RTCRay makeRay(const Vec3fa &org, const Vec3fa &dir) 
   {
@@ -601,6 +661,43 @@ namespace embree
     }
   }
 
+  void createGridMesh (const Vec3f pos, const float size, size_t numCells, Mesh& mesh_o)
+  {
+    const size_t base = mesh_o.vertices.size();
+    for (size_t y=0; y<=numCells; y++)
+    {
+      for (size_t x=0; x<=numCells; x++)
+      {
+        const float fx = float(x)/float(numCells);
+        const float fy = float(y)/float(numCells);
+        Vertex v;
+        v.x = pos.x + size*fx;
+        v.y = pos.y + 0.05f*size*sin(10.0f*fx)*cos(10.0f*fy);
+        v.z = pos.z + size*fy;
+        v.a = 0.0f;
+        mesh_o.vertices.push_back(v);
+      }
+      if (y == 0) continue;
+
+      for (size_t x=1; x<=numCells; x++)
+      {
+        int p00 = base+(y-1)*(numCells+1)+x-1;
+        int p01 = base+(y-1)*(numCells+1)+x;
+        int p10 = base+y*(numCells+1)+x-1;
+        int p11 = base+y*(numCells+1)+x;
+        Triangle t0 = { p00, p01, p10 }; mesh_o.triangles.push_back(t0);
+        Triangle t1 = { p01, p11, p10 }; mesh_o.triangles.push_back(t1);
+      }
+    }
+  }
+
+  /* large terrain with a small but densely tessellated region, similar to a city scan */
+  void createTerrainMesh (size_t numCells, size_t numDetailCells, Mesh& mesh_o)
+  {
+    createGridMesh(Vec3f(0.0f),1000.0f,numCells,mesh_o);
+    createGridMesh(Vec3f(500.0f,50.0f,500.0f),1.0f,numDetailCells,mesh_o);
+  }
+
   unsigned addSphere (RTCScene scene, RTCGeometryFlags flag, const Vec3f pos, const float r, size_t numPhi)
   {
     Mesh mesh; createSphereMesh (pos, r, numPhi, mesh);
@@ -666,6 +763,19 @@ namespace embree
     }
   }
 
+  unsigned addHairball (RTCScene scene, RTCGeometryFlags flag, const Vec3fa& pos, const float r, size_t numHairs)
+  {
+    LineSegments hairset; createHairball (pos, r, 3*numHairs, hairset);
+    const size_t numCurves = hairset.lines.size()/3;
+    unsigned geom = rtcNewHairGeometry (scene, flag, numCurves, hairset.vertices.size());
+    memcpy(rtcMapBuffer(scene,geom,RTC_VERTEX_BUFFER), hairset.vertices.data(), hairset.vertices.size()*sizeof(Vec3fa));
+    int* curves = (int*) rtcMapBuffer(scene,geom,RTC_INDEX_BUFFER);
+    for (size_t i=0; i<numCurves; i++) curves[i] = hairset.lines[3*i];
+    rtcUnmapBuffer(scene,geom,RTC_VERTEX_BUFFER);
+    rtcUnmapBuffer(scene,geom,RTC_INDEX_BUFFER);
+    return geom;
+  }
+
   class create_geometry : public Benchmark
   {
   public:
@@ -803,13 +913,13 @@ namespace embree
   class update_geometry : public Benchmark
   {
   public:
-    RTCGeometryFlags flags; size_t numPhi; size_t numMeshes;
-    update_geometry(const std::string& name, RTCGeometryFlags flags, size_t numPhi, size_t numMeshes)
-      : Benchmark(name,"Mtris/s"), flags(flags), numPhi(numPhi), numMeshes(numMeshes) {}
+    RTCGeometryFlags flags; size_t numPhi; size_t numMeshes; std::string cfg;
+    update_geometry(const std::string& name, RTCGeometryFlags flags, size_t numPhi, size_t numMeshes, const std::string& cfg = "")
+      : Benchmark(name,"Mtris/s"), flags(flags), numPhi(numPhi), numMeshes(numMeshes), cfg(cfg) {}
   
     double run(size_t numThreads)
     {
-      RTCDevice device = rtcNewDevice((g_rtcore+",threads="+toString(numThreads)).c_str());
+      RTCDevice device = rtcNewDevice((g_rtcore+",threads="+toString(numThreads)+cfg).c_str());
       error_handler(rtcDeviceGetError(device));
 
       Mesh mesh; createSphereMesh (Vec3f(0,0,0), 1, numPhi, mesh);
@@ -842,6 +952,50 @@ namespace embree
     }
   };
 
+  class update_subdiv_geometry : public Benchmark
+  {
+  public:
+    size_t numPhi; size_t numMeshes; bool topology;
+    update_subdiv_geometry(const std::string& name, size_t numPhi, size_t numMeshes, bool topology)
+      : Benchmark(name,"Mfaces/s"), numPhi(numPhi), numMeshes(numMeshes), topology(topology) {}
+  
+    double run(size_t numThreads)
+    {
+      RTCDevice device = rtcNewDevice((g_rtcore+",threads="+toString(numThreads)).c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      Mesh mesh; createSphereMesh (Vec3f(0,0,0), 1, numPhi, mesh);
+      std::vector<int> faces(mesh.triangles.size(),3);
+      RTCScene scene = rtcDeviceNewScene(device,RTC_SCENE_DYNAMIC,aflags);
+      
+      for (size_t i=0; i<numMeshes; i++) 
+      {
+        unsigned geom = rtcNewSubdivisionMesh (scene, RTC_GEOMETRY_DYNAMIC, faces.size(), 3*mesh.triangles.size(), mesh.vertices.size(), 0, 0, 0);
+        memcpy(rtcMapBuffer(scene,geom,RTC_VERTEX_BUFFER), &mesh.vertices[0], mesh.vertices.size()*sizeof(Vertex));
+        memcpy(rtcMapBuffer(scene,geom,RTC_INDEX_BUFFER ), &mesh.triangles[0], mesh.triangles.size()*sizeof(Triangle));
+        memcpy(rtcMapBuffer(scene,geom,RTC_FACE_BUFFER  ), &faces[0], faces.size()*sizeof(int));
+        rtcUnmapBuffer(scene,geom,RTC_VERTEX_BUFFER);
+        rtcUnmapBuffer(scene,geom,RTC_INDEX_BUFFER);
+        rtcUnmapBuffer(scene,geom,RTC_FACE_BUFFER);
+      }
+      rtcCommit (scene);
+
+      /* either the full topology changes or only the vertices move and the half edges get reused */
+      double t0 = getSeconds();
+      for (size_t i=0; i<numMeshes; i++) {
+        if (topology) rtcUpdate(scene,i);
+        else rtcUpdateBuffer(scene,i,RTC_VERTEX_BUFFER);
+      }
+      rtcCommit (scene);
+      double t1 = getSeconds();
+      rtcDeleteScene(scene);
+      rtcDeleteDevice(device);
+      
+      size_t numFaces = faces.size() * numMeshes;
+      return 1E-6*double(numFaces)/(t1-t0);
+    }
+  };
+
   class update_geometry_line : public Benchmark
   {
   public:
@@ -887,9 +1041,9 @@ namespace embree
   class update_scenes : public Benchmark
   {
   public:
-    RTCGeometryFlags flags; size_t numPhi; size_t numMeshes;
-    update_scenes(const std::string& name, RTCGeometryFlags flags, size_t numPhi, size_t numMeshes)
-      : Benchmark(name,"Mtris/s"), flags(flags), numPhi(numPhi), numMeshes(numMeshes) {}
+    RTCGeometryFlags flags; size_t numPhi; size_t numMeshes; size_t numObjects; size_t numModified;
+    update_scenes(const std::string& name, RTCGeometryFlags flags, size_t numPhi, size_t numMeshes, size_t numObjects = 1, size_t numModified = 1)
+      : Benchmark(name,"Mtris/s"), flags(flags), numPhi(numPhi), numMeshes(numMeshes), numObjects(numObjects), numModified(numModified) {}
   
     double run(size_t numThreads)
     {
@@ -902,23 +1056,28 @@ namespace embree
       for (size_t i=0; i<numMeshes; i++) 
       {
         RTCScene scene = rtcDeviceNewScene(device,RTC_SCENE_DYNAMIC,aflags);
-	unsigned geom = rtcNewTriangleMesh (scene, flags, mesh.triangles.size(), mesh.vertices.size());
-	memcpy(rtcMapBuffer(scene,geom,RTC_VERTEX_BUFFER), &mesh.vertices[0], mesh.vertices.size()*sizeof(Vertex));
-	memcpy(rtcMapBuffer(scene,geom,RTC_INDEX_BUFFER ), &mesh.triangles[0], mesh.triangles.size()*sizeof(Triangle));
-	rtcUnmapBuffer(scene,geom,RTC_VERTEX_BUFFER);
-	rtcUnmapBuffer(scene,geom,RTC_INDEX_BUFFER);
-	for (size_t i=0; i<mesh.vertices.size(); i++) {
-	  mesh.vertices[i].x += 1.0f;
-	  mesh.vertices[i].y += 1.0f;
-	  mesh.vertices[i].z += 1.0f;
-	}
+        for (size_t j=0; j<numObjects; j++)
+        {
+          unsigned geom = rtcNewTriangleMesh (scene, flags, mesh.triangles.size(), mesh.vertices.size());
+          memcpy(rtcMapBuffer(scene,geom,RTC_VERTEX_BUFFER), &mesh.vertices[0], mesh.vertices.size()*sizeof(Vertex));
+          memcpy(rtcMapBuffer(scene,geom,RTC_INDEX_BUFFER ), &mesh.triangles[0], mesh.triangles.size()*sizeof(Triangle));
+          rtcUnmapBuffer(scene,geom,RTC_VERTEX_BUFFER);
+          rtcUnmapBuffer(scene,geom,RTC_INDEX_BUFFER);
+          for (size_t i=0; i<mesh.vertices.size(); i++) {
+            mesh.vertices[i].x += 1.0f;
+            mesh.vertices[i].y += 1.0f;
+            mesh.vertices[i].z += 1.0f;
+          }
+        }
         scenes.push_back(scene);
         rtcCommit (scene);
       }
             
+      /* only some objects of each scene get modified, spread over the scene */
       double t0 = getSeconds();
       parallel_for( scenes.size(), [&](size_t i) { 
-          rtcUpdate(scenes[i],0); 
+          for (size_t j=0; j<numModified; j++)
+            rtcUpdate(scenes[i],unsigned(j*numObjects/numModified));
           rtcCommit (scenes[i]);
         });
       double t1 = getSeconds();
@@ -927,13 +1086,44 @@ namespace embree
       rtcDeleteDevice(device);
       
       //return 1000.0f*(t1-t0);
-      size_t numTriangles = mesh.triangles.size() * numMeshes;
+      size_t numTriangles = mesh.triangles.size() * numMeshes * numModified;
       return 1E-6*double(numTriangles)/(t1-t0);
     }
   };
 
 
 
+  class build_morton_scenes : public Benchmark
+  {
+  public:
+    size_t mortonCodeBits; size_t numCells; size_t numDetailCells;
+    build_morton_scenes(const std::string& name, size_t mortonCodeBits, size_t numCells, size_t numDetailCells)
+      : Benchmark(name,"Mtris/s"), mortonCodeBits(mortonCodeBits), numCells(numCells), numDetailCells(numDetailCells) {}
+  
+    double run(size_t numThreads)
+    {
+      /* run with -rtcore benchmark=1 to also get the SAH cost of the build */
+      RTCDevice device = rtcNewDevice((g_rtcore+",threads="+toString(numThreads)+",morton_code_bits="+toString(mortonCodeBits)).c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      Mesh mesh; createTerrainMesh (numCells, numDetailCells, mesh);
+      
+      RTCScene scene = rtcDeviceNewScene(device,RTC_SCENE_DYNAMIC,aflags);
+      unsigned geom = rtcNewTriangleMesh (scene, RTC_GEOMETRY_DYNAMIC, mesh.triangles.size(), mesh.vertices.size());
+      rtcSetBuffer(scene,geom,RTC_VERTEX_BUFFER,&mesh.vertices[0] ,0,sizeof(Vertex));
+      rtcSetBuffer(scene,geom,RTC_INDEX_BUFFER ,&mesh.triangles[0],0,sizeof(Triangle));
+            
+      double t0 = getSeconds();
+      rtcCommit (scene);
+      double t1 = getSeconds();
+      rtcDeleteScene(scene);
+      rtcDeleteDevice(device);
+      
+      size_t numTriangles = mesh.triangles.size();
+      return 1E-6*double(numTriangles)/(t1-t0);
+    }
+  };
+
   class update_keyframe_scenes : public Benchmark
   {
   public:
@@ -995,9 +1185,14 @@ namespace embree
   public:
     enum { N = 1024*128*2 };
     static RTCScene scene;
+    RTCSceneFlags sflags;
+    bool hair;
 
     benchmark_rtcore_intersect1_throughput () 
-      : Benchmark(intersect ? "incoherent_intersect1_throughput" : "incoherent_occluded1_throughput","MRays/s (all HW threads)") {}
+      : Benchmark(intersect ? "incoherent_intersect1_throughput" : "incoherent_occluded1_throughput","MRays/s (all HW threads)"), sflags(RTC_SCENE_STATIC), hair(false) {}
+
+    benchmark_rtcore_intersect1_throughput (const std::string& name, RTCSceneFlags sflags, bool hair = false) 
+      : Benchmark(name,"MRays/s (all HW threads)"), sflags(sflags), hair(hair) {}
 
     static double benchmark_rtcore_intersect1_throughput_thread(void* arg) 
     {
@@ -1042,9 +1237,9 @@ namespace embree
 
       int numPhi = 501;
 
-      RTCSceneFlags flags = RTC_SCENE_STATIC;
-      scene = rtcDeviceNewScene(device,flags,aflags);
-      addSphere (scene, RTC_GEOMETRY_STATIC, zero, 1, numPhi);
+      scene = rtcDeviceNewScene(device,sflags,aflags);
+      if (hair) addHairball (scene, RTC_GEOMETRY_STATIC, zero, 1, 1000000);
+      else      addSphere (scene, RTC_GEOMETRY_STATIC, zero, 1, numPhi);
       rtcCommit (scene);
 
 
@@ -1361,6 +1556,87 @@ namespace embree
   template<> RTCScene benchmark_rtcore_intersect_stream_throughput<true>::scene = nullptr;
   template<> RTCScene benchmark_rtcore_intersect_stream_throughput<false>::scene = nullptr;
 
+  /* secondary rays starting at random points of the scene with random directions */
+  template<bool sorted>
+  class benchmark_rtcore_intersect_secondary_stream_throughput : public Benchmark
+  {
+  public:
+    enum { N = 1024*128 };
+    static RTCScene scene;
+
+    benchmark_rtcore_intersect_secondary_stream_throughput () 
+      : Benchmark(sorted ? "secondary_intersect_stream_sorted_throughput" : "secondary_intersect_stream_throughput","MRays/s (all HW threads)") {}
+
+    static double benchmark_rtcore_intersect_secondary_stream_throughput_thread(void* arg) 
+    {
+      size_t threadIndex = (size_t) arg;
+
+      srand48(threadIndex*334124);
+      Vec3fa* orgs = new Vec3fa[N];
+      Vec3fa* dirs = new Vec3fa[N];
+      for (size_t i=0; i<N; i++) {
+        orgs[i] = Vec3fa(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        dirs[i] = Vec3fa(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+      }
+
+      g_barrier_active.wait(threadIndex);
+      double t0 = getSeconds();
+
+      const size_t streamSize = 1024;
+      RTCRay* rays = new RTCRay[streamSize];
+      for (size_t p=0;p<g_profile_loop_iterations;p++)
+      for (size_t i=0; i<N; i+=streamSize) 
+      {
+        for (size_t j=0;j<streamSize;j++)        
+          setRay(rays[j],orgs[i+j],dirs[i+j]);
+
+        RTCIntersectContext context;
+        context.flags = sorted ? (RTCIntersectFlags) (RTC_INTERSECT_INCOHERENT | RTC_INTERSECT_SORT) : RTC_INTERSECT_INCOHERENT;
+        context.userRayExt = nullptr;
+        rtcIntersect1M(scene,&context,rays,streamSize,sizeof(RTCRay));
+      }        
+
+      g_barrier_active.wait(threadIndex);
+      double t1 = getSeconds();
+
+      delete [] rays;
+      delete [] orgs;
+      delete [] dirs;
+      return t1-t0;
+    }
+    
+    double run (size_t numThreads)
+    {
+      RTCDevice device = rtcNewDevice((g_rtcore+",threads="+toString(numThreads)).c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      scene = rtcDeviceNewScene(device,RTC_SCENE_STATIC,aflags);
+      for (size_t i=0; i<64; i++) {
+        const Vec3f p(0.5f*float(i%4)-0.75f,0.5f*float((i/4)%4)-0.75f,0.5f*float(i/16)-0.75f);
+        addSphere (scene, RTC_GEOMETRY_STATIC, p, 0.2f, 101);
+      }
+      rtcCommit (scene);
+
+      g_num_threads = numThreads;
+      g_barrier_active.init(numThreads);
+      for (size_t i=1; i<numThreads; i++)
+	g_threads.push_back(createThread((thread_func)benchmark_rtcore_intersect_secondary_stream_throughput_thread,(void*)i,1000000,i));
+      setAffinity(0);
+      
+      double delta = benchmark_rtcore_intersect_secondary_stream_throughput_thread(0);
+
+      for (size_t i=0; i<g_threads.size(); i++)	join(g_threads[i]);
+      g_threads.clear();
+      
+      rtcDeleteScene(scene);
+      rtcDeleteDevice(device);
+      return 1E-6*double(N)/(delta)*double(numThreads);
+    }
+  };
+
+  template<> RTCScene benchmark_rtcore_intersect_secondary_stream_throughput<true>::scene = nullptr;
+  template<> RTCScene benchmark_rtcore_intersect_secondary_stream_throughput<false>::scene = nullptr;
+
 
   class benchmark_rtcore_intersect_coherent_stream_throughput : public Benchmark
   {
@@ -1692,6 +1968,10 @@ namespace embree
 #if 1
     benchmarks.push_back(new benchmark_rtcore_intersect1_throughput<true>());
     benchmarks.push_back(new benchmark_rtcore_intersect1_throughput<false>());
+    benchmarks.push_back(new benchmark_rtcore_intersect1_throughput<true>("incoherent_intersect1_throughput_high_quality",RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_HIGH_QUALITY)));
+    benchmarks.push_back(new benchmark_rtcore_intersect1_throughput<false>("incoherent_occluded1_throughput_high_quality",RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_HIGH_QUALITY)));
+    benchmarks.push_back(new benchmark_rtcore_intersect1_throughput<true>("incoherent_intersect1_throughput_hair",RTC_SCENE_STATIC,true));
+    benchmarks.push_back(new benchmark_rtcore_intersect1_throughput<false>("incoherent_occluded1_throughput_hair",RTC_SCENE_STATIC,true));
 
 #if HAS_INTERSECT16
     if (hasISA(AVX512KNL) || hasISA(KNC)) {
@@ -1712,6 +1992,8 @@ namespace embree
     benchmarks.push_back(new benchmark_rtcore_intersect_stream_throughput<true>());
     benchmarks.push_back(new benchmark_rtcore_intersect_stream_throughput<false>());
     benchmarks.push_back(new benchmark_rtcore_intersect_coherent_stream_throughput());
+    benchmarks.push_back(new benchmark_rtcore_intersect_secondary_stream_throughput<false>());
+    benchmarks.push_back(new benchmark_rtcore_intersect_secondary_stream_throughput<true>());
 #endif
 
     benchmarks.push_back(new benchmark_mutex_sys());
@@ -1719,6 +2001,9 @@ namespace embree
     benchmarks.push_back(new benchmark_barrier_active());
 
     benchmarks.push_back(new benchmark_atomic_inc());
+    benchmarks.push_back(new benchmark_parallel_for("parallel_for_fine_1M",   1024*1024,1,64));
+    benchmarks.push_back(new benchmark_parallel_for("parallel_for_coarse_64M",64*1024*1024,4096,4));
+    benchmarks.push_back(new benchmark_radix_sort("radix_sort_u64_8M",8*1024*1024));
 #if defined(__X86_64__)
     benchmarks.push_back(new benchmark_osmalloc_with_page_commit());
     benchmarks.push_back(new benchmark_pagefaults());
@@ -1738,6 +2023,14 @@ namespace embree
     benchmarks.push_back(new create_geometry ("create_static_geometry_120_10000",RTC_SCENE_STATIC,RTC_GEOMETRY_STATIC,6,8334));
 #endif
 
+    benchmarks.push_back(new create_geometry ("create_compact_geometry_100k",     RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_COMPACT),RTC_GEOMETRY_STATIC,159,1));
+    benchmarks.push_back(new create_geometry ("create_compact_geometry_1000k_1",  RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_COMPACT),RTC_GEOMETRY_STATIC,501,1));
+    benchmarks.push_back(new create_geometry ("create_compact_geometry_10k_100",  RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_COMPACT),RTC_GEOMETRY_STATIC,51,100));
+
+    benchmarks.push_back(new create_geometry ("create_highquality_geometry_100k",     RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_HIGH_QUALITY),RTC_GEOMETRY_STATIC,159,1));
+    benchmarks.push_back(new create_geometry ("create_highquality_geometry_1000k_1",  RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_HIGH_QUALITY),RTC_GEOMETRY_STATIC,501,1));
+    benchmarks.push_back(new create_geometry ("create_highquality_geometry_10k_100",  RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_HIGH_QUALITY),RTC_GEOMETRY_STATIC,51,100));
+
     benchmarks.push_back(new create_geometry ("create_dynamic_geometry_120",      RTC_SCENE_DYNAMIC,RTC_GEOMETRY_STATIC,6,1));
     benchmarks.push_back(new create_geometry ("create_dynamic_geometry_1k" ,      RTC_SCENE_DYNAMIC,RTC_GEOMETRY_STATIC,17,1));
     benchmarks.push_back(new create_geometry ("create_dynamic_geometry_10k",      RTC_SCENE_DYNAMIC,RTC_GEOMETRY_STATIC,51,1));
@@ -1780,6 +2073,17 @@ namespace embree
     benchmarks.push_back(new update_geometry ("update_geometry_120_10000",RTC_GEOMETRY_DYNAMIC,6,8334));
 #endif
 
+    benchmarks.push_back(new update_geometry ("update_geometry_100k_pool",     RTC_GEOMETRY_DYNAMIC,159,1,",memory_pool_size=1024"));
+    benchmarks.push_back(new update_geometry ("update_geometry_1000k_1_pool",  RTC_GEOMETRY_DYNAMIC,501,1,",memory_pool_size=1024"));
+    benchmarks.push_back(new update_geometry ("update_geometry_10k_100_pool",  RTC_GEOMETRY_DYNAMIC,51,100,",memory_pool_size=1024"));
+
+
+    benchmarks.push_back(new update_subdiv_geometry ("update_subdiv_topology_10k",    51,1,true));
+    benchmarks.push_back(new update_subdiv_geometry ("update_subdiv_topology_100k",   159,1,true));
+    benchmarks.push_back(new update_subdiv_geometry ("update_subdiv_topology_1000k_1",501,1,true));
+    benchmarks.push_back(new update_subdiv_geometry ("update_subdiv_vertices_10k",    51,1,false));
+    benchmarks.push_back(new update_subdiv_geometry ("update_subdiv_vertices_100k",   159,1,false));
+    benchmarks.push_back(new update_subdiv_geometry ("update_subdiv_vertices_1000k_1",501,1,false));
 
     benchmarks.push_back(new update_scenes ("refit_scenes_120",      RTC_GEOMETRY_DEFORMABLE,6,1));
     benchmarks.push_back(new update_scenes ("refit_scenes_1k" ,      RTC_GEOMETRY_DEFORMABLE,17,1));
@@ -1796,6 +2100,13 @@ namespace embree
     benchmarks.push_back(new update_scenes ("refit_scenes_120_10000",RTC_GEOMETRY_DEFORMABLE,6,8334));
 #endif
 
+    benchmarks.push_back(new build_morton_scenes ("build_morton32_scenes_500k",  32,400,300));
+    benchmarks.push_back(new build_morton_scenes ("build_morton64_scenes_500k",  64,400,300));
+#if defined(__X86_64__)
+    benchmarks.push_back(new build_morton_scenes ("build_morton32_scenes_4000k", 32,1200,800));
+    benchmarks.push_back(new build_morton_scenes ("build_morton64_scenes_4000k", 64,1200,800));
+#endif
+
 #if defined(__X86_64__)
     benchmarks.push_back(new update_keyframe_scenes ("refit_keyframe_scenes_1000k_1",  RTC_GEOMETRY_DEFORMABLE,501,1));
     benchmarks.push_back(new update_keyframe_scenes ("refit_keyframe_scenes_8000k_1",  RTC_GEOMETRY_DEFORMABLE,1420,1));
@@ -1815,6 +2126,8 @@ namespace embree
 #if defined(__X86_64__)
     benchmarks.push_back(new update_scenes ("update_scenes_120_10000",RTC_GEOMETRY_DYNAMIC,6,8334));
 #endif
+    benchmarks.push_back(new update_scenes ("update_scenes_120_objects_10000_modified_20",RTC_GEOMETRY_DYNAMIC,6,1,10000,20));
+    benchmarks.push_back(new update_scenes ("update_scenes_120_objects_50000_modified_20",RTC_GEOMETRY_DYNAMIC,6,1,50000,20));
 
 #if defined(__X86_64__)
     benchmarks.push_back(new update_keyframe_scenes ("update_keyframe_scenes_1000k_1",  RTC_GEOMETRY_DYNAMIC,501,1));
@@ -1873,7 +2186,9 @@ namespace embree
     std::cout << "set ylabel \"" << benchmark->unit << "\"" << std::endl;
     std::cout << "plot \"-\" using 0:2 title \"" << benchmark->name << "\" with lines" << std::endl;
 	
-    for (size_t i=g_plot_min; i<=g_plot_max; i+= g_plot_step) 
+    /* a step of 0 doubles the number of threads, the last column is the speedup over the first thread count */
+    double pfirst = 0.0;
+    for (size_t i=g_plot_min; i<=g_plot_max; i = g_plot_step ? i+g_plot_step : max(2*i,size_t(1))) 
     {
       double pmin = inf, pmax = -float(inf), pavg = 0.0f;
       size_t N = 8;
@@ -1883,8 +2198,9 @@ namespace embree
 	pmax = max(pmax,p);
 	pavg = pavg + p/double(N);
       }
+      if (pfirst == 0.0) pfirst = pavg;
       //std::cout << "threads = " << i << ": [" << pmin << " / " << pavg << " / " << pmax << "] " << benchmark->unit << std::endl;
-      std::cout << " " << i << " " << pmin << " " << pavg << " " << pmax << std::endl;
+      std::cout << " " << i << " " << pmin << " " << pavg << " " << pmax << " " << pavg/pfirst << std::endl;
     }
     std::cout << "EOF" << std::endl;
   }
@@ -1904,13 +2220,14 @@ namespace embree
         g_rtcore = argv[++i];
       }
 
-      /* plots scalability graph */
+      /* plots scalability graph, e.g. "-plot 1 32 0 parallel_for_fine_1M" doubles the threads from 1 to 32 */
       else if (tag == "-plot" && i+4<argc) {
 	g_plot_min = atoi(argv[++i]);
 	g_plot_max = atoi(argv[++i]);
 	g_plot_step= atoi(argv[++i]);
 	g_plot_test= argv[++i];
 	plot_scalability();
+	executed_benchmarks = true;
       }
 
       /* run single benchmark */
@@ -432,13 +432,16 @@ namespace embree
     VARIANT_OCCLUDED = 1,
     VARIANT_COHERENT = 0,
     VARIANT_INCOHERENT = 2,
+    VARIANT_SORTED = 4,
     VARIANT_INTERSECT_OCCLUDED_MASK = 1,
     VARIANT_COHERENT_INCOHERENT_MASK = 2,
     
     VARIANT_INTERSECT_COHERENT = 0,
     VARIANT_OCCLUDED_COHERENT = 1,
     VARIANT_INTERSECT_INCOHERENT = 2,
-    VARIANT_OCCLUDED_INCOHERENT = 3
+    VARIANT_OCCLUDED_INCOHERENT = 3,
+    VARIANT_INTERSECT_INCOHERENT_SORTED = 6,
+    VARIANT_OCCLUDED_INCOHERENT_SORTED = 7
   };
 
   inline std::string to_string(IntersectVariant ivariant)
@@ -448,6 +451,8 @@ namespace embree
     case VARIANT_OCCLUDED_COHERENT : return "OccludedCoherent";
     case VARIANT_INTERSECT_INCOHERENT: return "IntersectIncoherent";
     case VARIANT_OCCLUDED_INCOHERENT : return "OccludedIncoherent";
+    case VARIANT_INTERSECT_INCOHERENT_SORTED: return "IntersectIncoherentSorted";
+    case VARIANT_OCCLUDED_INCOHERENT_SORTED : return "OccludedIncoherentSorted";
     }
     return "";
   }
@@ -542,6 +547,7 @@ namespace embree
   {
     RTCIntersectContext context;
     context.flags = ((ivariant & VARIANT_COHERENT_INCOHERENT_MASK) == VARIANT_COHERENT) ? RTC_INTERSECT_COHERENT :  RTC_INTERSECT_INCOHERENT;
+    if (ivariant & VARIANT_SORTED) context.flags = (RTCIntersectFlags) (context.flags | RTC_INTERSECT_SORT);
     context.userRayExt = nullptr;
 
     switch (mode) 
@@ -484,6 +484,79 @@ namespace embree
     }
   };
 
+  struct SceneCacheTest : public VerifyApplication::Test
+  {
+    SceneCacheTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    static void addGeometries(VerifyScene& scene, size_t numPhi, Ref<SceneGraph::Node> hair)
+    {
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(Vec3fa(-1,0,0),1.0f,numPhi),false);
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(Vec3fa(-1,0,0),1.0f,numPhi)->set_motion_vector(Vec3fa(1)),true);
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createQuadSphere(Vec3fa(+1,0,0),1.0f,numPhi),false);
+      scene.addGeometry(RTC_GEOMETRY_STATIC,hair,false);
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::convert_bezier_to_lines(hair),false);
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      const std::string fileName = "verify_scene_cache_"+stringOfISA(isa)+".bin";
+      remove(fileName.c_str());
+      
+      /* hair is randomly generated, thus create it only once */
+      const Vec3fa dx(1,0,0);
+      const Vec3fa dy(0,1,0);
+      Ref<SceneGraph::Node> hair = SceneGraph::createHairyPlane(Vec3fa(0,-1,-1),dx,dy,0.1f,0.01f,100,true);
+
+      bool passed = true;
+      {
+        /* no cache file present, build and store scene */
+        VerifyScene scene0(device,RTC_SCENE_STATIC,RTC_INTERSECT1);
+        addGeometries(scene0,50,hair);
+        passed &= !rtcLoadSceneCache(scene0,fileName.c_str());
+        AssertNoError(device);
+        rtcCommit (scene0);
+        AssertNoError(device);
+        rtcSaveSceneCache(scene0,fileName.c_str());
+        AssertNoError(device);
+
+        /* same input data has to use cache */
+        VerifyScene scene1(device,RTC_SCENE_STATIC,RTC_INTERSECT1);
+        addGeometries(scene1,50,hair);
+        passed &= rtcLoadSceneCache(scene1,fileName.c_str());
+        AssertNoError(device);
+        
+        BBox3fa bounds0, bounds1;
+        rtcGetBounds(scene0,(RTCBounds&)bounds0);
+        rtcGetBounds(scene1,(RTCBounds&)bounds1);
+        passed &= bounds0 == bounds1;
+
+        for (size_t i=0; passed && i<1024; i++)
+        {
+          const Vec3fa org(4.0f*drand48()-2.0f,2.0f*drand48()-1.0f,-4.0f);
+          const Vec3fa dir(0.2f*drand48()-0.1f,0.2f*drand48()-0.1f,1.0f);
+          RTCRay ray0 = makeRay(org,dir); ray0.time = drand48();
+          RTCRay ray1 = ray0;
+          rtcIntersect(scene0,ray0);
+          rtcIntersect(scene1,ray1);
+          passed &= ray0.geomID == ray1.geomID && ray0.primID == ray1.primID && ray0.tfar == ray1.tfar;
+        }
+        AssertNoError(device);
+
+        /* modified input data must not use cache */
+        VerifyScene scene2(device,RTC_SCENE_STATIC,RTC_INTERSECT1);
+        addGeometries(scene2,51,hair);
+        passed &= !rtcLoadSceneCache(scene2,fileName.c_str());
+        AssertNoError(device);
+      }
+      remove(fileName.c_str());
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct GetUserDataTest : public VerifyApplication::Test
   {
     GetUserDataTest (std::string name, int isa)
@@ -926,48 +999,816 @@ namespace embree
       std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       error_handler(rtcDeviceGetError(device));
-      if (!supportsIntersectMode(device))
-        return VerifyApplication::SKIPPED;
-      
-      VerifyScene scene(device,sflags,to_aflags(imode));
+      if (!supportsIntersectMode(device))
+        return VerifyApplication::SKIPPED;
+      
+      VerifyScene scene(device,sflags,to_aflags(imode));
+      AssertNoError(device);
+      size_t numPhi = 10;
+      size_t numVertices = 2*numPhi*(numPhi+1);
+      Vec3fa pos0 = Vec3fa(-10,0,-10);
+      Vec3fa pos1 = Vec3fa(-10,0,+10);
+      Vec3fa pos2 = Vec3fa(+10,0,-10);
+      Vec3fa pos3 = Vec3fa(+10,0,+10);
+      unsigned geom0 = scene.addSphere(gflags,pos0,1.0f,numPhi);
+      unsigned geom1 = scene.addSphereHair(gflags,pos1,1.0f);
+      unsigned geom2 = scene.addSphere(gflags,pos2,1.0f,numPhi);
+      unsigned geom3 = scene.addSphereHair(gflags,pos3,1.0f);
+      AssertNoError(device);
+      
+      for (size_t i=0; i<16; i++) 
+      {
+        bool move0 = i & 1, move1 = i & 2, move2 = i & 4, move3 = i & 8;
+        Vec3fa ds(2,0.1f,2);
+        if (move0) { move_mesh(scene,geom0,numVertices,ds); pos0 += ds; }
+        if (move1) { move_mesh(scene,geom1,4,ds); pos1 += ds; }
+        if (move2) { move_mesh(scene,geom2,numVertices,ds); pos2 += ds; }
+        if (move3) { move_mesh(scene,geom3,4,ds); pos3 += ds; }
+        rtcCommit (scene);
+        AssertNoError(device);
+
+        RTCRay ray0 = makeRay(pos0+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 0
+        RTCRay ray1 = makeRay(pos1+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 1
+        RTCRay ray2 = makeRay(pos2+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 2
+        RTCRay ray3 = makeRay(pos3+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 3
+        RTCRay testRays[4] = { ray0, ray1, ray2, ray3 };
+
+        const size_t maxRays = 100;
+        RTCRay rays[maxRays];
+        for (size_t numRays=1; numRays<maxRays; numRays++) {
+          for (size_t i=0; i<numRays; i++) rays[i] = testRays[i%4];
+          IntersectWithMode(imode,ivariant,scene,rays,numRays);
+          for (size_t i=0; i<numRays; i++) if (rays[i].geomID == -1) return VerifyApplication::FAILED;
+        }
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct UpdateManyObjectsTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    UpdateManyObjectsTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      
+      /* many objects such that the top level gets opened into the object hierarchies */
+      VerifyScene scene(device,sflags,RTC_INTERSECT1);
+      AssertNoError(device);
+      const size_t numPhi = 20;
+      const size_t numVertices = 2*numPhi*(numPhi+1);
+      const size_t numObjects = 64;
+      std::vector<Vec3fa> pos(numObjects);
+      std::vector<unsigned> geom(numObjects);
+      for (size_t i=0; i<numObjects; i++) {
+        pos[i] = Vec3fa(4.0f*float(i%8),0.0f,4.0f*float(i/8));
+        geom[i] = scene.addSphere(RTC_GEOMETRY_DYNAMIC,pos[i],1.0f,numPhi);
+      }
+      rtcCommit (scene);
+      AssertNoError(device);
+      
+      /* move only a few objects per commit, sometimes far away to trigger a rebuild of the top level */
+      for (size_t frame=0; frame<32; frame++) 
+      {
+        for (size_t j=0; j<3; j++)
+        {
+          const size_t i = size_t(drand48()*numObjects) % numObjects;
+          Vec3fa ds = frame % 8 == 7 ? Vec3fa(0.0f,100.0f*drand48(),0.0f) : Vec3fa(0.0f,2.0f*drand48()-1.0f,0.0f);
+          UpdateTest::move_mesh(scene,geom[i],numVertices,ds);
+          pos[i] += ds;
+        }
+        rtcCommit (scene);
+        AssertNoError(device);
+
+        /* each object has to get hit from above at its current position */
+        for (size_t i=0; i<numObjects; i++) 
+        {
+          RTCRay ray = makeRay(pos[i]+Vec3fa(0,1000,0),Vec3fa(0,-1,0));
+          rtcIntersect(scene,ray);
+          if (ray.geomID != geom[i]) return VerifyApplication::FAILED;
+        }
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  std::atomic<ssize_t> monitorPoolBytesUsed(0);
+
+  bool monitorPoolFunction(ssize_t bytes, bool post) 
+  {
+    monitorPoolBytesUsed += bytes;
+    return true;
+  }
+
+  struct MemoryPoolTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    MemoryPoolTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      monitorPoolBytesUsed = 0;
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",memory_pool_size=256";
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        error_handler(rtcDeviceGetError(device));
+        rtcDeviceSetMemoryMonitorFunction(device,monitorPoolFunction);
+      
+        /* rebuild dynamic scenes a few times, each build reuses the memory of the previous one */
+        for (size_t iter=0; iter<4; iter++)
+        {
+          VerifyScene scene(device,sflags,RTC_INTERSECT1);
+          AssertNoError(device);
+          const size_t numPhi = 50;
+          const size_t numVertices = 2*numPhi*(numPhi+1);
+          const size_t numObjects = 16;
+          std::vector<Vec3fa> pos(numObjects);
+          std::vector<unsigned> geom(numObjects);
+          for (size_t i=0; i<numObjects; i++) {
+            pos[i] = Vec3fa(4.0f*float(i%4),0.0f,4.0f*float(i/4));
+            geom[i] = scene.addSphere(RTC_GEOMETRY_DYNAMIC,pos[i],1.0f,numPhi);
+          }
+          rtcCommit (scene);
+          AssertNoError(device);
+
+          for (size_t frame=0; frame<4; frame++) 
+          {
+            for (size_t i=0; i<numObjects; i++) {
+              Vec3fa ds(0.0f,2.0f*drand48()-1.0f,0.0f);
+              UpdateTest::move_mesh(scene,geom[i],numVertices,ds);
+              pos[i] += ds;
+            }
+            rtcCommit (scene);
+            AssertNoError(device);
+            
+            for (size_t i=0; i<numObjects; i++) 
+            {
+              RTCRay ray = makeRay(pos[i]+Vec3fa(0,1000,0),Vec3fa(0,-1,0));
+              rtcIntersect(scene,ray);
+              if (ray.geomID != geom[i]) return VerifyApplication::FAILED;
+            }
+          }
+        }
+
+        /* memory has to get reused and cached memory has to stay accounted */
+        if (rtcDeviceGetParameter1i(device,RTC_MEMORY_POOL_REUSED_BYTES) == 0) return VerifyApplication::FAILED;
+        if (rtcDeviceGetParameter1i(device,RTC_MEMORY_POOL_CACHED_BYTES) == 0) return VerifyApplication::FAILED;
+        if (monitorPoolBytesUsed <= 0) return VerifyApplication::FAILED;
+      }
+
+      /* destroying the device has to release all pooled memory */
+      if (monitorPoolBytesUsed != 0) return VerifyApplication::FAILED;
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct NumaPolicyTest : public VerifyApplication::Test
+  {
+    std::string policy;
+    RTCSceneFlags sflags;
+
+    NumaPolicyTest (std::string name, int isa, std::string policy, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), policy(policy), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",numa="+policy;
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      
+      VerifyScene scene(device,sflags,RTC_INTERSECT1);
+      AssertNoError(device);
+      const size_t numObjects = 16;
+      std::vector<Vec3fa> pos(numObjects);
+      std::vector<unsigned> geom(numObjects);
+      for (size_t i=0; i<numObjects; i++) {
+        pos[i] = Vec3fa(4.0f*float(i%4),0.0f,4.0f*float(i/4));
+        geom[i] = scene.addSphere(RTC_GEOMETRY_STATIC,pos[i],1.0f,50);
+      }
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      for (size_t i=0; i<numObjects; i++) 
+      {
+        RTCRay ray = makeRay(pos[i]+Vec3fa(0,1000,0),Vec3fa(0,-1,0));
+        rtcIntersect(scene,ray);
+        if (ray.geomID != geom[i]) return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct TessellationCacheTest : public VerifyApplication::Test
+  {
+    TessellationCacheTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    size_t trace(RTCScene scene)
+    {
+      size_t numHits = 0;
+      for (size_t y=0; y<16; y++) {
+        for (size_t x=0; x<16; x++) {
+          RTCRay ray = makeRay(Vec3fa(-1.5f+0.2f*float(x),-1.5f+0.2f*float(y),-10.0f),Vec3fa(0,0,1));
+          rtcIntersect(scene,ray);
+          numHits += ray.geomID != RTC_INVALID_GEOMETRY_ID;
+        }
+      }
+      return numHits;
+    }
+
+    void traceRays(RTCScene scene, std::vector<RTCRay>& rays)
+    {
+      rays.resize(32*32);
+      for (size_t y=0; y<32; y++) {
+        for (size_t x=0; x<32; x++) {
+          RTCRay& ray = rays[32*y+x];
+          ray = makeRay(Vec3fa(-1.55f+0.1f*float(x),-1.55f+0.1f*float(y),-10.0f),Vec3fa(0,0,1));
+          rtcIntersect(scene,ray);
+        }
+      }
+    }
+
+    bool sameHits(const std::vector<RTCRay>& rays0, const std::vector<RTCRay>& rays1)
+    {
+      for (size_t i=0; i<rays0.size(); i++) {
+        if (rays0[i].geomID != rays1[i].geomID || rays0[i].primID != rays1[i].primID) return false;
+        if (rays0[i].tfar != rays1[i].tfar || rays0[i].u != rays1[i].u || rays0[i].v != rays1[i].v) return false;
+      }
+      return true;
+    }
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",tessellation_cache_size=512";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      /* shrinking the cache invalidates it and reserves space to grow again */
+      rtcDeviceSetParameter1i(device,RTC_SOFTWARE_CACHE_SIZE,256*1024*1024);
+      AssertNoError(device);
+
+      /* dynamic scenes tessellate subdivision surfaces lazily into the cache */
+      VerifyScene scene(device,RTC_SCENE_DYNAMIC,RTC_INTERSECT1);
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivSphere(zero,2.0f,4,4),false);
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      /* the second pass has to find all patches in the cache */
+      if (trace(scene) == 0) return VerifyApplication::FAILED;
+      const ssize_t hits0 = rtcDeviceGetParameter1i(device,RTC_SOFTWARE_CACHE_HITS);
+      const ssize_t misses0 = rtcDeviceGetParameter1i(device,RTC_SOFTWARE_CACHE_MISSES);
+      if (misses0 == 0) return VerifyApplication::FAILED;
+      trace(scene);
+      if (rtcDeviceGetParameter1i(device,RTC_SOFTWARE_CACHE_MISSES) != misses0) return VerifyApplication::FAILED;
+      if (rtcDeviceGetParameter1i(device,RTC_SOFTWARE_CACHE_HITS) <= hits0) return VerifyApplication::FAILED;
+
+      /* growing the cache has to keep all cached patches */
+      const ssize_t flushes0 = rtcDeviceGetParameter1i(device,RTC_SOFTWARE_CACHE_FLUSHES);
+      rtcDeviceSetParameter1i(device,RTC_SOFTWARE_CACHE_SIZE,512*1024*1024);
+      AssertNoError(device);
+      if (rtcDeviceGetParameter1i(device,RTC_SOFTWARE_CACHE_FLUSHES) != flushes0) return VerifyApplication::FAILED;
+      trace(scene);
+      if (rtcDeviceGetParameter1i(device,RTC_SOFTWARE_CACHE_MISSES) != misses0) return VerifyApplication::FAILED;
+      AssertNoError(device);
+
+      /* record reference hits of a finely tessellated sphere while the cache holds all patches */
+      VerifyScene scene2(device,RTC_SCENE_DYNAMIC,RTC_INTERSECT1);
+      scene2.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivSphere(zero,2.0f,16,32),false);
+      rtcCommit (scene2);
+      AssertNoError(device);
+      std::vector<RTCRay> reference, rays;
+      traceRays(scene2,reference);
+
+      /* a small cache switches segments frequently */
+      rtcDeviceSetParameter1i(device,RTC_SOFTWARE_CACHE_SIZE,1024*1024);
+      AssertNoError(device);
+      traceRays(scene2,rays);
+      if (!sameHits(reference,rays)) return VerifyApplication::FAILED;
+
+      /* segments after growing the cache must not overwrite patches that are still in use */
+      rtcDeviceSetParameter1i(device,RTC_SOFTWARE_CACHE_SIZE,1536*1024);
+      AssertNoError(device);
+      const ssize_t flushes1 = rtcDeviceGetParameter1i(device,RTC_SOFTWARE_CACHE_FLUSHES);
+      for (size_t i=0; i<64 && rtcDeviceGetParameter1i(device,RTC_SOFTWARE_CACHE_FLUSHES) < flushes1+2*8; i++) {
+        traceRays(scene2,rays);
+        if (!sameHits(reference,rays)) return VerifyApplication::FAILED;
+      }
+      if (rtcDeviceGetParameter1i(device,RTC_SOFTWARE_CACHE_FLUSHES) < flushes1+8) return VerifyApplication::FAILED;
+      AssertNoError(device);
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct NestedInstanceTest : public VerifyApplication::Test
+  {
+    NestedInstanceTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    unsigned addInstance(RTCScene target, RTCScene source, const Vec3fa& P)
+    {
+      const float xfm[12] = { 1,0,0, 0,1,0, 0,0,1, P.x,P.y,P.z };
+      unsigned instID = rtcNewInstance2(target,source,1);
+      rtcSetTransform2(target,instID,RTC_MATRIX_COLUMN_MAJOR,xfm,0);
+      return instID;
+    }
+
+    bool checkPath(const RTCRay& ray, unsigned instID0, unsigned instID1)
+    {
+      return ray.geomID == 0 && ray.instID == instID0 && ray.instIDNested[0] == instID1 
+        && ray.instIDNested[1] == RTC_INVALID_GEOMETRY_ID && ray.instIDNested[2] == RTC_INVALID_GEOMETRY_ID;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      for (size_t maxLevel=1; maxLevel<=2; maxLevel++)
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",max_instance_level="+std::to_string(long(maxLevel));
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        error_handler(rtcDeviceGetError(device));
+        const RTCAlgorithmFlags aflags = RTCAlgorithmFlags(RTC_INTERSECT1 | RTC_INTERSECT_STREAM);
+
+        /* scene C contains a sphere, scene B two instances of C, and scene A two instances of B */
+        VerifyScene sceneC(device,RTC_SCENE_STATIC,aflags);
+        sceneC.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,16));
+        rtcCommit (sceneC);
+        VerifyScene sceneB(device,RTC_SCENE_STATIC,aflags);
+        addInstance(sceneB,sceneC,Vec3fa(-2.0f,0.0f,0.0f));
+        addInstance(sceneB,sceneC,Vec3fa(+2.0f,0.0f,0.0f));
+        rtcCommit (sceneB);
+        VerifyScene sceneA(device,RTC_SCENE_STATIC,aflags);
+        addInstance(sceneA,sceneB,Vec3fa(0.0f,-4.0f,0.0f));
+        addInstance(sceneA,sceneB,Vec3fa(0.0f,+4.0f,0.0f));
+        rtcCommit (sceneA);
+        AssertNoError(device);
+
+        RTCRay rays[4];
+        for (size_t i=0; i<4; i++)
+          rays[i] = makeRay(Vec3fa(i%2 ? 2.0f : -2.0f, i/2 ? 4.0f : -4.0f, -10.0f),Vec3fa(0,0,1));
+        RTCRay streamRays[4];
+        for (size_t i=0; i<4; i++) streamRays[i] = rays[i];
+
+        for (size_t i=0; i<4; i++) rtcIntersect(sceneA,rays[i]);
+        RTCIntersectContext context;
+        context.flags = RTC_INTERSECT_INCOHERENT;
+        context.userRayExt = nullptr;
+        rtcIntersect1M(sceneA,&context,streamRays,4,sizeof(RTCRay));
+        AssertNoError(device);
+
+        /* instances nested deeper than the maximal level are not traversed */
+        for (size_t i=0; i<4; i++) 
+        {
+          if (maxLevel == 1) {
+            if (rays[i].geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+            if (streamRays[i].geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+          } else {
+            if (!checkPath(rays[i],unsigned(i/2),unsigned(i%2))) return VerifyApplication::FAILED;
+            if (!checkPath(streamRays[i],unsigned(i/2),unsigned(i%2))) return VerifyApplication::FAILED;
+          }
+        }
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct SpatialSplitTest : public VerifyApplication::Test
+  {
+    GeometryType gtype;
+
+    SpatialSplitTest (std::string name, int isa, GeometryType gtype)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), gtype(gtype) {}
+
+    void addThinPlanes(VerifyScene& scene)
+    {
+      /* planes of long and thin primitives in random diagonal directions */
+      srand48(2734);
+      for (size_t i=0; i<8; i++)
+      {
+        const Vec3fa p0 = 8.0f*Vec3fa(drand48(),drand48(),drand48());
+        const Vec3fa dx = 4.0f*normalize(Vec3fa(drand48(),drand48(),drand48())+Vec3fa(0.1f));
+        const Vec3fa dy = 4.0f*normalize(cross(dx,Vec3fa(drand48(),drand48(),drand48())));
+        if (gtype == TRIANGLE_MESH) scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTrianglePlane(p0,dx,dy,1,1000));
+        else                        scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createQuadPlane    (p0,dx,dy,1,1000));
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      const char* factors[] = { "1", "1.5", "4" };
+      for (size_t f=0; f<3; f++)
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",tri_builder_replication_factor="+factors[f];
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        error_handler(rtcDeviceGetError(device));
+
+        /* the high quality scene uses the spatial split builder, the other one the object split builder */
+        VerifyScene scene0(device,RTC_SCENE_STATIC,RTC_INTERSECT1);
+        VerifyScene scene1(device,RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_HIGH_QUALITY),RTC_INTERSECT1);
+        addThinPlanes(scene0); rtcCommit (scene0);
+        addThinPlanes(scene1); rtcCommit (scene1);
+        AssertNoError(device);
+
+        /* both scenes have to report the same hits */
+        for (size_t i=0; i<4096; i++)
+        {
+          const Vec3fa org = 12.0f*Vec3fa(drand48(),drand48(),drand48())-Vec3fa(2.0f);
+          const Vec3fa dir = Vec3fa(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+          RTCRay ray0 = makeRay(org,dir); rtcIntersect(scene0,ray0);
+          RTCRay ray1 = makeRay(org,dir); rtcIntersect(scene1,ray1);
+          if (ray0.geomID != ray1.geomID) return VerifyApplication::FAILED;
+          if (ray0.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+          if (abs(ray0.tfar-ray1.tfar) > 1E-4f*ray0.tfar) return VerifyApplication::FAILED;
+        }
+        AssertNoError(device);
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct HairTessellationTest : public VerifyApplication::Test
+  {
+    HairTessellationTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    static Vec3fa eval(const Vec3fa* p, const float u)
+    {
+      const float t0 = 1.0f-u, t1 = u;
+      return t0*t0*t0*p[0] + 3.0f*t0*t0*t1*p[1] + 3.0f*t0*t1*t1*p[2] + t1*t1*t1*p[3];
+    }
+
+    static Vec3fa tangent(const Vec3fa* p, const float u)
+    {
+      const float t0 = 1.0f-u, t1 = u;
+      return 3.0f*t0*t0*(p[1]-p[0]) + 6.0f*t0*t1*(p[2]-p[1]) + 3.0f*t1*t1*(p[3]-p[2]);
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* slightly bent hairs whose tessellation stays well inside the hair radius */
+      const size_t numHairs = 256;
+      const float radius = 0.05f;
+      avector<Vec3fa> vertices(4*numHairs);
+      std::vector<int> indices(numHairs);
+      srand48(4273);
+      for (size_t i=0; i<numHairs; i++)
+      {
+        const Vec3fa p = 8.0f*Vec3fa(drand48(),drand48(),drand48());
+        const Vec3fa d = normalize(Vec3fa(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f));
+        for (size_t j=0; j<4; j++) {
+          const Vec3fa bend = (j == 1 || j == 2) ? 0.1f*Vec3fa(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f) : Vec3fa(zero);
+          vertices[4*i+j] = p + (float(j)/3.0f)*d + bend;
+          vertices[4*i+j].w = radius;
+        }
+        indices[i] = 4*i;
+      }
+
+      /* the hair of the default, all multi curve leaf types, and quantized nodes has to get hit where it is aimed at */
+      std::vector<std::string> accels = { "default", "bvh4obb.bezier4v", "bvh4obb.bezier1v", "qbvh4obb.bezier1i" };
+
+      /* the BVH8 variants are only available with AVX */
+      if ((isa & AVX) == AVX) {
+        accels.push_back("bvh8obb.bezier1v");
+        accels.push_back("qbvh8obb.bezier1i");
+      }
+      for (size_t a=0; a<accels.size(); a++)
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",hair_accel="+accels[a];
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        error_handler(rtcDeviceGetError(device));
+
+        VerifyScene scene(device,RTC_SCENE_STATIC,RTC_INTERSECT1);
+        unsigned geomID = rtcNewHairGeometry (scene, RTC_GEOMETRY_STATIC, numHairs, vertices.size(), 1);
+        rtcSetBuffer(scene, geomID, RTC_VERTEX_BUFFER, vertices.data(), 0, sizeof(Vec3fa));
+        rtcSetBuffer(scene, geomID, RTC_INDEX_BUFFER , indices.data() , 0, sizeof(int));
+        rtcCommit (scene);
+        AssertNoError(device);
+
+        for (size_t i=0; i<numHairs; i++)
+        {
+          for (size_t j=1; j<10; j++)
+          {
+            const float u = 0.1f*float(j);
+            const Vec3fa P = eval(&vertices[4*i],u);
+            const Vec3fa T = tangent(&vertices[4*i],u);
+            const Vec3fa dir = normalize(cross(T,Vec3fa(drand48(),drand48(),drand48())));
+            RTCRay ray0 = makeRay(P-2.0f*dir,dir); rtcIntersect(scene,ray0);
+            RTCRay ray1 = makeRay(P-2.0f*dir,dir); rtcOccluded(scene,ray1);
+            if (ray0.geomID == RTC_INVALID_GEOMETRY_ID || ray0.tfar > 2.0f+radius) return VerifyApplication::FAILED;
+            if (ray1.geomID != 0) return VerifyApplication::FAILED;
+          }
+        }
+        AssertNoError(device);
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct UserGeometryBatchTest : public VerifyApplication::Test
+  {
+    UserGeometryBatchTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    struct SphereSet
+    {
+      avector<Sphere> spheres;
+      unsigned geomID;
+      size_t numBatches;
+      size_t numPairs;
+    };
+
+    static void boundsFunc(void* ptr, size_t item, RTCBounds& bounds_o) {
+      BoundsFunc(&((SphereSet*)ptr)->spheres[item],item,(BBox3fa*)&bounds_o);
+    }
+
+    static bool intersectSphere(const Sphere& sphere, const Vec3fa& org, const Vec3fa& dir, float tnear, float tfar, float& t)
+    {
+      const Vec3fa v = org-sphere.pos;
+      const float A = dot(dir,dir);
+      const float B = 2.0f*dot(v,dir);
+      const float C = dot(v,v)-sphere.r*sphere.r;
+      const float D = B*B-4.0f*A*C;
+      if (D < 0.0f) return false;
+      const float Q = sqrt(D);
+      const float t0 = (-B-Q)/(2.0f*A);
+      const float t1 = (-B+Q)/(2.0f*A);
+      if (tnear < t0 && t0 < tfar) { t = t0; return true; }
+      if (tnear < t1 && t1 < tfar) { t = t1; return true; }
+      return false;
+    }
+
+    static void intersectFuncN(const int* valid, void* ptr, const RTCIntersectContext* context, RTCRayN* rays, size_t N, size_t item)
+    {
+      SphereSet* set = (SphereSet*) ptr;
+      for (size_t i=0; i<N; i++)
+      {
+        if (valid[i] != -1) continue;
+        const Vec3fa org(RTCRayN_org_x(rays,N,i),RTCRayN_org_y(rays,N,i),RTCRayN_org_z(rays,N,i));
+        const Vec3fa dir(RTCRayN_dir_x(rays,N,i),RTCRayN_dir_y(rays,N,i),RTCRayN_dir_z(rays,N,i));
+        float t; if (!intersectSphere(set->spheres[item],org,dir,RTCRayN_tnear(rays,N,i),RTCRayN_tfar(rays,N,i),t)) continue;
+        RTCRayN_tfar(rays,N,i) = t;
+        RTCRayN_geomID(rays,N,i) = set->geomID;
+        RTCRayN_primID(rays,N,i) = unsigned(item);
+      }
+    }
+
+    static void occludedFuncN(const int* valid, void* ptr, const RTCIntersectContext* context, RTCRayN* rays, size_t N, size_t item)
+    {
+      SphereSet* set = (SphereSet*) ptr;
+      for (size_t i=0; i<N; i++)
+      {
+        if (valid[i] != -1) continue;
+        const Vec3fa org(RTCRayN_org_x(rays,N,i),RTCRayN_org_y(rays,N,i),RTCRayN_org_z(rays,N,i));
+        const Vec3fa dir(RTCRayN_dir_x(rays,N,i),RTCRayN_dir_y(rays,N,i),RTCRayN_dir_z(rays,N,i));
+        float t; if (intersectSphere(set->spheres[item],org,dir,RTCRayN_tnear(rays,N,i),RTCRayN_tfar(rays,N,i),t))
+          RTCRayN_geomID(rays,N,i) = 0;
+      }
+    }
+
+    static void intersectFuncNM(void* ptr, const RTCIntersectContext* context, RTCRay** rays, const unsigned* items, size_t M)
+    {
+      SphereSet* set = (SphereSet*) ptr;
+      set->numBatches++;
+      set->numPairs += M;
+      for (size_t i=0; i<M; i++)
+      {
+        RTCRay& ray = *rays[i];
+        float t; if (!intersectSphere(set->spheres[items[i]],Vec3fa(ray.org[0],ray.org[1],ray.org[2]),Vec3fa(ray.dir[0],ray.dir[1],ray.dir[2]),ray.tnear,ray.tfar,t)) continue;
+        ray.tfar = t;
+        ray.geomID = set->geomID;
+        ray.primID = items[i];
+      }
+    }
+
+    static void occludedFuncNM(void* ptr, const RTCIntersectContext* context, RTCRay** rays, const unsigned* items, size_t M)
+    {
+      SphereSet* set = (SphereSet*) ptr;
+      set->numBatches++;
+      set->numPairs += M;
+      for (size_t i=0; i<M; i++)
+      {
+        RTCRay& ray = *rays[i];
+        float t; if (intersectSphere(set->spheres[items[i]],Vec3fa(ray.org[0],ray.org[1],ray.org[2]),Vec3fa(ray.dir[0],ray.dir[1],ray.dir[2]),ray.tnear,ray.tfar,t))
+          ray.geomID = 0;
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      const RTCAlgorithmFlags aflags = RTCAlgorithmFlags(RTC_INTERSECT1 | RTC_INTERSECT_STREAM);
+
+      /* the same spheres once with packet callbacks only and once with additional batched callbacks */
+      SphereSet sets[2];
+      srand48(8374);
+      for (size_t i=0; i<512; i++) {
+        const Sphere sphere(8.0f*Vec3fa(drand48(),drand48(),drand48()),0.1f+0.3f*drand48());
+        sets[0].spheres.push_back(sphere);
+        sets[1].spheres.push_back(sphere);
+      }
+      VerifyScene scene0(device,RTC_SCENE_STATIC,aflags);
+      VerifyScene scene1(device,RTC_SCENE_STATIC,aflags);
+      RTCScene scenes[2] = { scene0, scene1 };
+      for (size_t s=0; s<2; s++)
+      {
+        sets[s].geomID = rtcNewUserGeometry(scenes[s],sets[s].spheres.size());
+        sets[s].numBatches = sets[s].numPairs = 0;
+        rtcSetUserData(scenes[s],sets[s].geomID,&sets[s]);
+        rtcSetBoundsFunction(scenes[s],sets[s].geomID,boundsFunc);
+        rtcSetIntersectFunctionN(scenes[s],sets[s].geomID,intersectFuncN);
+        rtcSetOccludedFunctionN(scenes[s],sets[s].geomID,occludedFuncN);
+        if (s == 1) {
+          rtcSetIntersectFunctionNM(scenes[s],sets[s].geomID,intersectFuncNM);
+          rtcSetOccludedFunctionNM(scenes[s],sets[s].geomID,occludedFuncNM);
+        }
+        rtcCommit(scenes[s]);
+      }
+      AssertNoError(device);
+
+      const size_t numRays = 1024;
+      std::vector<RTCRay> rays[2][2];
+      for (size_t i=0; i<numRays; i++) {
+        const Vec3fa org = 8.0f*Vec3fa(drand48(),drand48(),drand48());
+        const Vec3fa dir = Vec3fa(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        for (size_t s=0; s<2; s++)
+          for (size_t o=0; o<2; o++)
+            rays[s][o].push_back(makeRay(org,dir));
+      }
+
+      RTCIntersectContext context;
+      context.flags = RTC_INTERSECT_INCOHERENT;
+      context.userRayExt = nullptr;
+      for (size_t s=0; s<2; s++) {
+        rtcIntersect1M(scenes[s],&context,rays[s][0].data(),numRays,sizeof(RTCRay));
+        rtcOccluded1M (scenes[s],&context,rays[s][1].data(),numRays,sizeof(RTCRay));
+      }
+      AssertNoError(device);
+
+      /* batched callbacks have to find the same hits and have to get invoked with more than one pair per batch */
+      for (size_t i=0; i<numRays; i++)
+      {
+        if (rays[0][0][i].geomID != rays[1][0][i].geomID) return VerifyApplication::FAILED;
+        if (rays[0][0][i].primID != rays[1][0][i].primID) return VerifyApplication::FAILED;
+        if (rays[0][0][i].tfar   != rays[1][0][i].tfar  ) return VerifyApplication::FAILED;
+        if (rays[0][1][i].geomID != rays[1][1][i].geomID) return VerifyApplication::FAILED;
+      }
+      if (sets[0].numBatches != 0) return VerifyApplication::FAILED;
+      
+      /* there is no ray stream traversal below SSE4.2 that could collect batches */
+      if ((isa & SSE42) == SSE42) {
+        if (sets[1].numBatches == 0) return VerifyApplication::FAILED;
+        if (sets[1].numPairs <= sets[1].numBatches) return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct ConcurrentCommitTest : public VerifyApplication::Test
+  {
+    ConcurrentCommitTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    struct CommitThread
+    {
+      std::vector<RTCScene> scenes;
+    };
+
+    static void commitThread(void* ptr)
+    {
+      CommitThread* thread = (CommitThread*) ptr;
+      for (size_t i=0; i<thread->scenes.size(); i++)
+        rtcCommit(thread->scenes[i]);
+    }
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",threads=4";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      /* independent scenes of different priorities get committed from many application threads at once */
+      const size_t numThreads = 8;
+      const size_t numScenes = 4*numThreads;
+      std::vector<Ref<VerifyScene>> scenes(numScenes);
+      std::vector<unsigned> geomIDs(numScenes);
+      std::vector<CommitThread> threads(numThreads);
+      for (size_t i=0; i<numScenes; i++) 
+      {
+        scenes[i] = new VerifyScene(device,(i%2) ? RTC_SCENE_STATIC : RTC_SCENE_DYNAMIC,RTC_INTERSECT1);
+        geomIDs[i] = scenes[i]->addSphere(RTC_GEOMETRY_STATIC,Vec3fa(float(i),0.0f,0.0f),0.4f,20+4*(i%8));
+        rtcSetBuildPriority(*scenes[i],int(i%3)-1);
+        threads[i%numThreads].scenes.push_back(*scenes[i]);
+      }
+      AssertNoError(device);
+
+      std::vector<thread_t> handles;
+      for (size_t i=0; i<numThreads; i++)
+        handles.push_back(createThread(commitThread,&threads[i]));
+      for (size_t i=0; i<handles.size(); i++)
+        join(handles[i]);
+      AssertNoError(device);
+
+      /* each scene has to contain its sphere */
+      for (size_t i=0; i<numScenes; i++)
+      {
+        RTCRay ray = makeRay(Vec3fa(float(i),10.0f,0.0f),Vec3fa(0,-1,0));
+        rtcIntersect(*scenes[i],ray);
+        if (ray.geomID != geomIDs[i]) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct SceneStatisticsTest : public VerifyApplication::Test
+  {
+    SceneStatisticsTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      VerifyScene scene(device,RTC_SCENE_STATIC,RTCAlgorithmFlags(RTC_INTERSECT1 | RTC_INTERSECT4 | RTC_INTERSECT_STREAM));
+      scene.addSphere(RTC_GEOMETRY_STATIC,zero,1.0f,50);
+      rtcCommit (scene);
       AssertNoError(device);
-      size_t numPhi = 10;
-      size_t numVertices = 2*numPhi*(numPhi+1);
-      Vec3fa pos0 = Vec3fa(-10,0,-10);
-      Vec3fa pos1 = Vec3fa(-10,0,+10);
-      Vec3fa pos2 = Vec3fa(+10,0,-10);
-      Vec3fa pos3 = Vec3fa(+10,0,+10);
-      unsigned geom0 = scene.addSphere(gflags,pos0,1.0f,numPhi);
-      unsigned geom1 = scene.addSphereHair(gflags,pos1,1.0f);
-      unsigned geom2 = scene.addSphere(gflags,pos2,1.0f,numPhi);
-      unsigned geom3 = scene.addSphereHair(gflags,pos3,1.0f);
+
+      /* trace some rays through each single ray entry point */
+      for (size_t i=0; i<16; i++) {
+        RTCRay ray0 = makeRay(Vec3fa(-1.0f+0.125f*float(i),0.0f,-10.0f),Vec3fa(0,0,1));
+        rtcIntersect(scene,ray0);
+        RTCRay ray1 = makeRay(Vec3fa(-1.0f+0.125f*float(i),0.0f,-10.0f),Vec3fa(0,0,1));
+        rtcOccluded(scene,ray1);
+      }
       AssertNoError(device);
-      
-      for (size_t i=0; i<16; i++) 
-      {
-        bool move0 = i & 1, move1 = i & 2, move2 = i & 4, move3 = i & 8;
-        Vec3fa ds(2,0.1f,2);
-        if (move0) { move_mesh(scene,geom0,numVertices,ds); pos0 += ds; }
-        if (move1) { move_mesh(scene,geom1,4,ds); pos1 += ds; }
-        if (move2) { move_mesh(scene,geom2,numVertices,ds); pos2 += ds; }
-        if (move3) { move_mesh(scene,geom3,4,ds); pos3 += ds; }
-        rtcCommit (scene);
-        AssertNoError(device);
 
-        RTCRay ray0 = makeRay(pos0+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 0
-        RTCRay ray1 = makeRay(pos1+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 1
-        RTCRay ray2 = makeRay(pos2+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 2
-        RTCRay ray3 = makeRay(pos3+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 3
-        RTCRay testRays[4] = { ray0, ray1, ray2, ray3 };
+      RTCSceneStatistics stats;
+      rtcGetSceneStatistics(scene,&stats);
+      AssertNoError(device);
+      if (stats.raysIntersected[RTC_STAT_RAY1] != 16) return VerifyApplication::FAILED;
+      if (stats.raysOccluded   [RTC_STAT_RAY1] != 16) return VerifyApplication::FAILED;
+      if (stats.nodesVisited == 0 || stats.leavesVisited == 0) return VerifyApplication::FAILED;
 
-        const size_t maxRays = 100;
-        RTCRay rays[maxRays];
-        for (size_t numRays=1; numRays<maxRays; numRays++) {
-          for (size_t i=0; i<numRays; i++) rays[i] = testRays[i%4];
-          IntersectWithMode(imode,ivariant,scene,rays,numRays);
-          for (size_t i=0; i<numRays; i++) if (rays[i].geomID == -1) return VerifyApplication::FAILED;
-        }
+      /* only the active rays of packets and streams are counted */
+      size_t numIntersected = 16;
+      if (rtcDeviceGetParameter1i(device,RTC_CONFIG_INTERSECT4)) 
+      {
+        __aligned(16) int valid4[4] = { -1, 0, -1, 0 };
+        RTCRay4 ray4;
+        for (size_t i=0; i<4; i++) setRay(ray4,i,makeRay(Vec3fa(-1.0f+0.5f*float(i),0.0f,-10.0f),Vec3fa(0,0,1)));
+        rtcIntersect4(valid4,scene,ray4);
+        rtcGetSceneStatistics(scene,&stats);
+        if (stats.raysIntersected[RTC_STAT_RAY4] != 2) return VerifyApplication::FAILED;
+        numIntersected += 2;
+      }
+      if (rtcDeviceGetParameter1i(device,RTC_CONFIG_INTERSECT_STREAM)) 
+      {
+        RTCRay rays[4];
+        for (size_t i=0; i<4; i++) rays[i] = makeRay(Vec3fa(-1.0f+0.5f*float(i),0.0f,-10.0f),Vec3fa(0,0,1));
+        rays[3].tnear = 1.0f; rays[3].tfar = 0.0f;
+        RTCIntersectContext context;
+        context.flags = RTC_INTERSECT_INCOHERENT;
+        context.userRayExt = nullptr;
+        rtcIntersect1M(scene,&context,rays,4,sizeof(RTCRay));
+        rtcGetSceneStatistics(scene,&stats);
+        if (stats.raysIntersected[RTC_STAT_RAY1M] != 3) return VerifyApplication::FAILED;
+        numIntersected += 3;
       }
+      AssertNoError(device);
+      if (stats.numBuilds == 0 || stats.numAccels == 0 || stats.bytes == 0) return VerifyApplication::FAILED;
+
+      /* each acceleration structure reports its builder */
+      size_t bytes = 0;
+      for (size_t i=0; i<stats.numAccels; i++) {
+        RTCAccelStatistics accel;
+        if (!rtcGetSceneAccelStatistics(scene,i,&accel)) return VerifyApplication::FAILED;
+        if (accel.builder[0] == 0 || accel.numBuilds == 0) return VerifyApplication::FAILED;
+        bytes += accel.bytes;
+      }
+      RTCAccelStatistics accel;
+      if (rtcGetSceneAccelStatistics(scene,stats.numAccels,&accel)) return VerifyApplication::FAILED;
+      if (bytes != stats.bytes) return VerifyApplication::FAILED;
+
+      /* the device accumulates over all its scenes */
+      if (rtcDeviceGetParameter1i(device,RTC_STAT_RAYS_INTERSECTED) != ssize_t(numIntersected)) return VerifyApplication::FAILED;
+      if (rtcDeviceGetParameter1i(device,RTC_STAT_RAYS_OCCLUDED) != 16) return VerifyApplication::FAILED;
+      if (rtcDeviceGetParameter1i(device,RTC_STAT_BUILDS) < ssize_t(stats.numBuilds)) return VerifyApplication::FAILED;
+
+      rtcResetSceneStatistics(scene);
+      rtcGetSceneStatistics(scene,&stats);
+      AssertNoError(device);
+      if (stats.raysIntersected[RTC_STAT_RAY1] != 0 || stats.numBuilds != 0) return VerifyApplication::FAILED;
       return VerifyApplication::PASSED;
     }
   };
@@ -1435,6 +2276,79 @@ namespace embree
     }
   };
 
+  struct InterpolateStreamTest : public VerifyApplication::Test
+  {
+    size_t N;
+    
+    InterpolateStreamTest (std::string name, int isa, size_t N)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), N(N) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      
+      size_t M = num_interpolation_vertices*N+16; // padds the arrays with some valid data
+      std::vector<float> vertices0(M), vertices1(M);
+      for (size_t i=0; i<M; i++) vertices0[i] = drand48();
+      for (size_t i=0; i<M; i++) vertices1[i] = drand48();
+
+      RTCSceneRef scene = rtcDeviceNewScene(device,RTC_SCENE_DYNAMIC,RTC_INTERPOLATE);
+      unsigned int geomID0 = rtcNewSubdivisionMesh(scene, RTC_GEOMETRY_STATIC, num_interpolation_quad_faces, num_interpolation_quad_faces*4, num_interpolation_vertices, 3, 2, 0, 1);
+      rtcSetBuffer(scene, geomID0, RTC_INDEX_BUFFER,  interpolation_quad_indices , 0, sizeof(unsigned int));
+      rtcSetBuffer(scene, geomID0, RTC_FACE_BUFFER,   interpolation_quad_faces,    0, sizeof(unsigned int));
+      rtcSetBuffer(scene, geomID0, RTC_EDGE_CREASE_INDEX_BUFFER,   interpolation_edge_crease_indices,  0, 2*sizeof(unsigned int));
+      rtcSetBuffer(scene, geomID0, RTC_EDGE_CREASE_WEIGHT_BUFFER,  interpolation_edge_crease_weights,  0, sizeof(float));
+      rtcSetBuffer(scene, geomID0, RTC_VERTEX_CREASE_INDEX_BUFFER, interpolation_vertex_crease_indices,0, sizeof(unsigned int));
+      rtcSetBuffer(scene, geomID0, RTC_VERTEX_CREASE_WEIGHT_BUFFER,interpolation_vertex_crease_weights,0, sizeof(float));
+      rtcSetBuffer(scene, geomID0, RTC_VERTEX_BUFFER0, vertices0.data(), 0, N*sizeof(float));
+      rtcSetBuffer(scene, geomID0, RTC_USER_VERTEX_BUFFER0, vertices0.data(), 0, N*sizeof(float));
+      rtcDisable(scene,geomID0);
+      unsigned int geomID1 = rtcNewTriangleMesh(scene, RTC_GEOMETRY_STATIC, num_interpolation_triangle_faces, num_interpolation_vertices, 1);
+      rtcSetBuffer(scene, geomID1, RTC_INDEX_BUFFER,  interpolation_triangle_indices , 0, 3*sizeof(unsigned int));
+      rtcSetBuffer(scene, geomID1, RTC_VERTEX_BUFFER0, vertices1.data(), 0, N*sizeof(float));
+      rtcSetBuffer(scene, geomID1, RTC_USER_VERTEX_BUFFER0, vertices1.data(), 0, N*sizeof(float));
+      rtcDisable(scene,geomID1);
+      rtcCommit(scene);
+      AssertNoError(device);
+
+      /* hits on both geometries in random order, some entries are invalid */
+      const size_t numUVs = 1023;
+      std::vector<unsigned> geomIDs(numUVs), primIDs(numUVs);
+      std::vector<float> u(numUVs), v(numUVs);
+      for (size_t i=0; i<numUVs; i++) 
+      {
+        const size_t r = size_t(3.0f*drand48());
+        geomIDs[i] = r == 0 ? geomID0 : r == 1 ? geomID1 : RTC_INVALID_GEOMETRY_ID;
+        primIDs[i] = geomIDs[i] == geomID0 ? i%num_interpolation_quad_faces : i%num_interpolation_triangle_faces;
+        u[i] = 0.5f*drand48(); v[i] = 0.5f*drand48();
+      }
+
+      std::vector<float> P(numUVs*N+16,-1.0f), dPdu(numUVs*N+16,-1.0f), dPdv(numUVs*N+16,-1.0f);
+      rtcInterpolateM(scene,geomIDs.data(),primIDs.data(),u.data(),v.data(),numUVs,RTC_USER_VERTEX_BUFFER0,
+                      P.data(),dPdu.data(),dPdv.data(),nullptr,nullptr,nullptr,N);
+      AssertNoError(device);
+
+      /* compare against single interpolations */
+      for (size_t i=0; i<numUVs; i++)
+      {
+        if (geomIDs[i] == RTC_INVALID_GEOMETRY_ID) {
+          if (P[i] != -1.0f) return VerifyApplication::FAILED;
+          continue;
+        }
+        float P1[256], dPdu1[256], dPdv1[256];
+        rtcInterpolate(scene,geomIDs[i],primIDs[i],u[i],v[i],RTC_USER_VERTEX_BUFFER0,P1,dPdu1,dPdv1,N);
+        for (size_t j=0; j<N; j++) {
+          if (fabs(P   [j*numUVs+i]-P1   [j]) > 1E-4f) return VerifyApplication::FAILED;
+          if (fabs(dPdu[j*numUVs+i]-dPdu1[j]) > 1E-3f) return VerifyApplication::FAILED;
+          if (fabs(dPdv[j*numUVs+i]-dPdv1[j]) > 1E-3f) return VerifyApplication::FAILED;
+        }
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
@@ -1579,6 +2493,167 @@ namespace embree
     }
   };
   
+  struct MotionBlurHitTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags; 
+    GeometryType gtype;
+    size_t numTimeSteps;
+
+    MotionBlurHitTest (std::string name, int isa, RTCSceneFlags sflags, GeometryType gtype, size_t numTimeSteps, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype), numTimeSteps(numTimeSteps) {}
+
+    /* the planes jump between x=0 at even and x=2 at odd time steps */
+    static float offset(size_t numTimeSteps, float time)
+    {
+      const float ftime = time*float(numTimeSteps-1);
+      const size_t itime = min(size_t(ftime),numTimeSteps-2);
+      const float t = ftime-float(itime);
+      const float x0 = (itime+0)%2 ? 2.0f : 0.0f;
+      const float x1 = (itime+1)%2 ? 2.0f : 0.0f;
+      return (1.0f-t)*x0 + t*x1;
+    }
+
+    unsigned addPlane(RTCScene scene, const float y, const size_t numTimeSteps)
+    {
+      unsigned geomID = 0;
+      if (gtype == QUAD_MESH_MB) {
+        geomID = rtcNewQuadMesh (scene, RTC_GEOMETRY_STATIC, 1, 4, numTimeSteps);
+        int* quads = (int*) rtcMapBuffer(scene,geomID,RTC_INDEX_BUFFER);
+        quads[0] = 0; quads[1] = 1; quads[2] = 2; quads[3] = 3;
+      } else {
+        geomID = rtcNewTriangleMesh (scene, RTC_GEOMETRY_STATIC, 2, 4, numTimeSteps);
+        int* triangles = (int*) rtcMapBuffer(scene,geomID,RTC_INDEX_BUFFER);
+        triangles[0] = 0; triangles[1] = 1; triangles[2] = 2; 
+        triangles[3] = 0; triangles[4] = 2; triangles[5] = 3; 
+      }
+      rtcUnmapBuffer(scene,geomID,RTC_INDEX_BUFFER);
+
+      for (size_t t=0; t<numTimeSteps; t++)
+      {
+        const RTCBufferType buffer = (RTCBufferType) (RTC_VERTEX_BUFFER0+t);
+        const float x = t%2 ? 2.0f : 0.0f;
+        Vec3fa* vertices = (Vec3fa*) rtcMapBuffer(scene,geomID,buffer);
+        vertices[0] = Vec3fa(x+0.0f,y+0.0f,0.0f);
+        vertices[1] = Vec3fa(x+1.0f,y+0.0f,0.0f);
+        vertices[2] = Vec3fa(x+1.0f,y+1.0f,0.0f);
+        vertices[3] = Vec3fa(x+0.0f,y+1.0f,0.0f);
+        rtcUnmapBuffer(scene,geomID,buffer);
+      }
+      return geomID;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device))
+        return VerifyApplication::SKIPPED;
+
+      /* planes with different number of time steps share the same BVH */
+      RTCSceneRef scene = rtcDeviceNewScene(device,sflags,to_aflags(imode));
+      const unsigned geomID0 = addPlane(scene,0.0f,numTimeSteps);
+      const unsigned geomID1 = addPlane(scene,2.0f,2);
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      /* shoot hit rays at even and miss rays at odd indices */
+      float times[256];
+      RTCRay rays[256];
+      for (size_t i=0; i<256; i++)
+      {
+        times[i] = i < 8 ? float(i%4)/3.0f : drand48();
+        const bool plane0 = (i/2)%2;
+        const float x = offset(plane0 ? numTimeSteps : 2,times[i]) + (i%2 ? -0.5f : 0.1f+0.8f*drand48());
+        const float y = (plane0 ? 0.0f : 2.0f) + 0.1f+0.8f*drand48();
+        rays[i] = makeRay(Vec3fa(x,y,-1.0f),Vec3fa(0.0f,0.0f,1.0f));
+        rays[i].time = times[i];
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t i=0; i<256; i++)
+      {
+        const bool plane0 = (i/2)%2;
+        if (i%2) {
+          if (rays[i].geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+          continue;
+        }
+        if (ivariant & VARIANT_OCCLUDED) {
+          if (rays[i].geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+          continue;
+        }
+        if (rays[i].geomID != (plane0 ? geomID0 : geomID1)) return VerifyApplication::FAILED;
+        if (abs(rays[i].tfar - 1.0f) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+      }
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+  
+  struct InstanceMotionBlurHitTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags; 
+    size_t numTimeSteps;
+
+    InstanceMotionBlurHitTest (std::string name, int isa, RTCSceneFlags sflags, size_t numTimeSteps, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), numTimeSteps(numTimeSteps) {}
+
+    /* the instance rotates by 90 degrees around the z-axis each time step */
+    Vec3fa center(float time) const 
+    {
+      const float angle = 0.5f*float(pi)*time*float(numTimeSteps-1);
+      return Vec3fa(2.0f*cos(angle),2.0f*sin(angle),0.0f);
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device))
+        return VerifyApplication::SKIPPED;
+
+      VerifyScene object(device,sflags,to_aflags(imode));
+      object.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(Vec3fa(2.0f,0.0f,0.0f),0.5f,32));
+      rtcCommit (object);
+
+      RTCSceneRef scene = rtcDeviceNewScene(device,sflags,to_aflags(imode));
+      const unsigned instID = rtcNewInstance2(scene,object,numTimeSteps);
+      for (size_t t=0; t<numTimeSteps; t++) {
+        const AffineSpace3fa xfm = AffineSpace3fa::rotate(Vec3fa(0,0,1),0.5f*float(pi)*float(t));
+        rtcSetTransform2(scene,instID,RTC_MATRIX_COLUMN_MAJOR_ALIGNED16,(float*)&xfm,t);
+      }
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      /* rays at even indices hit the rotating sphere, rays at odd indices
+       * point to where a linear interpolation of the matrices would move it */
+      RTCRay rays[256];
+      for (size_t i=0; i<256; i++)
+      {
+        const size_t segment = (i/2)%(numTimeSteps-1);
+        const float time = i%2 ? (float(segment)+0.5f)/float(numTimeSteps-1) : float(drand48());
+        const Vec3fa p = i%2 ? 0.5f*(center(float(segment+0)/float(numTimeSteps-1))+center(float(segment+1)/float(numTimeSteps-1)))
+                             : center(time) + Vec3fa(0.4f*float(drand48())-0.2f,0.4f*float(drand48())-0.2f,0.0f);
+        rays[i] = makeRay(Vec3fa(p.x,p.y,-10.0f),Vec3fa(0.0f,0.0f,1.0f));
+        rays[i].time = time;
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t i=0; i<256; i++)
+      {
+        if (i%2) {
+          if (rays[i].geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+          continue;
+        }
+        if (rays[i].geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+        if (ivariant & VARIANT_OCCLUDED) continue;
+        if (rays[i].geomID != 0 || rays[i].instID != instID) return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+  
   struct RayMasksTest : public VerifyApplication::IntersectTest
   {
     RTCSceneFlags sflags; 
@@ -2102,6 +3177,120 @@ namespace embree
     }
   };
   
+  struct SortedStreamTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags;
+    static const size_t N = 1000;
+    
+    SortedStreamTest (std::string name, int isa, RTCSceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device))
+        return VerifyApplication::SKIPPED;
+
+      VerifyScene scene(device,sflags,to_aflags(imode));
+      for (size_t i=0; i<32; i++) {
+        const Vec3fa p(4.0f*float(i%4),4.0f*float((i/4)%4),4.0f*float(i/16));
+        scene.addSphere(RTC_GEOMETRY_STATIC,p,1.0f,20);
+      }
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      /* sorted streams have to report the same hits as unsorted ones */
+      std::vector<RTCRay> rays0(N), rays1(N);
+      for (size_t i=0; i<size_t(10*state->intensity); i++) 
+      {
+        for (size_t j=0; j<N; j++) 
+        {
+          Vec3fa org(16.0f*drand48()-2.0f,16.0f*drand48()-2.0f,8.0f*drand48()-2.0f);
+          Vec3fa dir(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+          rays0[j] = rays1[j] = makeRay(org,dir); 
+        }
+        IntersectWithMode(imode,(IntersectVariant)(ivariant & ~VARIANT_SORTED),scene,rays0.data(),N);
+        IntersectWithMode(imode,ivariant,scene,rays1.data(),N);
+        
+        for (size_t j=0; j<N; j++) 
+        {
+          if (rays0[j].geomID != rays1[j].geomID) return VerifyApplication::FAILED;
+          if (ivariant & VARIANT_OCCLUDED) continue;
+          if (rays0[j].primID != rays1[j].primID) return VerifyApplication::FAILED;
+          if (abs(rays0[j].tfar - rays1[j].tfar) > 1E-5f*max(1.0f,rays0[j].tfar)) return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+  
+  struct QuantizedLeafTest : public VerifyApplication::IntersectTest
+  {
+    static const size_t maxStreamSize = 64;
+    
+    QuantizedLeafTest (std::string name, int isa, IntersectMode imode)
+      : VerifyApplication::IntersectTest(name,isa,imode,VARIANT_INTERSECT,VerifyApplication::TEST_SHOULD_PASS) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device))
+        return VerifyApplication::SKIPPED;
+
+      /* the triangle4q BVH stores quantized vertices in the leaves */
+      std::string qcfg = cfg + ",tri_accel=bvh4.triangle4q";
+      RTCDeviceRef qdevice = rtcNewDevice(qcfg.c_str());
+      error_handler(rtcDeviceGetError(qdevice));
+
+      const Vec3fa center(1000.0f,-20.0f,3.0f);
+      Ref<SceneGraph::Node> node = SceneGraph::createTriangleSphere(center,10.0f,100);
+      Ref<SceneGraph::TriangleMeshNode> mesh = node.dynamicCast<SceneGraph::TriangleMeshNode>();
+      VerifyScene scene0(device,RTC_SCENE_STATIC,to_aflags(imode));
+      VerifyScene scene1(qdevice,RTC_SCENE_STATIC,to_aflags(imode));
+      scene0.addGeometry(RTC_GEOMETRY_STATIC,node);
+      scene1.addGeometry(RTC_GEOMETRY_STATIC,node);
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      AssertNoError(device);
+      AssertNoError(qdevice);
+
+      /* rays towards the triangle centroids have to hit the same triangles at almost the same distance */
+      const size_t numTriangles = mesh->triangles.size();
+      for (auto ivariant : state->intersectVariants)
+      for (size_t i=0; i<numTriangles; i+=maxStreamSize)
+      {
+        const size_t M = min(maxStreamSize,numTriangles-i);
+        __aligned(16) RTCRay rays0[maxStreamSize];
+        __aligned(16) RTCRay rays1[maxStreamSize];
+        for (size_t j=0; j<M; j++) 
+        {
+          const SceneGraph::TriangleMeshNode::Triangle& tri = mesh->triangles[i+j];
+          const Vec3fa c = (mesh->v[tri.v0]+mesh->v[tri.v1]+mesh->v[tri.v2])*(1.0f/3.0f);
+          rays0[j] = rays1[j] = makeRay(center,c-center);
+        }
+        IntersectWithMode(imode,ivariant,scene0,rays0,M);
+        IntersectWithMode(imode,ivariant,scene1,rays1,M);
+        
+        for (size_t j=0; j<M; j++) 
+        {
+          if (rays0[j].geomID != rays1[j].geomID) return VerifyApplication::FAILED;
+          if (ivariant & VARIANT_OCCLUDED) continue;
+          if (rays0[j].primID != rays1[j].primID) return VerifyApplication::FAILED;
+          if (abs(rays0[j].tfar - rays1[j].tfar) > 1E-3f*rays0[j].tfar) return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+  
   struct NaNTest : public VerifyApplication::IntersectTest
   {
     RTCSceneFlags sflags;
@@ -2863,6 +4052,7 @@ namespace embree
 
       groups.top()->add(new UnmappedBeforeCommitTest("unmapped_before_commit",isa));
       groups.top()->add(new GetBoundsTest("get_bounds",isa));
+      groups.top()->add(new SceneCacheTest("scene_cache",isa));
       groups.top()->add(new GetUserDataTest("get_user_data",isa));
 
       push(new TestGroup("buffer_stride",true,true));
@@ -2915,6 +4105,31 @@ namespace embree
       }
       groups.pop();
 
+      push(new TestGroup("update_many_objects",true,true));
+      for (auto sflags : sceneFlagsDynamic) 
+        groups.top()->add(new UpdateManyObjectsTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("memory_pool",true,true));
+      for (auto sflags : sceneFlagsDynamic) 
+        groups.top()->add(new MemoryPoolTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("numa",true,true));
+      for (auto policy : { "interleave", "local" })
+        for (auto sflags : { RTC_SCENE_STATIC, RTC_SCENE_DYNAMIC })
+          groups.top()->add(new NumaPolicyTest(std::string(policy)+"."+to_string(sflags),isa,policy,sflags));
+      groups.pop();
+
+      groups.top()->add(new TessellationCacheTest("tessellation_cache."+stringOfISA(isa),isa));
+      groups.top()->add(new NestedInstanceTest("nested_instances."+stringOfISA(isa),isa));
+      groups.top()->add(new SpatialSplitTest("spatial_split.triangles."+stringOfISA(isa),isa,TRIANGLE_MESH));
+      groups.top()->add(new SpatialSplitTest("spatial_split.quads."+stringOfISA(isa),isa,QUAD_MESH));
+      groups.top()->add(new HairTessellationTest("hair_tessellation."+stringOfISA(isa),isa));
+      groups.top()->add(new UserGeometryBatchTest("user_geometry_batch."+stringOfISA(isa),isa));
+      groups.top()->add(new ConcurrentCommitTest("concurrent_commit."+stringOfISA(isa),isa));
+      groups.top()->add(new SceneStatisticsTest("scene_statistics."+stringOfISA(isa),isa));
+
       groups.top()->add(new GarbageGeometryTest("build_garbage_geom."+stringOfISA(isa),isa));
 
       /**************************************************************************/
@@ -2939,6 +4154,11 @@ namespace embree
         groups.top()->add(new InterpolateHairTest(std::to_string(long(s)),isa,s));
       groups.pop();
 
+      push(new TestGroup("stream",true,true));
+      for (auto s : interpolateTests) 
+        groups.top()->add(new InterpolateStreamTest(std::to_string(long(s)),isa,s));
+      groups.pop();
+
       groups.pop();
       
       /**************************************************************************/
@@ -2959,6 +4179,23 @@ namespace embree
             groups.top()->add(new QuadHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_STATIC,imode,ivariant));
       groups.pop();
 
+      push(new TestGroup("motion_blur_hit",true,true));
+      for (auto gtype : { TRIANGLE_MESH_MB, QUAD_MESH_MB })
+        for (auto numTimeSteps : { 3, 8 })
+          for (auto sflags : sceneFlags) 
+            for (auto imode : intersectModes) 
+              for (auto ivariant : intersectVariants)
+                groups.top()->add(new MotionBlurHitTest(to_string(gtype,sflags,imode,ivariant)+"."+std::to_string(long(numTimeSteps)),isa,sflags,gtype,numTimeSteps,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("instance_motion_blur_hit",true,true));
+      for (auto numTimeSteps : { 2, 3, 5 })
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              groups.top()->add(new InstanceMotionBlurHitTest(to_string(sflags,imode,ivariant)+"."+std::to_string(long(numTimeSteps)),isa,sflags,numTimeSteps,imode,ivariant));
+      groups.pop();
+
       if (rtcDeviceGetParameter1i(device,RTC_CONFIG_RAY_MASK)) 
       {
         push(new TestGroup("ray_masks",true,true));
@@ -3051,6 +4288,21 @@ namespace embree
         groups.pop();
       }
 
+      push(new TestGroup("sorted_stream_test",true,true)); {
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            if (imode >= MODE_INTERSECT1M)
+              for (auto ivariant : { VARIANT_INTERSECT_INCOHERENT_SORTED, VARIANT_OCCLUDED_INCOHERENT_SORTED })
+                groups.top()->add(new SortedStreamTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+        groups.pop();
+      }
+
+      push(new TestGroup("quantized_leaf_test",true,true)); {
+        for (auto imode : intersectModes) 
+          groups.top()->add(new QuantizedLeafTest(to_string(imode),isa,imode));
+        groups.pop();
+      }
+
       if (rtcDeviceGetParameter1i(device,RTC_CONFIG_IGNORE_INVALID_RAYS))
       {
         push(new TestGroup("nan_test",true,false));
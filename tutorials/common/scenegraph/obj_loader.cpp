@@ -16,6 +16,9 @@
 
 #include "obj_loader.h"
 #include "texture.h"
+#include "../../../kernels/algorithms/parallel_for.h"
+#include "../../../kernels/algorithms/sort.h"
+
 
 namespace embree
 {
@@ -34,11 +37,15 @@ namespace embree
     Crease(float w, int a, int b) : w(w), a(a), b(b) {};
   };
 
-  static inline bool operator < ( const Vertex& a, const Vertex& b ) {
-    if (a.v  != b.v)  return a.v  < b.v;
-    if (a.vn != b.vn) return a.vn < b.vn;
-    if (a.vt != b.vt) return a.vt < b.vt;
-    return false;
+  static inline bool operator == ( const Vertex& a, const Vertex& b ) {
+    return a.v == b.v && a.vt == b.vt && a.vn == b.vn;
+  }
+
+  /*! Number of bits required to store all values up to x. */
+  static inline size_t bitsFor(size_t x) {
+    size_t bits = 0;
+    while (x >> bits) bits++;
+    return bits;
   }
 
   /*! Fill space at the end of the token with 0s. */
@@ -100,6 +107,43 @@ namespace embree
     return Vec3f(x,y,z);
   }
 
+  /*! Copies the next line starting at ptr into the line buffer and
+   *  moves ptr behind it. Lines ending with a backslash continue on
+   *  the next line. */
+  static inline char* getLine(const char*& ptr, const char* end, std::vector<char>& line)
+  {
+    line.clear();
+    while (ptr < end)
+    {
+      const char* eol = (const char*) memchr(ptr,'\n',end-ptr);
+      if (eol == nullptr) eol = end;
+      line.insert(line.end(),ptr,eol);
+      ptr = eol < end ? eol+1 : end;
+      if (line.empty() || line.back() != '\\') break;
+      line.back() = ' ';
+    }
+    line.push_back(0);
+    return line.data();
+  }
+
+  /*! Returns the start of the first line that begins after ptr. */
+  static inline const char* nextLineBegin(const char* ptr, const char* begin, const char* end)
+  {
+    while (ptr < end)
+    {
+      const char* eol = (const char*) memchr(ptr,'\n',end-ptr);
+      if (eol == nullptr) return end;
+      if (eol == begin || eol[-1] != '\\') return eol+1;
+      ptr = eol+1;
+    }
+    return end;
+  }
+
+  /*! handles relative indices and starts indexing from 0 */
+  static inline int fixIndex(int index, size_t size) {
+    return index > 0 ? index - 1 : (index == 0 ? 0 : (int) size + index);
+  }
+
   class OBJLoader
   {
   public:
@@ -112,6 +156,59 @@ namespace embree
   
   private:
 
+    /*! Commands that have to get executed in file order. */
+    enum CommandType { USEMTL, MTLLIB, CREASE };
+
+    struct Command
+    {
+      Command (CommandType type, size_t numFaces, size_t numV, size_t numVt, size_t numVn)
+        : type(type), numFaces(numFaces), numV(numV), numVt(numVt), numVn(numVn) {}
+
+      CommandType type;
+      std::string name;           //!< material or material library name
+      Crease crease;              //!< edge crease
+      size_t numFaces;            //!< number of faces of the chunk before this command
+      size_t numV, numVt, numVn;  //!< number of vertices of the file before this command
+    };
+
+    /*! Part of the file that is parsed by a single task. */
+    struct Chunk
+    {
+      Chunk () : begin(nullptr), end(nullptr), numV(0), numVt(0), numVn(0), baseV(0), baseVt(0), baseVn(0) {}
+
+      size_t numFaces() const { return faceBegin.size(); }
+
+      const char* begin;
+      const char* end;
+      size_t numV, numVt, numVn;     //!< number of vertices inside this chunk
+      size_t baseV, baseVt, baseVn;  //!< number of vertices of all previous chunks
+
+      avector<Vec3fa> v;
+      avector<Vec3fa> vn;
+      std::vector<Vec2f> vt;
+      std::vector<Vertex> faceVertices;
+      std::vector<size_t> faceBegin;
+      std::vector<Command> commands;
+      std::string error;
+    };
+
+    /*! Faces of consecutive chunks that share the same material. */
+    struct FaceRange 
+    {
+      FaceRange (size_t chunk, size_t begin, size_t end)
+        : chunk(chunk), begin(begin), end(end) {}
+
+      size_t chunk, begin, end;
+    };
+
+    struct FaceGroup
+    {
+      Ref<SceneGraph::MaterialNode> material;
+      std::vector<FaceRange> faces;
+      std::vector<Crease> ec;
+      size_t numV, numVt, numVn;
+    };
+
     /*! file to load */
     FileName path;
   
@@ -122,9 +219,10 @@ namespace embree
     avector<Vec3fa> v;
     avector<Vec3fa> vn;
     std::vector<Vec2f> vt;
-    std::vector<Crease> ec;
 
-    std::vector<std::vector<Vertex> > curGroup;
+    std::vector<Chunk> chunks;
+    std::vector<FaceGroup> faceGroups;
+    FaceGroup curGroup;
 
     /*! Material handling. */
     std::string curMaterialName;
@@ -133,119 +231,232 @@ namespace embree
 
   private:
     void loadMTL(const FileName& fileName);
-    int fix_v (int index);
-    int fix_vt(int index);
-    int fix_vn(int index);
-    void flushFaceGroup();
-    Vertex getInt3(const char*& token);
-    uint32_t getVertex(std::map<Vertex,uint32_t>& vertexMap, Ref<SceneGraph::TriangleMeshNode> mesh, const Vertex& i);
+    void countVertices(Chunk& chunk);
+    void parseChunk(Chunk& chunk);
+    void flushFaceGroup(size_t numV, size_t numVt, size_t numVn);
+    Vertex getInt3(const char*& token, const Chunk& chunk);
+    Ref<SceneGraph::Node> createMesh(const FaceGroup& faceGroup);
+    void mergeVertices(const FaceGroup& faceGroup, const std::vector<Vertex>& corners, std::vector<uint32_t>& cornerVertex, std::vector<uint32_t>& firstCorner);
   };
 
   OBJLoader::OBJLoader(const FileName &fileName, const bool subdivMode) 
     : path(fileName.path()), group(new SceneGraph::GroupNode), subdivMode(subdivMode)
   {
-    /* open file */
-    std::ifstream cin;
-    cin.open(fileName.c_str());
-    if (!cin.is_open()) {
-      THROW_RUNTIME_ERROR("cannot open " + fileName.str());
-      return;
+    /* map file into memory, fall back to reading it if that fails (e.g. for empty files) */
+    size_t bytes = 0;
+    char* mem = (char*) os_map_file(fileName.c_str(),bytes);
+    std::vector<char> buffer;
+    if (mem == nullptr) 
+    {
+      std::ifstream cin;
+      cin.open(fileName.c_str(),std::ios::binary);
+      if (!cin.is_open()) {
+        THROW_RUNTIME_ERROR("cannot open " + fileName.str());
+        return;
+      }
+      buffer.assign(std::istreambuf_iterator<char>(cin),std::istreambuf_iterator<char>());
+      bytes = buffer.size();
+    }
+    const char* begin = mem ? mem : buffer.data();
+    const char* end = begin+bytes;
+
+    /* split file into chunks at line boundaries */
+    const size_t chunkBytes = 4*1024*1024;
+    const size_t numChunks = max(size_t(1),(bytes+chunkBytes-1)/chunkBytes);
+    chunks.resize(numChunks);
+    for (size_t i=0; i<numChunks; i++) {
+      chunks[i].begin = i == 0           ? begin : chunks[i-1].end;
+      chunks[i].end   = i == numChunks-1 ? end   : nextLineBegin(std::max(chunks[i].begin,begin+(i+1)*bytes/numChunks),begin,end);
+    }
+
+    /* count vertices per chunk to resolve relative indices while parsing */
+    parallel_for(numChunks, [&](const size_t i) { countVertices(chunks[i]); });
+    for (size_t i=1; i<numChunks; i++) {
+      chunks[i].baseV  = chunks[i-1].baseV  + chunks[i-1].numV;
+      chunks[i].baseVt = chunks[i-1].baseVt + chunks[i-1].numVt;
+      chunks[i].baseVn = chunks[i-1].baseVn + chunks[i-1].numVn;
     }
 
+    /* parse all chunks in parallel */
+    parallel_for(numChunks, [&](const size_t i) { parseChunk(chunks[i]); });
+    if (mem) os_unmap_file(mem,bytes);
+    for (size_t i=0; i<numChunks; i++)
+      if (chunks[i].error != "") THROW_RUNTIME_ERROR(chunks[i].error);
+
+    /* merge vertex arrays */
+    const Chunk& last = chunks[numChunks-1];
+    v .resize(last.baseV +last.numV);
+    vt.resize(last.baseVt+last.numVt);
+    vn.resize(last.baseVn+last.numVn);
+    parallel_for(numChunks, [&](const size_t i) 
+    {
+      Chunk& chunk = chunks[i];
+      for (size_t j=0; j<chunk.v .size(); j++) v [chunk.baseV +j] = chunk.v [j];
+      for (size_t j=0; j<chunk.vt.size(); j++) vt[chunk.baseVt+j] = chunk.vt[j];
+      for (size_t j=0; j<chunk.vn.size(); j++) vn[chunk.baseVn+j] = chunk.vn[j];
+      chunk.v.clear(); chunk.vt.clear(); chunk.vn.clear();
+    });
+
     /* generate default material */
     Material objmtl; new (&objmtl) OBJMaterial;
     Ref<SceneGraph::MaterialNode> defaultMaterial = new SceneGraph::MaterialNode(objmtl);
     curMaterialName = "default";
     curMaterial = defaultMaterial;
 
-    char line[10000];
-    memset(line, 0, sizeof(line));
+    /* execute material commands in file order to split faces into groups */
+    for (size_t i=0; i<numChunks; i++)
+    {
+      const Chunk& chunk = chunks[i];
+      size_t face = 0;
+      for (size_t j=0; j<chunk.commands.size(); j++)
+      {
+        const Command& cmd = chunk.commands[j];
+        if (face < cmd.numFaces) curGroup.faces.push_back(FaceRange(i,face,cmd.numFaces));
+        face = cmd.numFaces;
 
-    while (cin.peek() != -1)
+        switch (cmd.type) 
+        {
+        case CREASE: 
+          curGroup.ec.push_back(cmd.crease); 
+          break;
+
+        case USEMTL:
+          flushFaceGroup(cmd.numV,cmd.numVt,cmd.numVn);
+          if (material.find(cmd.name) == material.end()) {
+            curMaterial = defaultMaterial;
+            curMaterialName = "default";
+          }
+          else {
+            curMaterial = material[cmd.name];
+            curMaterialName = cmd.name;
+          }
+          break;
+
+        case MTLLIB:
+          loadMTL(path + cmd.name);
+          break;
+        }
+      }
+      if (face < chunk.numFaces()) curGroup.faces.push_back(FaceRange(i,face,chunk.numFaces()));
+    }
+    flushFaceGroup(v.size(),vt.size(),vn.size());
+
+    /* create meshes of all face groups in parallel */
+    std::vector<Ref<SceneGraph::Node> > meshes(faceGroups.size());
+    std::vector<std::string> errors(faceGroups.size());
+    parallel_for(faceGroups.size(), [&](const size_t i) 
     {
-      /* load next multiline */
-      char* pline = line;
-      while (true) {
-        cin.getline(pline, sizeof(line) - (pline - line) - 16, '\n');
-        ssize_t last = strlen(pline) - 1;
-        if (last < 0 || pline[last] != '\\') break;
-        pline += last;
-        *pline++ = ' ';
+      try {
+        meshes[i] = createMesh(faceGroups[i]);
+      } 
+      catch (const std::exception& e) {
+        errors[i] = e.what();
       }
+    });
+    for (size_t i=0; i<faceGroups.size(); i++) {
+      if (errors[i] != "") THROW_RUNTIME_ERROR(errors[i]);
+      group->add(meshes[i]);
+    }
+  }
 
-      const char* token = trimEnd(line + strspn(line, " \t"));
+  /*! counts the vertex positions, texture coordinates, and normals of a chunk */
+  void OBJLoader::countVertices(Chunk& chunk)
+  {
+    std::vector<char> line;
+    const char* ptr = chunk.begin;
+    while (ptr < chunk.end)
+    {
+      const char* token = trimEnd(getLine(ptr,chunk.end,line));
+      token += strspn(token, " \t");
+      if (token[0] != 'v') continue;
+      if (isSep(token[1])) chunk.numV++;
+      else if (token[1] == 't' && isSep(token[2])) chunk.numVt++;
+      else if (token[1] == 'n' && isSep(token[2])) chunk.numVn++;
+    }
+  }
+
+  /*! parses the vertices, faces, and commands of a chunk */
+  void OBJLoader::parseChunk(Chunk& chunk) try
+  {
+    chunk.v .reserve(chunk.numV);
+    chunk.vt.reserve(chunk.numVt);
+    chunk.vn.reserve(chunk.numVn);
+
+    std::vector<char> line;
+    const char* ptr = chunk.begin;
+    while (ptr < chunk.end)
+    {
+      char* pline = getLine(ptr,chunk.end,line);
+      const char* token = trimEnd(pline + strspn(pline, " \t"));
       if (token[0] == 0) continue;
 
       /*! parse position */
       if (token[0] == 'v' && isSep(token[1])) { 
-        v.push_back(getVec3f(token += 2)); continue;
+        chunk.v.push_back(getVec3f(token += 2)); continue;
       }
 
       /* parse normal */
       if (token[0] == 'v' && token[1] == 'n' && isSep(token[2])) { 
-        vn.push_back(getVec3f(token += 3)); 
+        chunk.vn.push_back(getVec3f(token += 3)); 
         continue; 
       }
 
       /* parse texcoord */
-      if (token[0] == 'v' && token[1] == 't' && isSep(token[2])) { vt.push_back(getVec2f(token += 3)); continue; }
+      if (token[0] == 'v' && token[1] == 't' && isSep(token[2])) { chunk.vt.push_back(getVec2f(token += 3)); continue; }
 
       /*! parse face */
       if (token[0] == 'f' && isSep(token[1]))
       {
         parseSep(token += 1);
 
-        std::vector<Vertex> face;
+        chunk.faceBegin.push_back(chunk.faceVertices.size());
         while (token[0]) {
-	  Vertex vtx = getInt3(token);
-          face.push_back(vtx);
+          Vertex vtx = getInt3(token,chunk);
+          chunk.faceVertices.push_back(vtx);
           parseSepOpt(token);
         }
-        curGroup.push_back(face);
         continue;
       }
 
+      Command cmd(USEMTL,chunk.numFaces(),chunk.baseV+chunk.v.size(),chunk.baseVt+chunk.vt.size(),chunk.baseVn+chunk.vn.size());
+
       /*! parse edge crease */
       if (token[0] == 'e' && token[1] == 'c' && isSep(token[2]))
       {
 	parseSep(token += 2);
 	float w = getFloat(token);
 	parseSepOpt(token);
-	int a = fix_v(getInt(token));
+	int a = fixIndex(getInt(token),cmd.numV);
 	parseSepOpt(token);
-	int b = fix_v(getInt(token));
+	int b = fixIndex(getInt(token),cmd.numV);
 	parseSepOpt(token);
-	ec.push_back(Crease(w, a, b));
+        cmd.type = CREASE;
+        cmd.crease = Crease(w, a, b);
+        chunk.commands.push_back(cmd);
 	continue;
       }
 
       /*! use material */
       if (!strncmp(token, "usemtl", 6) && isSep(token[6]))
       {
-        flushFaceGroup();
-        std::string name(parseSep(token += 6));
-        if (material.find(name) == material.end()) {
-          curMaterial = defaultMaterial;
-          curMaterialName = "default";
-        }
-        else {
-          curMaterial = material[name];
-          curMaterialName = name;
-        }
+        cmd.name = parseSep(token += 6);
+        chunk.commands.push_back(cmd);
         continue;
       }
 
       /* load material library */
       if (!strncmp(token, "mtllib", 6) && isSep(token[6])) {
-        loadMTL(path + std::string(parseSep(token += 6)));
+        cmd.type = MTLLIB;
+        cmd.name = parseSep(token += 6);
+        chunk.commands.push_back(cmd);
         continue;
       }
 
       // ignore unknown stuff
     }
-    flushFaceGroup();
-
-    cin.close();
+  }
+  catch (const std::exception& e) {
+    chunk.error = e.what();
   }
 
   struct ExtObjMaterial : public OBJMaterial
@@ -402,17 +613,12 @@ namespace embree
     cin.close();
   }
 
-  /*! handles relative indices and starts indexing from 0 */
-  int OBJLoader::fix_v (int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) v .size() + index)); }
-  int OBJLoader::fix_vt(int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) vt.size() + index)); }
-  int OBJLoader::fix_vn(int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) vn.size() + index)); }
-
   /*! Parse differently formated triplets like: n0, n0/n1/n2, n0//n2, n0/n1.          */
   /*! All indices are converted to C-style (from 0). Missing entries are assigned -1. */
-  Vertex OBJLoader::getInt3(const char*& token)
+  Vertex OBJLoader::getInt3(const char*& token, const Chunk& chunk)
   {
     Vertex v(-1);
-    v.v = fix_v(atoi(token));
+    v.v = fixIndex(atoi(token),chunk.baseV+chunk.v.size());
     token += strcspn(token, "/ \t\r");
     if (token[0] != '/') return(v);
     token++;
@@ -420,102 +626,189 @@ namespace embree
     // it is i//n
     if (token[0] == '/') {
       token++;
-      v.vn = fix_vn(atoi(token));
+      v.vn = fixIndex(atoi(token),chunk.baseVn+chunk.vn.size());
       token += strcspn(token, " \t\r");
       return(v);
     }
 
     // it is i/t/n or i/t
-    v.vt = fix_vt(atoi(token));
+    v.vt = fixIndex(atoi(token),chunk.baseVt+chunk.vt.size());
     token += strcspn(token, "/ \t\r");
     if (token[0] != '/') return(v);
     token++;
 
     // it is i/t/n
-    v.vn = fix_vn(atoi(token));
+    v.vn = fixIndex(atoi(token),chunk.baseVn+chunk.vn.size());
     token += strcspn(token, " \t\r");
     return(v);
   }
 
-  uint32_t OBJLoader::getVertex(std::map<Vertex,uint32_t>& vertexMap, Ref<SceneGraph::TriangleMeshNode> mesh, const Vertex& i)
+  /*! merges identical corners of a face group into one vertex each, by sorting the corners by their
+   *  three indices, vertices get numbered in the order of their first corner */
+  void OBJLoader::mergeVertices(const FaceGroup& faceGroup, const std::vector<Vertex>& corners, std::vector<uint32_t>& cornerVertex, std::vector<uint32_t>& firstCorner)
   {
-    const std::map<Vertex, uint32_t>::iterator& entry = vertexMap.find(i);
-    if (entry != vertexMap.end()) return(entry->second);
-    mesh->v.push_back(Vec3fa(v[i.v].x,v[i.v].y,v[i.v].z));
-    if (i.vn >= 0) {
-      while (mesh->vn.size() < mesh->v.size()) mesh->vn.push_back(zero); // some vertices might not had a normal
-      mesh->vn[mesh->v.size()-1] = vn[i.vn];
+    const size_t N = corners.size();
+    std::vector<uint64_t> keys(N), tmpKeys(N);
+    std::vector<uint32_t> order(N), tmpOrder(N);
+    parallel_for(N, [&](const size_t i) { order[i] = uint32_t(i); });
+
+    /* indices are stored with an offset of one, as -1 marks a missing normal or texture coordinate */
+    const size_t bitsV  = bitsFor(faceGroup.numV);
+    const size_t bitsVt = bitsFor(faceGroup.numVt);
+    const size_t bitsVn = bitsFor(faceGroup.numVn);
+
+    /* a single sort if all three indices fit into one key, otherwise sort by the normal first as the radix sort is stable */
+    if (bitsV+bitsVt+bitsVn <= 64) 
+    {
+      parallel_for(N, [&](const size_t i) { 
+        const Vertex& c = corners[i];
+        keys[i] = (uint64_t(c.v+1) << (bitsVt+bitsVn)) | (uint64_t(c.vt+1) << bitsVn) | uint64_t(c.vn+1);
+      });
+      radix_sort_key_value<uint64_t,uint32_t>(keys.data(),order.data(),tmpKeys.data(),tmpOrder.data(),N);
+    }
+    else
+    {
+      parallel_for(N, [&](const size_t i) { keys[i] = uint64_t(corners[i].vn+1); });
+      radix_sort_key_value<uint64_t,uint32_t>(keys.data(),order.data(),tmpKeys.data(),tmpOrder.data(),N);
+      parallel_for(N, [&](const size_t i) { 
+        const Vertex& c = corners[order[i]];
+        keys[i] = (uint64_t(c.v+1) << 32) | uint64_t(c.vt+1);
+      });
+      radix_sort_key_value<uint64_t,uint32_t>(keys.data(),order.data(),tmpKeys.data(),tmpOrder.data(),N);
+    }
+
+    /* equal corners are now adjacent, the first of them is the leader as the sort is stable */
+    std::vector<uint32_t>& leader = tmpOrder;
+    std::vector<uint32_t> isFirst(N,0);
+    for (size_t i=0; i<N; i++) {
+      const bool first = i == 0 || !(corners[order[i]] == corners[order[i-1]]);
+      leader[i] = first ? order[i] : leader[i-1];
+      isFirst[order[i]] = first;
     }
-    if (i.vt >= 0) {
-      while (mesh->vt.size() < mesh->v.size()) mesh->vt.push_back(zero); // some vertices might not had a texture coordinate
-      mesh->vt[mesh->v.size()-1] = vt[i.vt];
+
+    /* number vertices in the order of their first corner */
+    std::vector<uint32_t>& vertexID = isFirst;
+    firstCorner.clear();
+    for (size_t i=0; i<N; i++) {
+      if (!isFirst[i]) continue;
+      vertexID[i] = uint32_t(firstCorner.size());
+      firstCorner.push_back(uint32_t(i));
     }
-    return(vertexMap[i] = int(mesh->v.size()) - 1);
+
+    cornerVertex.resize(N);
+    parallel_for(N, [&](const size_t i) { cornerVertex[order[i]] = vertexID[leader[i]]; });
   }
 
-  /*! end current facegroup and append to mesh */
-  void OBJLoader::flushFaceGroup()
+  /*! end current facegroup, the mesh gets created later */
+  void OBJLoader::flushFaceGroup(size_t numV, size_t numVt, size_t numVn)
   {
-    if (curGroup.empty()) return;
+    if (curGroup.faces.empty()) return;
+    curGroup.material = curMaterial;
+    curGroup.numV = numV;
+    curGroup.numVt = numVt;
+    curGroup.numVn = numVn;
+    faceGroups.push_back(curGroup);
+    curGroup.faces.clear();
+    curGroup.ec.clear();
+  }
 
+  /*! creates the mesh of a facegroup */
+  Ref<SceneGraph::Node> OBJLoader::createMesh(const FaceGroup& faceGroup)
+  {
     if (subdivMode)
     {
-      Ref<SceneGraph::SubdivMeshNode> mesh = new SceneGraph::SubdivMeshNode(curMaterial);
-      group->add(mesh.cast<SceneGraph::Node>());
+      Ref<SceneGraph::SubdivMeshNode> mesh = new SceneGraph::SubdivMeshNode(faceGroup.material);
 
-      for (size_t i=0; i<v.size();  i++) mesh->positions.push_back(v[i]);
-      for (size_t i=0; i<vn.size(); i++) mesh->normals  .push_back(vn[i]);
-      for (size_t i=0; i<vt.size(); i++) mesh->texcoords.push_back(vt[i]);
+      for (size_t i=0; i<faceGroup.numV;  i++) mesh->positions.push_back(v[i]);
+      for (size_t i=0; i<faceGroup.numVn; i++) mesh->normals  .push_back(vn[i]);
+      for (size_t i=0; i<faceGroup.numVt; i++) mesh->texcoords.push_back(vt[i]);
       
+      const std::vector<Crease>& ec = faceGroup.ec;
       for (size_t i=0; i<ec.size(); ++i) {
-        assert(ec[i].a < v.size() && ec[i].b < v.size());
+        assert(ec[i].a < faceGroup.numV && ec[i].b < faceGroup.numV);
         mesh->edge_creases.push_back(Vec2i(ec[i].a, ec[i].b));
         mesh->edge_crease_weights.push_back(ec[i].w);
       }
       
-      for (size_t j=0; j<curGroup.size(); j++)
+      for (size_t r=0; r<faceGroup.faces.size(); r++)
       {
-        const std::vector<Vertex>& face = curGroup[j];
-        mesh->verticesPerFace.push_back(face.size());
-        for (size_t i=0; i<face.size(); i++)
-          mesh->position_indices.push_back(face[i].v);
+        const Chunk& chunk = chunks[faceGroup.faces[r].chunk];
+        for (size_t j=faceGroup.faces[r].begin; j<faceGroup.faces[r].end; j++)
+        {
+          const size_t begin = chunk.faceBegin[j];
+          const size_t end = j+1 < chunk.numFaces() ? chunk.faceBegin[j+1] : chunk.faceVertices.size();
+          mesh->verticesPerFace.push_back(end-begin);
+          for (size_t i=begin; i<end; i++)
+            mesh->position_indices.push_back(chunk.faceVertices[i].v);
+        }
       }
       mesh->verify();
+      return mesh.cast<SceneGraph::Node>();
     }
     else
     {
-      Ref<SceneGraph::TriangleMeshNode> mesh = new SceneGraph::TriangleMeshNode(curMaterial);
-      group->add(mesh.cast<SceneGraph::Node>());
+      Ref<SceneGraph::TriangleMeshNode> mesh = new SceneGraph::TriangleMeshNode(faceGroup.material);
+
+      size_t numFaceVertices = 0;
+      for (size_t r=0; r<faceGroup.faces.size(); r++) {
+        const Chunk& chunk = chunks[faceGroup.faces[r].chunk];
+        const size_t end = faceGroup.faces[r].end < chunk.numFaces() ? chunk.faceBegin[faceGroup.faces[r].end] : chunk.faceVertices.size();
+        numFaceVertices += end - chunk.faceBegin[faceGroup.faces[r].begin];
+      }
       
-      // merge three indices into one
-      std::map<Vertex, uint32_t> vertexMap;
-      for (size_t j=0; j<curGroup.size(); j++)
+      /* gather the corners of all faces that get triangulated */
+      std::vector<Vertex> corners; corners.reserve(numFaceVertices);
+      std::vector<uint32_t> faceSizes;
+      for (size_t r=0; r<faceGroup.faces.size(); r++)
       {
-        /* iterate over all faces */
-        const std::vector<Vertex>& face = curGroup[j];
-        
-        /* triangulate the face with a triangle fan */
-        Vertex i0 = face[0], i1 = Vertex(-1), i2 = face[1];
-        for (size_t k=2; k < face.size(); k++) 
+        const Chunk& chunk = chunks[faceGroup.faces[r].chunk];
+        for (size_t j=faceGroup.faces[r].begin; j<faceGroup.faces[r].end; j++)
         {
-          i1 = i2; i2 = face[k];
-          uint32_t v0,v1,v2;
-          v0 = getVertex(vertexMap, mesh, i0);
-          v1 = getVertex(vertexMap, mesh, i1);
-          v2 = getVertex(vertexMap, mesh, i2);
-          assert(v0 < mesh->v.size());
-          assert(v1 < mesh->v.size());
-          assert(v2 < mesh->v.size());
-          mesh->triangles.push_back(SceneGraph::TriangleMeshNode::Triangle(v0,v1,v2));
+          const size_t begin = chunk.faceBegin[j];
+          const size_t end = j+1 < chunk.numFaces() ? chunk.faceBegin[j+1] : chunk.faceVertices.size();
+          if (end-begin < 3) continue;
+          corners.insert(corners.end(),&chunk.faceVertices[begin],&chunk.faceVertices[begin]+(end-begin));
+          faceSizes.push_back(uint32_t(end-begin));
+        }
+      }
+
+      /* merge three indices into one */
+      std::vector<uint32_t> cornerVertex, firstCorner;
+      mergeVertices(faceGroup,corners,cornerVertex,firstCorner);
+
+      /* some vertices might not have a normal or texture coordinate */
+      const size_t numVertices = firstCorner.size();
+      bool hasNormals = false, hasTexCoords = false;
+      for (size_t i=0; i<numVertices; i++) {
+        hasNormals   |= corners[firstCorner[i]].vn >= 0;
+        hasTexCoords |= corners[firstCorner[i]].vt >= 0;
+      }
+      mesh->v.resize(numVertices);
+      if (hasNormals  ) mesh->vn.resize(numVertices);
+      if (hasTexCoords) mesh->vt.resize(numVertices);
+      parallel_for(numVertices, [&](const size_t i) 
+      {
+        const Vertex& c = corners[firstCorner[i]];
+        mesh->v[i] = Vec3fa(v[c.v].x,v[c.v].y,v[c.v].z);
+        if (hasNormals  ) mesh->vn[i] = c.vn >= 0 ? vn[c.vn] : Vec3fa(zero);
+        if (hasTexCoords) mesh->vt[i] = c.vt >= 0 ? vt[c.vt] : Vec2f(zero);
+      });
+
+      /* triangulate the faces with triangle fans */
+      size_t first = 0;
+      for (size_t f=0; f<faceSizes.size(); f++)
+      {
+        const uint32_t* face = &cornerVertex[first];
+        for (size_t k=2; k<faceSizes[f]; k++) {
+          assert(face[0] < mesh->v.size() && face[k-1] < mesh->v.size() && face[k] < mesh->v.size());
+          mesh->triangles.push_back(SceneGraph::TriangleMeshNode::Triangle(face[0],face[k-1],face[k]));
         }
+        first += faceSizes[f];
       }
-      /* there may be vertices without normals or texture coordinates, thus we have to make these arrays the same size here */
-      if (mesh->vn.size()) while (mesh->vn.size() < mesh->v.size()) mesh->vn.push_back(zero);
-      if (mesh->vt.size()) while (mesh->vt.size() < mesh->v.size()) mesh->vt.push_back(zero);
+
       mesh->verify();
+      return mesh.cast<SceneGraph::Node>();
     }
-    curGroup.clear();
-    ec.clear();
   }
   
   Ref<SceneGraph::Node> loadOBJ(const FileName& fileName, const bool subdivMode) {
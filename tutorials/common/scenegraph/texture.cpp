@@ -28,10 +28,10 @@ namespace embree
   std::map<std::string,Texture*> texture_cache;
 
   Texture::Texture () 
-    : width(-1), height(-1), format(INVALID), bytesPerTexel(0), data(nullptr), width_mask(0), height_mask(0) {}
+    : width(-1), height(-1), format(INVALID), bytesPerTexel(0), data(nullptr), cache(nullptr), width_mask(0), height_mask(0) {}
   
   Texture::Texture(Ref<Image> img, const std::string fileName)
-    : width(img->width), height(img->height), format(RGBA8), bytesPerTexel(4), data(nullptr), width_mask(0), height_mask(0), fileName(fileName)
+    : width(img->width), height(img->height), format(RGBA8), bytesPerTexel(4), data(nullptr), cache(nullptr), width_mask(0), height_mask(0), fileName(fileName)
   {
     width_mask  = isPowerOf2(width) ? width-1 : 0;
     height_mask = isPowerOf2(height) ? height-1 : 0;
@@ -41,7 +41,7 @@ namespace embree
   }
 
   Texture::Texture (size_t width, size_t height, const Format format, const char* in)
-    : width(width), height(height), format(format), bytesPerTexel(getFormatBytesPerTexel(format)), data(nullptr), width_mask(0), height_mask(0)
+    : width(width), height(height), format(format), bytesPerTexel(getFormatBytesPerTexel(format)), data(nullptr), cache(nullptr), width_mask(0), height_mask(0)
   {
     width_mask  = isPowerOf2(width) ? width-1 : 0;
     height_mask = isPowerOf2(height) ? height-1 : 0;
@@ -51,6 +51,9 @@ namespace embree
     else    memset(data,0 ,bytesPerTexel*width*height);
   }
 
+  Texture::Texture (TextureCache::Entry* cache, const std::string fileName)
+    : width(-1), height(-1), format(RGBA8), bytesPerTexel(4), data(nullptr), cache(cache), width_mask(0), height_mask(0), fileName(fileName) {}
+
   Texture::~Texture () {
     _mm_free(data);
   }
@@ -89,6 +92,9 @@ namespace embree
     if (texture_cache.find(fileName.str()) != texture_cache.end())
       return texture_cache[fileName.str()];
 
+    if (TextureCache::enabled())
+      return texture_cache[fileName.str()] = new Texture(TextureCache::add(fileName),fileName);
+
     return texture_cache[fileName.str()] = new Texture(loadImage(fileName),fileName);
   }
 }
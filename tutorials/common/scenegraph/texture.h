@@ -18,6 +18,7 @@
 
 #include "../default.h"
 #include "../image/image.h"
+#include "texture_cache.h"
 
 namespace embree
 {
@@ -34,6 +35,7 @@ namespace embree
     Texture (); 
     Texture (Ref<Image> image, const std::string fileName); 
     Texture (size_t width, size_t height, const Format format, const char* in = nullptr);
+    Texture (TextureCache::Entry* cache, const std::string fileName);
     ~Texture ();
 
     static const char* format_to_string(const Format format);
@@ -50,6 +52,7 @@ namespace embree
     int width_mask;
     int height_mask;
     void* data;
+    TextureCache::Entry* cache;  //!< set instead of data for textures loaded through the texture cache
     std::string fileName;
   };
 }
@@ -0,0 +1,469 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "texture_cache.h"
+#include "../image/image.h"
+#include "../../../common/sys/condition.h"
+#include "../../../common/sys/thread.h"
+
+#include <algorithm>
+#include <iostream>
+
+#if defined(__WIN32__)
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace embree
+{
+  static const size_t TILE_BYTES = TextureCache::TILE_SIZE*TextureCache::TILE_SIZE*sizeof(unsigned int);
+
+  /* render task state of each thread that looked up textures */
+  struct TextureCacheThread
+  {
+    TextureCacheThread () : epoch(0), depth(0), next(nullptr) {}
+
+    std::atomic<size_t> epoch;   //!< epoch at the begin of the current task, 0 outside of tasks
+    size_t depth;                //!< nesting depth of tasks
+    TextureCacheThread* next;
+  };
+
+  static __thread TextureCacheThread* t_thread = nullptr;
+  static std::atomic<TextureCacheThread*> g_threads(nullptr);
+  static std::atomic<size_t> g_epoch(1);
+
+  static MutexSys g_mutex;                                 //!< protects everything below
+  static bool g_enabled = false;
+  static size_t g_memoryBudget = 0;
+  static std::atomic<size_t> g_memoryUsed(0);              //!< resident and retired tiles
+  static std::atomic<size_t> g_time(0);                    //!< increased with each tile load
+  static std::vector<TextureCache::Tile*> g_resident;      //!< tiles currently referenced by some level
+  static std::vector<TextureCache::Tile*> g_retired;       //!< evicted tiles render tasks may still read
+  static std::vector<std::unique_ptr<TextureCache::Entry>> g_entries;
+
+  /* backing file shared by all textures */
+  static MutexSys g_fileMutex;
+  static FILE* g_file = nullptr;
+  static size_t g_fileSize = 0;
+
+  /* limits the number of images that get decoded at the same time */
+  static MutexSys g_decodeMutex;
+  static ConditionSys g_decodeCondition;
+  static size_t g_numDecodes = 0;
+
+  static bool readAt(void* ptr, size_t bytes, size_t offset)
+  {
+#if defined(__WIN32__)
+    HANDLE handle = (HANDLE) _get_osfhandle(_fileno(g_file));
+    OVERLAPPED overlapped; memset(&overlapped,0,sizeof(overlapped));
+    overlapped.Offset     = DWORD(offset);
+    overlapped.OffsetHigh = DWORD(uint64_t(offset) >> 32);
+    DWORD numBytes = 0;
+    return ReadFile(handle,ptr,DWORD(bytes),&numBytes,&overlapped) && numBytes == bytes;
+#else
+    return pread(fileno(g_file),ptr,bytes,off_t(offset)) == ssize_t(bytes);
+#endif
+  }
+
+  static bool writeAt(const void* ptr, size_t bytes, size_t offset)
+  {
+#if defined(__WIN32__)
+    HANDLE handle = (HANDLE) _get_osfhandle(_fileno(g_file));
+    OVERLAPPED overlapped; memset(&overlapped,0,sizeof(overlapped));
+    overlapped.Offset     = DWORD(offset);
+    overlapped.OffsetHigh = DWORD(uint64_t(offset) >> 32);
+    DWORD numBytes = 0;
+    return WriteFile(handle,ptr,DWORD(bytes),&numBytes,&overlapped) && numBytes == bytes;
+#else
+    return pwrite(fileno(g_file),ptr,bytes,off_t(offset)) == ssize_t(bytes);
+#endif
+  }
+
+  /*! reserves bytes in the backing file and returns their offset */
+  static size_t allocFile(const size_t bytes)
+  {
+    Lock<MutexSys> lock(g_fileMutex);
+    if (!g_file) {
+      g_file = tmpfile();
+      if (!g_file) THROW_RUNTIME_ERROR("cannot create texture cache file");
+    }
+    const size_t offset = g_fileSize;
+    g_fileSize += bytes;
+    return offset;
+  }
+
+  /*! checks that an image file can be opened and starts with the signature its extension requires */
+  static void checkImageHeader(const FileName& fileName)
+  {
+    FILE* file = fopen(fileName.c_str(),"rb");
+    if (!file) THROW_RUNTIME_ERROR("cannot open " + fileName.str());
+    unsigned char header[4] = { 0, 0, 0, 0 };
+    const size_t bytes = fread(header,1,sizeof(header),file);
+    fclose(file);
+    if (bytes == 0) THROW_RUNTIME_ERROR("Error reading " + fileName.str());
+
+    const std::string ext = toLowerCase(fileName.ext());
+    bool valid = true;
+    if      (ext == "ppm") valid = header[0] == 'P' && (header[1] == '3' || header[1] == '6');
+    else if (ext == "pfm") valid = header[0] == 'P' && (header[1] == 'F' || header[1] == 'f');
+    else if (ext == "png") valid = bytes == 4 && header[0] == 0x89 && header[1] == 'P' && header[2] == 'N' && header[3] == 'G';
+    else if (ext == "jpg") valid = header[0] == 0xFF && header[1] == 0xD8;
+    else if (ext == "exr") valid = bytes == 4 && header[0] == 0x76 && header[1] == 0x2F && header[2] == 0x31 && header[3] == 0x01;
+    else if (ext == "bmp") valid = header[0] == 'B' && header[1] == 'M';
+    else if (ext == "gif") valid = bytes >= 3 && header[0] == 'G' && header[1] == 'I' && header[2] == 'F';
+    else if (ext == "tif" || ext == "tiff") valid = (header[0] == 'I' && header[1] == 'I') || (header[0] == 'M' && header[1] == 'M');
+    if (!valid) THROW_RUNTIME_ERROR("invalid image header in " + fileName.str());
+  }
+
+  TextureCache::Entry::Entry (const FileName& fileName)
+    : fileName(fileName), initialized(false), failed(false) {}
+
+  TextureCache::Entry::~Entry ()
+  {
+    for (size_t i=0; i<levels.size(); i++)
+      delete[] levels[i].tiles;
+  }
+
+  /*! writes all tiles of one mip level, border tiles get padded by clamping */
+  static void writeLevel(const TextureCache::Level& level, const unsigned int* texels, const FileName& fileName)
+  {
+    const int S = TextureCache::TILE_SIZE;
+    std::vector<unsigned int> tile(S*S);
+    for (int ty=0; ty<level.tilesY; ty++)
+    {
+      for (int tx=0; tx<level.tilesX; tx++)
+      {
+        for (int y=0; y<S; y++) {
+          const int iy = min(ty*S+y,level.height-1);
+          for (int x=0; x<S; x++) {
+            const int ix = min(tx*S+x,level.width-1);
+            tile[y*S+x] = texels[size_t(iy)*level.width+ix];
+          }
+        }
+        const size_t offset = level.fileOffset + (size_t(ty)*level.tilesX+tx)*TILE_BYTES;
+        if (!writeAt(tile.data(),TILE_BYTES,offset))
+          THROW_RUNTIME_ERROR("error writing texture cache file for "+fileName.str());
+      }
+    }
+  }
+
+  /*! 2x2 box filter of RGBA8 texels */
+  static void downsample(const unsigned int* src, int width, int height, unsigned int* dst, int dstWidth, int dstHeight)
+  {
+    for (int y=0; y<dstHeight; y++)
+    {
+      const int y0 = min(2*y+0,height-1);
+      const int y1 = min(2*y+1,height-1);
+      for (int x=0; x<dstWidth; x++)
+      {
+        const int x0 = min(2*x+0,width-1);
+        const int x1 = min(2*x+1,width-1);
+        const unsigned int c0 = src[size_t(y0)*width+x0], c1 = src[size_t(y0)*width+x1];
+        const unsigned int c2 = src[size_t(y1)*width+x0], c3 = src[size_t(y1)*width+x1];
+        unsigned int c = 0;
+        for (int i=0; i<32; i+=8) {
+          const unsigned int sum = ((c0>>i)&0xFF) + ((c1>>i)&0xFF) + ((c2>>i)&0xFF) + ((c3>>i)&0xFF);
+          c |= ((sum+2)/4) << i;
+        }
+        dst[size_t(y)*dstWidth+x] = c;
+      }
+    }
+  }
+
+  void TextureCache::Entry::init()
+  {
+    Lock<MutexSys> lock(mutex);
+    if (initialized.load(std::memory_order_acquire))
+      return;
+
+    /* wait until a decode slot is free */
+    {
+      Lock<MutexSys> lock(g_decodeMutex);
+      g_decodeCondition.wait(g_decodeMutex,[&] () { return g_numDecodes < MAX_DECODES; });
+      g_numDecodes++;
+    }
+    
+    try 
+    {
+      std::vector<unsigned int> texels;
+      int width, height;
+      {
+        Ref<Image> image = loadImage(fileName);
+        width  = (int) image->width;
+        height = (int) image->height;
+        texels.resize(size_t(width)*size_t(height));
+        image->convertToRGBA8((unsigned char*)texels.data());
+      }
+
+      /* setup all levels and reserve their tiles in the backing file */
+      size_t numBytes = 0;
+      for (int w=width, h=height;; w=max(1,w/2), h=max(1,h/2))
+      {
+        Level level;
+        level.width  = w;
+        level.height = h;
+        level.tilesX = (w+TILE_SIZE-1)/TILE_SIZE;
+        level.tilesY = (h+TILE_SIZE-1)/TILE_SIZE;
+        level.fileOffset = numBytes;
+        const size_t numTiles = size_t(level.tilesX)*size_t(level.tilesY);
+        level.tiles = new std::atomic<Tile*>[numTiles];
+        for (size_t i=0; i<numTiles; i++) level.tiles[i].store(nullptr);
+        levels.push_back(level);
+        numBytes += numTiles*TILE_BYTES;
+        if (w == 1 && h == 1) break;
+      }
+      const size_t fileOffset = allocFile(numBytes);
+      for (size_t i=0; i<levels.size(); i++)
+        levels[i].fileOffset += fileOffset;
+
+      /* write the mip pyramid */
+      std::vector<unsigned int> next;
+      for (size_t i=0; i<levels.size(); i++)
+      {
+        writeLevel(levels[i],texels.data(),fileName);
+        if (i+1 == levels.size()) break;
+        next.resize(size_t(levels[i+1].width)*size_t(levels[i+1].height));
+        downsample(texels.data(),levels[i].width,levels[i].height,next.data(),levels[i+1].width,levels[i+1].height);
+        texels.swap(next);
+      }
+    }
+    catch (const std::exception& e)
+    {
+      /* lookups run inside render tasks (and ISPC code) thus must not throw,
+       * the texture gets reported once and returns a constant texel afterwards */
+      std::cerr << "Error: " << e.what() << std::endl;
+      for (size_t i=0; i<levels.size(); i++)
+        delete[] levels[i].tiles;
+      levels.clear();
+      failed = true;
+    }
+
+    {
+      Lock<MutexSys> lock(g_decodeMutex);
+      g_numDecodes--;
+      g_decodeCondition.notify_all();
+    }
+
+    initialized.store(true,std::memory_order_release);
+  }
+
+  void TextureCache::setMemoryBudget(size_t bytes)
+  {
+    Lock<MutexSys> lock(g_mutex);
+    g_enabled = true;
+    g_memoryBudget = max(bytes,2*sizeof(Tile));
+  }
+
+  bool TextureCache::enabled() {
+    return g_enabled;
+  }
+
+  TextureCache::Entry* TextureCache::add(const FileName& fileName)
+  {
+    /* the image gets decoded lazily, thus catch missing and broken files already here */
+    checkImageHeader(fileName);
+
+    Lock<MutexSys> lock(g_mutex);
+    g_entries.push_back(std::unique_ptr<Entry>(new Entry(fileName)));
+    return g_entries.back().get();
+  }
+
+  void TextureCache::beginTask()
+  {
+    TextureCacheThread* thread = t_thread;
+    if (unlikely(thread == nullptr))
+    {
+      thread = t_thread = new TextureCacheThread;
+      TextureCacheThread* head = g_threads.load();
+      do { thread->next = head; } while (!g_threads.compare_exchange_weak(head,thread));
+    }
+
+    /* the sequentially consistent store orders the epoch before all tile reads of the task */
+    if (thread->depth++ == 0)
+      thread->epoch.store(g_epoch.load());
+  }
+
+  void TextureCache::endTask()
+  {
+    TextureCacheThread* thread = t_thread;
+    if (--thread->depth == 0)
+      thread->epoch.store(0,std::memory_order_release);
+  }
+
+  unsigned int TextureCache::texel(Entry* entry, float s, float t, int l)
+  {
+    Task task;
+    TextureCacheThread* thread = t_thread;
+
+    /* the thread references no tiles between lookups, thus the epoch of the task can advance */
+    const size_t epoch = g_epoch.load();
+    if (thread->epoch.load(std::memory_order_relaxed) != epoch)
+      thread->epoch.store(epoch);
+
+    /* the decode can take long, thus do not hold back freeing tiles meanwhile */
+    if (unlikely(!entry->initialized.load(std::memory_order_acquire)))
+    {
+      thread->epoch.store(0,std::memory_order_release);
+      entry->init();
+      thread->epoch.store(g_epoch.load());
+    }
+    if (unlikely(entry->failed))
+      return FAILED_TEXEL;
+
+    l = clamp(l,0,(int)entry->levels.size()-1);
+    const Level& level = entry->levels[l];
+    int iu = (int)floorf(s * (float)(level.width));
+    iu = iu % level.width; if (iu < 0) iu += level.width;
+    int iv = (int)floorf(t * (float)(level.height));
+    iv = iv % level.height; if (iv < 0) iv += level.height;
+
+    const size_t index = size_t(iv/TILE_SIZE)*level.tilesX + iu/TILE_SIZE;
+    const size_t texelIndex = (iv%TILE_SIZE)*TILE_SIZE + iu%TILE_SIZE;
+    Tile* tile = level.tiles[index].load();
+    if (unlikely(tile == nullptr))
+      return load(entry,l,index,texelIndex);
+
+    /* only write the time stamp when it changes to keep hits free of shared writes */
+    const size_t time = g_time.load(std::memory_order_relaxed);
+    if (tile->lastUse.load(std::memory_order_relaxed) != time)
+      tile->lastUse.store(time,std::memory_order_relaxed);
+
+    return tile->texels[texelIndex];
+  }
+
+  unsigned int TextureCache::load(Entry* entry, int l, size_t index, size_t texelIndex)
+  {
+    /* the texel gets taken from the private copy of the tile, thus the thread
+     * references no shared tile and does not hold back freeing tiles while it
+     * waits for the lock */
+    TextureCacheThread* thread = t_thread;
+    thread->epoch.store(0,std::memory_order_release);
+
+    /* read the tile without holding any lock */
+    Level& level = entry->levels[l];
+    std::unique_ptr<Tile> tile(new Tile(entry,l,index));
+    if (!readAt(tile->texels,TILE_BYTES,level.fileOffset+index*TILE_BYTES)) {
+      thread->epoch.store(g_epoch.load());
+      return FAILED_TEXEL;
+    }
+    const unsigned int texel = tile->texels[texelIndex];
+    tile->lastUse.store(++g_time);
+
+    /* install the tile unless another thread loaded it in the meantime */
+    Tile* expected = nullptr;
+    if (level.tiles[index].compare_exchange_strong(expected,tile.get()))
+    {
+      Lock<MutexSys> lock(g_mutex);
+      g_resident.push_back(tile.release());
+      g_memoryUsed += sizeof(Tile);
+      if (g_memoryUsed > g_memoryBudget) {
+        reclaim();
+        if (g_resident.size()*sizeof(Tile) > g_memoryBudget - g_memoryBudget/4) 
+          evict();
+      }
+    }
+
+    /* evicted tiles that render tasks may still read get freed when the tasks
+     * advance, wait for them if these tiles exceed the budget */
+    while (g_memoryUsed > 2*g_memoryBudget) 
+    {
+      yield();
+      Lock<MutexSys> lock(g_mutex);
+      reclaim();
+    }
+
+    thread->epoch.store(g_epoch.load());
+    return texel;
+  }
+
+  void TextureCache::evict()
+  {
+    /* sort a snapshot of the time stamps, lookups keep updating them */
+    std::vector<std::pair<size_t,Tile*>> order(g_resident.size());
+    for (size_t i=0; i<g_resident.size(); i++)
+      order[i] = std::make_pair(g_resident[i]->lastUse.load(std::memory_order_relaxed),g_resident[i]);
+    std::sort(order.begin(),order.end(),[] (const std::pair<size_t,Tile*>& a, const std::pair<size_t,Tile*>& b) {
+        return a.first < b.first;
+      });
+
+    /* evict resident tiles down to 1/2 of the budget to amortize the sort, always keeping the most
+     * recent tile. Evicting more would not help, retired tiles only get freed when no task reads them. */
+    const size_t target = g_memoryBudget/2;
+    const size_t epoch = g_epoch.load();
+    size_t numEvicted = 0;
+    while ((order.size()-numEvicted)*sizeof(Tile) > target && numEvicted+1 < order.size())
+    {
+      Tile* tile = order[numEvicted++].second;
+      tile->entry->levels[tile->level].tiles[tile->index].store(nullptr);
+      tile->retireEpoch = epoch;
+      g_retired.push_back(tile);
+    }
+
+    g_resident.clear();
+    for (size_t i=numEvicted; i<order.size(); i++)
+      g_resident.push_back(order[i].second);
+
+    /* tasks that begin from now on cannot see the evicted tiles anymore */
+    g_epoch++;
+    reclaim();
+  }
+
+  void TextureCache::reclaim()
+  {
+    /* tiles evicted before the oldest running task began can get freed */
+    size_t minEpoch = g_epoch.load();
+    for (TextureCacheThread* thread = g_threads.load(); thread; thread = thread->next) {
+      const size_t epoch = thread->epoch.load();
+      if (epoch && epoch < minEpoch) minEpoch = epoch;
+    }
+
+    size_t numRetired = 0;
+    for (size_t i=0; i<g_retired.size(); i++)
+    {
+      Tile* tile = g_retired[i];
+      if (tile->retireEpoch < minEpoch) {
+        delete tile;
+        g_memoryUsed -= sizeof(Tile);
+      }
+      else
+        g_retired[numRetired++] = tile;
+    }
+    g_retired.resize(numRetired);
+  }
+
+  void TextureCache::collect()
+  {
+    Lock<MutexSys> lock(g_mutex);
+    reclaim();
+  }
+
+  size_t TextureCache::memoryUsed() {
+    return g_memoryUsed;
+  }
+
+  extern "C" unsigned int getTextureCacheTexel(void* entry, float s, float t, int level) {
+    return TextureCache::texel((TextureCache::Entry*)entry,s,t,level);
+  }
+
+  extern "C" void beginTextureCacheTask() {
+    TextureCache::beginTask();
+  }
+
+  extern "C" void endTextureCacheTask() {
+    TextureCache::endTask();
+  }
+}
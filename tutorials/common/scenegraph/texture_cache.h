@@ -0,0 +1,132 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "../default.h"
+#include "../../../common/sys/mutex.h"
+
+#include <atomic>
+
+namespace embree
+{
+  /*! Tiled and mip-mapped texture cache with a fixed memory budget. A
+   *  texture added to the cache is not decoded before its first
+   *  lookup. At that point the image is converted once into a tiled
+   *  RGBA8 mip pyramid that is written to a temporary backing file
+   *  shared by all textures, and only the tiles that are actually
+   *  fetched are read back. Once the tiles in memory exceed the budget
+   *  the least recently used ones get evicted. Lookups of resident
+   *  tiles do not take any lock, evicted tiles are freed as soon as
+   *  all render tasks that may still read them have finished. */
+  class TextureCache
+  {
+  public:
+
+    static const int TILE_SIZE = 64;
+
+    /*! maximal number of textures that get decoded at the same time */
+    static const size_t MAX_DECODES = 2;
+
+    /*! texel returned by lookups into textures that could not get loaded */
+    static const unsigned int FAILED_TEXEL = 0xFFFFFFFF;
+
+    struct Entry;
+
+    /*! tile of RGBA8 texels of one mip level */
+    struct Tile
+    {
+      Tile (Entry* entry, int level, size_t index)
+        : entry(entry), level(level), index(index), lastUse(0), retireEpoch(0) {}
+
+    public:
+      Entry* entry;                  //!< texture this tile belongs to
+      int level;                     //!< mip level of the tile
+      size_t index;                  //!< index of the tile inside its level
+      std::atomic<size_t> lastUse;   //!< cache time of the last lookup
+      size_t retireEpoch;            //!< epoch in which the tile got evicted
+      unsigned int texels[TILE_SIZE*TILE_SIZE];
+    };
+
+    /*! one level of the mip pyramid */
+    struct Level
+    {
+      int width, height;
+      int tilesX, tilesY;
+      size_t fileOffset;             //!< offset of the first tile in the backing file
+      std::atomic<Tile*>* tiles;     //!< resident tiles, nullptr if not loaded
+    };
+
+    /*! per texture state */
+    struct Entry
+    {
+      Entry (const FileName& fileName);
+      ~Entry ();
+
+      /*! decodes the image and writes its mip pyramid to the backing file, marks the entry as failed instead of throwing */
+      void init();
+
+    public:
+      FileName fileName;
+      std::atomic<bool> initialized;
+      bool failed;                   //!< decoding failed, lookups return FAILED_TEXEL
+      MutexSys mutex;
+      std::vector<Level> levels;
+    };
+
+    /*! marks a render task of the calling thread, tiles evicted while
+     *  the task runs are not freed before it ended */
+    struct Task
+    {
+      Task ()  { beginTask(); }
+      ~Task () { endTask(); }
+    };
+
+  public:
+
+    /*! enables the cache with a budget of bytes of tiles in memory */
+    static void setMemoryBudget(size_t bytes);
+
+    /*! returns true if textures get loaded through the cache */
+    static bool enabled();
+
+    /*! adds a texture to the cache, the image is loaded lazily, throws if the file cannot be opened or has an invalid header */
+    static Entry* add(const FileName& fileName);
+
+    /*! returns the RGBA8 texel of some mip level at texture coordinates s and t, never throws */
+    static unsigned int texel(Entry* entry, float s, float t, int level);
+
+    /*! begins and ends a render task of the calling thread, tasks can get nested */
+    static void beginTask();
+    static void endTask();
+
+    /*! frees the evicted tiles no render task can read anymore */
+    static void collect();
+
+    /*! returns the number of bytes of tiles in memory */
+    static size_t memoryUsed();
+
+  private:
+    static unsigned int load(Entry* entry, int level, size_t index, size_t texelIndex);
+    static void evict();
+    static void reclaim();
+  };
+
+  /*! texel lookup and render task markers callable from ISPC */
+  extern "C" unsigned int getTextureCacheTexel(void* entry, float s, float t, int level);
+  extern "C" void beginTextureCacheTask();
+  extern "C" void endTextureCacheTask();
+}
@@ -261,11 +261,14 @@ namespace embree
   private:
     template<typename T> T load(const Ref<XML>& xml) { assert(false); return T(zero); }
     template<typename T> T load(const Ref<XML>& xml, const T& opt) { assert(false); return T(zero); }
-    char* loadBinary(const Ref<XML>& xml, size_t eltSize, size_t& size);
+    const char* loadBinary(const Ref<XML>& xml, size_t eltSize, size_t& size);
+    const char* loadBinary(size_t ofs, size_t bytes);
+    void freeBinary(const char* data, size_t bytes);
 
     std::vector<float> loadFloatArray(const Ref<XML>& xml);
     std::vector<Vec2f> loadVec2fArray(const Ref<XML>& xml);
     std::vector<Vec3f> loadVec3fArray(const Ref<XML>& xml);
+    void loadVec3faArray(const Ref<XML>& xml, avector<Vec3fa>& res);
     avector<Vec3fa> loadVec4fArray(const Ref<XML>& xml);
     std::vector<int>   loadIntArray(const Ref<XML>& xml);
     std::vector<Vec2i> loadVec2iArray(const Ref<XML>& xml);
@@ -276,6 +279,8 @@ namespace embree
     FileName path;         //!< path to XML file
     FILE* binFile;         //!< .bin file for reading binary data
     FileName binFileName;  //!< name of the .bin file
+    char* binMem;          //!< .bin file mapped into memory, nullptr if mapping failed
+    size_t binBytes;       //!< size of the mapped .bin file
 
   private:
     std::map<std::string,Ref<SceneGraph::MaterialNode> > materialMap;     //!< named materials
@@ -394,24 +399,46 @@ namespace embree
     }
   }
 
-  char* XMLLoader::loadBinary(const Ref<XML>& xml, size_t eltSize, size_t& size)
+  const char* XMLLoader::loadBinary(const Ref<XML>& xml, size_t eltSize, size_t& size)
   {
+    const size_t ofs = strtoull(xml->parm("ofs").c_str(),nullptr,10);
+    size = strtoull(xml->parm("size").c_str(),nullptr,10);
+    if (size == 0) size = strtoull(xml->parm("num").c_str(),nullptr,10); // version for BGF format
+    return loadBinary(ofs,size*eltSize);
+  }
+
+  const char* XMLLoader::loadBinary(size_t ofs, size_t bytes)
+  {
+    /* hand out a slice of the mapped .bin file without copying */
+    if (binMem) {
+      if (ofs > binBytes || bytes > binBytes-ofs)
+        THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
+      return binMem+ofs;
+    }
+
+    /* fall back to reading the data if the file could not get mapped */
     if (!binFile) 
       THROW_RUNTIME_ERROR("cannot open file "+binFileName.str()+" for reading");
 
-    size_t ofs = atol(xml->parm("ofs").c_str());
     fseek(binFile,long(ofs),SEEK_SET);
 
-    size = atol(xml->parm("size").c_str());
-    if (size == 0) size = atol(xml->parm("num").c_str()); // version for BGF format
-    char* data = (char*) alignedMalloc(size*eltSize);
-
-    if (size != fread(data, eltSize, size, binFile)) 
+    char* data = (char*) alignedMalloc(bytes);
+    if (bytes != fread(data, 1, bytes, binFile)) 
       THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
 
     return data;
   }
 
+  void XMLLoader::freeBinary(const char* data, size_t bytes)
+  {
+    /* slices of the mapped .bin file are converted exactly once, thus their pages can get dropped right away */
+    if (binMem && data >= binMem && data < binMem+binBytes) {
+      os_release_file_pages((void*)data,bytes);
+      return;
+    }
+    alignedFree((void*)data);
+  }
+
   std::vector<float> XMLLoader::loadFloatArray(const Ref<XML>& xml)
   {
     /*! do not fail of array does not exist */
@@ -428,9 +455,8 @@ namespace embree
       for (size_t i=0; i<size; i++) 
         data[i] = xml->body[i].Float();
     }
-    std::vector<float> res;
-    for (size_t i=0; i<size; i++) res.push_back(data[i]);
-    alignedFree(data);
+    std::vector<float> res(data,data+size);
+    freeBinary((const char*)data,size*sizeof(float));
     return res;
   }
 
@@ -451,9 +477,8 @@ namespace embree
       for (size_t i=0; i<size; i++) 
         data[i] = Vec2f(xml->body[2*i+0].Float(),xml->body[2*i+1].Float());
     }
-    std::vector<Vec2f> res;
-    for (size_t i=0; i<size; i++) res.push_back(data[i]);
-    alignedFree(data);
+    std::vector<Vec2f> res(data,data+size);
+    freeBinary((const char*)data,size*2*sizeof(float));
     return res;
   }
 
@@ -475,9 +500,8 @@ namespace embree
       for (size_t i=0; i<size; i++) 
         data[i] = Vec3f(xml->body[3*i+0].Float(),xml->body[3*i+1].Float(),xml->body[3*i+2].Float());
     }
-    std::vector<Vec3f> res;
-    for (size_t i=0; i<size; i++) res.push_back(data[i]);
-    alignedFree(data);
+    std::vector<Vec3f> res(data,data+size);
+    freeBinary((const char*)data,size*3*sizeof(float));
     return res;
   }
 
@@ -499,12 +523,36 @@ namespace embree
       for (size_t i=0; i<size; i++) 
         data[i] = Vec3fa(xml->body[4*i+0].Float(),xml->body[4*i+1].Float(),xml->body[4*i+2].Float(),xml->body[4*i+3].Float());
     }
-    avector<Vec3fa> res;
-    for (size_t i=0; i<size; i++) res.push_back(data[i]);
-    alignedFree(data);
+    /* slices of the mapped .bin file are not necessarily 16 byte aligned */
+    avector<Vec3fa> res(size);
+    memcpy(res.data(),data,size*sizeof(Vec3fa));
+    freeBinary((const char*)data,size*4*sizeof(float));
     return res;
   }
 
+  void XMLLoader::loadVec3faArray(const Ref<XML>& xml, avector<Vec3fa>& res)
+  {
+    /*! do not fail of array does not exist */
+    res.clear();
+    if (!xml) return;
+
+    /* converts directly from the .bin file to avoid an intermediate array */
+    if (xml->parm("ofs") != "") 
+    {
+      size_t size = 0;
+      const Vec3f* data = (const Vec3f*) loadBinary(xml,3*sizeof(float),size);
+      res.resize(size);
+      for (size_t i=0; i<size; i++) res[i] = Vec3fa(data[i].x,data[i].y,data[i].z);
+      freeBinary((const char*)data,size*3*sizeof(float));
+    }
+    else 
+    {
+      const std::vector<Vec3f> data = loadVec3fArray(xml);
+      res.resize(data.size());
+      for (size_t i=0; i<data.size(); i++) res[i] = Vec3fa(data[i].x,data[i].y,data[i].z);
+    }
+  }
+
   std::vector<int> XMLLoader::loadIntArray(const Ref<XML>& xml)
   {
     /*! do not fail of array does not exist */
@@ -521,9 +569,8 @@ namespace embree
       for (size_t i=0; i<size; i++) 
         data[i] = xml->body[i].Int();
     }
-    std::vector<int> res;
-    for (size_t i=0; i<size; i++) res.push_back(data[i]);
-    alignedFree(data);
+    std::vector<int> res(data,data+size);
+    freeBinary((const char*)data,size*sizeof(int));
     return res;
   }
 
@@ -545,9 +592,8 @@ namespace embree
       for (size_t i=0; i<size; i++) 
         data[i] = Vec2i(xml->body[2*i+0].Int(),xml->body[2*i+1].Int());
     }
-    std::vector<Vec2i> res;
-    for (size_t i=0; i<size; i++) res.push_back(data[i]);
-    alignedFree(data);
+    std::vector<Vec2i> res(data,data+size);
+    freeBinary((const char*)data,size*2*sizeof(int));
     return res;
   }
 
@@ -569,9 +615,8 @@ namespace embree
       for (size_t i=0; i<size; i++) 
         data[i] = Vec3i(xml->body[3*i+0].Int(),xml->body[3*i+1].Int(),xml->body[3*i+2].Int());
     }
-    std::vector<Vec3i> res;
-    for (size_t i=0; i<size; i++) res.push_back(data[i]);
-    alignedFree(data);
+    std::vector<Vec3i> res(data,data+size);
+    freeBinary((const char*)data,size*3*sizeof(int));
     return res;
   }
 
@@ -593,9 +638,8 @@ namespace embree
       for (size_t i=0; i<size; i++) 
         data[i] = Vec4i(xml->body[4*i+0].Int(),xml->body[4*i+1].Int(),xml->body[4*i+2].Int(),xml->body[4*i+3].Int());
     }
-    std::vector<Vec4i> res;
-    for (size_t i=0; i<size; i++) res.push_back(data[i]);
-    alignedFree(data);
+    std::vector<Vec4i> res(data,data+size);
+    freeBinary((const char*)data,size*4*sizeof(int));
     return res;
   }
 
@@ -687,8 +731,10 @@ namespace embree
       const Texture::Format format = Texture::string_to_format(xml->parm("format"));
       const size_t bytesPerTexel = Texture::getFormatBytesPerTexel(format);
       texture = new Texture(width,height,format);
-      if (width*height != fread(texture->data, bytesPerTexel, width*height, binFile)) 
-        THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
+      const size_t ofs = strtoull(xml->parm("ofs").c_str(),nullptr,10);
+      const char* data = loadBinary(ofs,width*height*bytesPerTexel);
+      memcpy(texture->data,data,width*height*bytesPerTexel);
+      freeBinary(data,width*height*bytesPerTexel);
     }
     
     if (id != "") textureMap[id] = texture;
@@ -851,18 +897,15 @@ namespace embree
   Ref<SceneGraph::Node> XMLLoader::loadTriangleMesh(const Ref<XML>& xml) 
   {
     Ref<SceneGraph::MaterialNode> material = loadMaterial(xml->child("material"));
-    std::vector<Vec3f> positions = loadVec3fArray(xml->childOpt("positions"));
-    std::vector<Vec3f> positions2= loadVec3fArray(xml->childOpt("positions2"));
-    std::vector<Vec3f> normals   = loadVec3fArray(xml->childOpt("normals"  ));
-    std::vector<Vec2f> texcoords = loadVec2fArray(xml->childOpt("texcoords"));
     std::vector<Vec3i> triangles = loadVec3iArray(xml->childOpt("triangles"));
 
     SceneGraph::TriangleMeshNode* mesh = new SceneGraph::TriangleMeshNode(material);
-    for (size_t i=0; i<positions.size(); i++) mesh->v.push_back(positions[i]);
-    for (size_t i=0; i<positions2.size();i++) mesh->v2.push_back(positions2[i]);
-    for (size_t i=0; i<normals.size();   i++) mesh->vn.push_back(normals[i]);
-    for (size_t i=0; i<texcoords.size(); i++) mesh->vt.push_back(texcoords[i]);
-    for (size_t i=0; i<triangles.size(); i++) mesh->triangles.push_back(SceneGraph::TriangleMeshNode::Triangle(triangles[i].x,triangles[i].y,triangles[i].z));
+    loadVec3faArray(xml->childOpt("positions" ),mesh->v);
+    loadVec3faArray(xml->childOpt("positions2"),mesh->v2);
+    loadVec3faArray(xml->childOpt("normals"   ),mesh->vn);
+    mesh->vt = loadVec2fArray(xml->childOpt("texcoords"));
+    mesh->triangles.resize(triangles.size());
+    for (size_t i=0; i<triangles.size(); i++) mesh->triangles[i] = SceneGraph::TriangleMeshNode::Triangle(triangles[i].x,triangles[i].y,triangles[i].z);
     mesh->verify();
     return mesh;
   }
@@ -870,18 +913,15 @@ namespace embree
   Ref<SceneGraph::Node> XMLLoader::loadQuadMesh(const Ref<XML>& xml) 
   {
     Ref<SceneGraph::MaterialNode> material = loadMaterial(xml->child("material"));
-    std::vector<Vec3f> positions = loadVec3fArray(xml->childOpt("positions"));
-    std::vector<Vec3f> positions2= loadVec3fArray(xml->childOpt("positions2"));
-    std::vector<Vec3f> normals   = loadVec3fArray(xml->childOpt("normals"  ));
-    std::vector<Vec2f> texcoords = loadVec2fArray(xml->childOpt("texcoords"));
     std::vector<Vec4i> indices   = loadVec4iArray(xml->childOpt("indices"));
 
     SceneGraph::QuadMeshNode* mesh = new SceneGraph::QuadMeshNode(material);
-    for (size_t i=0; i<positions.size(); i++) mesh->v.push_back(positions[i]);
-    for (size_t i=0; i<positions2.size();i++) mesh->v2.push_back(positions2[i]);
-    for (size_t i=0; i<normals.size();   i++) mesh->vn.push_back(normals[i]);
-    for (size_t i=0; i<texcoords.size(); i++) mesh->vt.push_back(texcoords[i]);
-    for (size_t i=0; i<indices.size();   i++) mesh->quads.push_back(SceneGraph::QuadMeshNode::Quad(indices[i].x,indices[i].y,indices[i].z,indices[i].w));
+    loadVec3faArray(xml->childOpt("positions" ),mesh->v);
+    loadVec3faArray(xml->childOpt("positions2"),mesh->v2);
+    loadVec3faArray(xml->childOpt("normals"   ),mesh->vn);
+    mesh->vt = loadVec2fArray(xml->childOpt("texcoords"));
+    mesh->quads.resize(indices.size());
+    for (size_t i=0; i<indices.size(); i++) mesh->quads[i] = SceneGraph::QuadMeshNode::Quad(indices[i].x,indices[i].y,indices[i].z,indices[i].w);
     mesh->verify();
     return mesh;
   }
@@ -891,12 +931,9 @@ namespace embree
     Ref<SceneGraph::MaterialNode> material = loadMaterial(xml->child("material"));
 
     SceneGraph::SubdivMeshNode* mesh = new SceneGraph::SubdivMeshNode(material);
-    std::vector<Vec3f> positions = loadVec3fArray(xml->childOpt("positions"));
-    for (size_t i=0; i<positions.size(); i++) mesh->positions.push_back(positions[i]);
-    std::vector<Vec3f> positions2 = loadVec3fArray(xml->childOpt("positions2"));
-    for (size_t i=0; i<positions2.size(); i++) mesh->positions2.push_back(positions2[i]);
-    std::vector<Vec3f> normals = loadVec3fArray(xml->childOpt("normals"));
-    for (size_t i=0; i<normals.size(); i++) mesh->normals.push_back(normals[i]);
+    loadVec3faArray(xml->childOpt("positions" ),mesh->positions);
+    loadVec3faArray(xml->childOpt("positions2"),mesh->positions2);
+    loadVec3faArray(xml->childOpt("normals"   ),mesh->normals);
     mesh->texcoords = loadVec2fArray(xml->childOpt("texcoords"));
     mesh->position_indices = loadIntArray(xml->childOpt("position_indices"));
     mesh->normal_indices   = loadIntArray(xml->childOpt("normal_indices"));
@@ -1186,7 +1223,7 @@ namespace embree
     XMLLoader loader(fileName,space); return loader.root;
   }
 
-  XMLLoader::XMLLoader(const FileName& fileName, const AffineSpace3fa& space) : binFile(nullptr), currentNodeID(0)
+  XMLLoader::XMLLoader(const FileName& fileName, const AffineSpace3fa& space) : binFile(nullptr), binMem(nullptr), binBytes(0), currentNodeID(0)
   {
     path = fileName.path();
     binFileName = fileName.setExt(".bin");
@@ -1196,6 +1233,10 @@ namespace embree
       binFile = fopen(binFileName.c_str(),"rb");
     }
 
+    /* map the .bin file once, pages are only read when the data gets converted */
+    if (binFile)
+      binMem = (char*) os_map_file(binFileName.c_str(),binBytes);
+
     Ref<XML> xml = parseXML(fileName);
     if (xml->name == "scene") 
     {
@@ -1221,7 +1262,9 @@ namespace embree
     root = new SceneGraph::TransformNode(space,root);
   }
 
-  XMLLoader::~XMLLoader() {
+  XMLLoader::~XMLLoader() 
+  {
+    if (binMem) os_unmap_file(binMem,binBytes);
     if (binFile) fclose(binFile);
   }
 
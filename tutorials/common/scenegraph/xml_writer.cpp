@@ -161,7 +161,7 @@ namespace embree
 
     if (textureMap.find(tex) != textureMap.end()) {
       tab(); fprintf(xml,"<texture3d name=\"%s\" id=\"%zu\"/>\n",name,textureMap[tex]);
-    } else if (embedTextures) {
+    } else if (embedTextures && tex->data) {
       const long int offset = ftell(bin);
       fwrite(tex->data,tex->width*tex->height,tex->bytesPerTexel,bin);
       const size_t id = textureMap[tex] = currentNodeID++;
@@ -19,6 +19,7 @@
 #include "../../common/tutorial/scene.h"
 #include "../../common/tutorial/tutorial_device.h"
 #include "../../common/tutorial/scene_device.h"
+#include "../../common/scenegraph/texture_cache.h"
 #include "../../../include/embree2/rtcore.h"
 
 extern "C" int64_t get_tsc() {
@@ -90,8 +91,13 @@ namespace embree
     return device_pick(x,y,camera,hitPos);
   }
 
+  size_t num_rays() {
+    return device_num_rays();
+  }
+
   void render(const float time, const ISPCCamera& camera) {
     device_render(g_pixels,g_width,g_height,time,camera);
+    TextureCache::collect();
   }
 
   int* map () {
@@ -43,6 +43,7 @@ namespace embree
   extern "C" void device_set_scene(Scene* scene);
   extern "C" void device_resize(int width, int height);
   extern "C" bool device_pick(const float x, const float y, const ISPCCamera& camera, Vec3fa& hitPos);
+  extern "C" size_t device_num_rays();
 
   extern "C" void device_render(int* pixels, const int width, const int height,
                                 const float time, const ISPCCamera& camera);
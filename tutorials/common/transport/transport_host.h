@@ -42,6 +42,9 @@ namespace embree
   /* pick event */
   bool pick(const float x, const float y, const ISPCCamera& camera, Vec3fa& hitPos);
 
+  /* number of rays traced so far */
+  size_t num_rays();
+
   /* render frame and map framebuffer */
   void render(const float time, const ISPCCamera& camera);
 
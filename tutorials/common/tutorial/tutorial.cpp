@@ -226,6 +226,10 @@ namespace embree
       "  geometry: instance individual geometries\n"
       "  scene_geometry: instance individual geometries as scenes\n"
       "  scene_group: instance geometry groups as scenes");
+
+    registerOption("texture-cache", [this] (Ref<ParseStream> cin, const FileName& path) {
+        TextureCache::setMemoryBudget(size_t(cin->getInt())*1024*1024);
+      }, "--texture-cache <MB>: loads textures lazily through a tiled texture cache that keeps at most <MB> megabytes of tiles resident");
     
     registerOption("ambientlight", [this] (Ref<ParseStream> cin, const FileName& path) {
         const Vec3fa L = cin->getVec3fa();
@@ -425,6 +429,8 @@ namespace embree
 
     //Statistics stat;
     FilteredStatistics stat(0.5f,0.0f);
+    size_t numRays = 0;
+    double renderTime = 0.0;
     for (size_t j=0; j<numBenchmarkRepetitions; j++)
     {
       size_t numTotalFrames = skipBenchmarkFrames + numBenchmarkFrames;
@@ -439,9 +445,12 @@ namespace embree
       
       for (size_t i=skipBenchmarkFrames; i<numTotalFrames; i++) 
       {
+        size_t r0 = num_rays();
         double t0 = getSeconds();
         render(0.0f,ispccamera);
         double t1 = getSeconds();
+        numRays += num_rays()-r0;
+        renderTime += t1-t0;
 
         float fr = 1.0f/(t1-t0);
         stat.add(fr);
@@ -474,7 +483,9 @@ namespace embree
     std::cout << "BENCHMARK_RENDER_AVG " << stat.getAvg() << std::endl;
     std::cout << "BENCHMARK_RENDER_MAX " << stat.getMax() << std::endl;
     std::cout << "BENCHMARK_RENDER_SIGMA " << stat.getSigma() << std::endl;
-    std::cout << "BENCHMARK_RENDER_AVG_SIGMA " << stat.getAvgSigma() << std::endl << std::flush;
+    std::cout << "BENCHMARK_RENDER_AVG_SIGMA " << stat.getAvgSigma() << std::endl;
+    if (numRays) std::cout << "BENCHMARK_RENDER_MRAYS_PER_SECOND " << 1E-6*double(numRays)/renderTime << std::endl;
+    std::cout << std::flush;
     if (benchmarkSleep) sleepSeconds(0.1);
   }
 
@@ -774,10 +785,14 @@ namespace embree
     postParseCommandLine();
 
     /* load scene */
+    double t0 = getSeconds();
     if (toLowerCase(sceneFilename.ext()) == std::string("obj"))
       scene->add(loadOBJ(sceneFilename,subdiv_mode != ""));
     else if (sceneFilename.ext() != "")
       scene->add(SceneGraph::load(sceneFilename));
+    double t1 = getSeconds();
+    if (numBenchmarkFrames && sceneFilename.ext() != "")
+      std::cout << "BENCHMARK_LOAD " << t1-t0 << std::endl;
 
     /* convert triangles to quads */
     if (convert_tris_to_quads)
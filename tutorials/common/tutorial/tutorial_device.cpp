@@ -18,7 +18,8 @@
 #include "../scenegraph/texture.h"
 #include "scene_device.h"
 
-/* the scene to render */
+/* the device and scene to render */
+extern RTCDevice g_device;
 extern RTCScene g_scene;
 
 /* global subdivision level for subdivision geometry */
@@ -690,6 +691,14 @@ extern "C" bool device_pick(const float x,
   }
 }
 
+/* returns the number of rays traced by the device so far, the statistics
+ * only count active rays, thus masked lanes of ray packets are not included */
+extern "C" size_t device_num_rays()
+{
+  if (g_device == nullptr) return 0;
+  return rtcDeviceGetParameter1i(g_device,RTC_STAT_RAYS_INTERSECTED) + rtcDeviceGetParameter1i(g_device,RTC_STAT_RAYS_OCCLUDED);
+}
+
 /* called when a key is pressed */
 extern "C" void device_key_pressed_default(int key)
 {
@@ -998,6 +1007,11 @@ float getTextureTexel1f(const Texture* texture, float s, float t)
   if (texture == nullptr) 
     return 0.0f;
 
+  if (texture->cache) {
+    const unsigned int c = getTextureCacheTexel(texture->cache,s,t,0);
+    return (float)(c & 0xFF) * (1.0f/255.0f);
+  }
+
   int iu = (int)floorf(s * (float)(texture->width));
   iu = iu % texture->width; if (iu < 0) iu += texture->width;
   int iv = (int)floorf(t * (float)(texture->height));
@@ -1021,6 +1035,11 @@ Vec3f getTextureTexel3f(const Texture* texture, float s, float t)
   if (texture == nullptr)
     return Vec3f(0.0f);
 
+  if (texture->cache) {
+    const unsigned int c = getTextureCacheTexel(texture->cache,s,t,0);
+    return Vec3f( (float)((c >> 0) & 0xFF) * 1.0f/255.0f, (float)((c >> 8) & 0xFF) * 1.0f/255.0f, (float)((c >> 16) & 0xFF) * 1.0f/255.0f );
+  }
+
   int iu = (int)floorf(s * (float)(texture->width));
   iu = iu % texture->width; if (iu < 0) iu += texture->width;
   int iv = (int)floorf(t * (float)(texture->height));
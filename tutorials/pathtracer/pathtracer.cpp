@@ -23,7 +23,7 @@ namespace embree
   struct Tutorial : public SceneLoadingTutorialApplication
   {
     Tutorial()
-      : SceneLoadingTutorialApplication("pathtracer",FEATURE_RTCORE) {}
+      : SceneLoadingTutorialApplication("pathtracer",FEATURE_RTCORE | FEATURE_STREAM) {}
     
     void postParseCommandLine() 
     {
@@ -34,6 +34,10 @@ namespace embree
       }
       
       g_instancing_mode = instancing_mode;
+
+      /* fetch textures through the texture cache unless configured otherwise */
+      if (!TextureCache::enabled())
+        TextureCache::setMemoryBudget(size_t(1024)*1024*1024);
     }
   };
 
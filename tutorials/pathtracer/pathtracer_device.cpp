@@ -27,6 +27,11 @@
 #define TILE_SIZE_X 4
 #define TILE_SIZE_Y 4
 
+/* tile size of the stream mode */
+#define STREAM_TILE_SIZE_X 16
+#define STREAM_TILE_SIZE_Y 16
+#define STREAM_SIZE (STREAM_TILE_SIZE_X*STREAM_TILE_SIZE_Y)
+
 #define FIXED_SAMPLING 0
 #define SAMPLES_PER_PIXEL 1
 
@@ -1068,6 +1073,8 @@ RTCScene convertScene(ISPCScene* scene_in)
     scene_flags = RTC_SCENE_DYNAMIC | RTC_SCENE_INCOHERENT | RTC_SCENE_ROBUST;
 
   scene_aflags |= RTC_INTERPOLATE;
+  if (g_mode != MODE_NORMAL)
+    scene_aflags |= RTC_INTERSECT_STREAM;
 
   RTCScene scene_out = rtcDeviceNewScene(g_device,(RTCSceneFlags)scene_flags, (RTCAlgorithmFlags) scene_aflags);
 
@@ -1653,6 +1660,280 @@ void renderTileStandard(int taskIndex,
   }
 }
 
+/* renders a single screen tile in stream mode, the paths of all
+ * pixels of the tile are traced together one bounce after the other */
+void renderTileStandardStream(int taskIndex,
+                              int* pixels,
+                              const int width,
+                              const int height,
+                              const float time,
+                              const ISPCCamera& camera,
+                              const int numTilesX,
+                              const int numTilesY)
+{
+  const int tileY = taskIndex / numTilesX;
+  const int tileX = taskIndex - tileY * numTilesX;
+  const int x0 = tileX * STREAM_TILE_SIZE_X;
+  const int x1 = min(x0+STREAM_TILE_SIZE_X,width);
+  const int y0 = tileY * STREAM_TILE_SIZE_Y;
+  const int y1 = min(y0+STREAM_TILE_SIZE_Y,height);
+
+  /* path state of all pixels of the tile */
+  RTCRay ray_stream[STREAM_SIZE/1];
+  RandomSampler sampler_stream[STREAM_SIZE/1];
+  DifferentialGeometry dg_stream[STREAM_SIZE/1];
+  BRDF brdf_stream[STREAM_SIZE/1];
+  Medium medium_stream[STREAM_SIZE/1];
+  Sample3f wi_stream[STREAM_SIZE/1];
+  int materialID_stream[STREAM_SIZE/1];
+  Vec3fa c_stream[STREAM_SIZE/1];
+  Vec3fa Ls_stream[STREAM_SIZE/1];
+  Vec3fa L_stream[STREAM_SIZE/1];
+  Vec3fa Lw_stream[STREAM_SIZE/1];
+  Vec3fa color_stream[STREAM_SIZE/1];
+  bool valid_stream[STREAM_SIZE/1];
+
+  /* dense stream of the rays that actually get traced and the paths they belong to */
+  RTCRay trace_stream[STREAM_SIZE/1];
+  int path_stream[STREAM_SIZE/1];
+
+  int numMaterials = g_ispc_scene->numMaterials;
+  ISPCMaterial* material_array = &g_ispc_scene->materials[0];
+
+  /* select stream mode */
+  RTCIntersectContext context;
+  context.flags = g_mode == MODE_STREAM_COHERENT ? RTC_INTERSECT_COHERENT : RTC_INTERSECT_INCOHERENT;
+  context.userRayExt = nullptr;
+
+  int N = 0;
+  for (int y=y0; y<y1; y++) for (int x=x0; x<x1; x++)
+  {
+    /* ISPC workaround for mask == 0 */
+    if (all(1 == 0)) continue;
+    color_stream[N] = Vec3fa(0.0f);
+    N++;
+  }
+
+  for (int s=0; s<SAMPLES_PER_PIXEL; s++)
+  {
+    /* generate stream of primary rays */
+    int numActive = 0;
+    N = 0;
+    for (int y=y0; y<y1; y++) for (int x=x0; x<x1; x++)
+    {
+      /* ISPC workaround for mask == 0 */
+      if (all(1 == 0)) continue;
+      numActive++;
+
+      RandomSampler& sampler = sampler_stream[N];
+      RandomSampler_init(sampler, x, y, g_accu_count*SAMPLES_PER_PIXEL+s);
+      float fx = x + RandomSampler_get1D(sampler);
+      float fy = y + RandomSampler_get1D(sampler);
+
+      L_stream[N] = Vec3fa(0.0f);
+      Lw_stream[N] = Vec3fa(1.0f);
+      medium_stream[N] = make_Medium_Vacuum();
+      bool mask = 1; { valid_stream[N] = mask; }
+
+      /* initialize ray */
+      RTCRay& ray = ray_stream[N];
+      ray = RTCRay(Vec3fa(camera.xfm.p),
+                     Vec3fa(normalize(fx*camera.xfm.l.vx + fy*camera.xfm.l.vy + camera.xfm.l.vz)),0.0f,inf,RandomSampler_get1D(sampler));
+      N++;
+    }
+
+    /* iterative path tracer loop, each iteration traces one bounce of all active paths */
+    for (int i=0; i<MAX_PATH_LENGTH && numActive; i++)
+    {
+      /* compact the rays of all active paths into a dense stream */
+      int M = 0;
+      N = -1;
+      for (int y=y0; y<y1; y++) for (int x=x0; x<x1; x++)
+      {
+        N++;
+        /* ISPC workaround for mask == 0 */
+        if (all(1 == 0)) continue;
+        if (valid_stream[N] == false) continue;
+        trace_stream[M] = ray_stream[N];
+        path_stream[M] = N;
+        M++;
+      }
+      N++;
+
+      /* intersect stream of rays with scene */
+      rtcIntersect1M(g_scene,&context,(RTCRay*)&trace_stream,M,sizeof(RTCRay));
+
+      /* scatter hits back to the paths */
+      for (int m=0; m<M; m++)
+        ray_stream[path_stream[m]] = trace_stream[m];
+
+      /* shade hit points and sample the BRDFs */
+      N = -1;
+      for (int y=y0; y<y1; y++) for (int x=x0; x<x1; x++)
+      {
+        N++;
+        /* ISPC workaround for mask == 0 */
+        if (all(1 == 0)) continue;
+        if (valid_stream[N] == false) continue;
+
+        RTCRay& ray = ray_stream[N];
+        DifferentialGeometry& dg = dg_stream[N];
+        const Vec3fa wo = neg(ray.dir);
+
+        /* invoke environment lights if nothing hit */
+        if (ray.geomID == RTC_INVALID_GEOMETRY_ID)
+        {
+          for (size_t l=0; l<g_ispc_scene->numLights; l++)
+          {
+            const Light* light = g_ispc_scene->lights[l];
+            Light_EvalRes le = light->eval(light,dg,ray.dir);
+            L_stream[N] = L_stream[N] + Lw_stream[N]*le.value;
+          }
+          valid_stream[N] = false;
+          continue;
+        }
+        Vec3fa Ns = normalize(ray.Ng);
+
+        if (g_use_smooth_normals)
+          if (ray.geomID != RTC_INVALID_GEOMETRY_ID) // FIXME: workaround for ISPC bug, location reached with empty execution mask
+        {
+          Vec3fa dPdu,dPdv;
+          int geomID = ray.geomID; {
+            rtcInterpolate(g_scene,geomID,ray.primID,ray.u,ray.v,RTC_VERTEX_BUFFER0,nullptr,&dPdu.x,&dPdv.x,3);
+          }
+          Ns = normalize(cross(dPdv,dPdu));
+        }
+
+        /* compute differential geometry */
+        dg.geomID = ray.geomID;
+        dg.primID = ray.primID;
+        dg.u = ray.u;
+        dg.v = ray.v;
+        dg.P  = ray.org+ray.tfar*ray.dir;
+        dg.Ng = ray.Ng;
+        dg.Ns = Ns;
+        int materialID = postIntersect(ray,dg);
+        dg.Ng = face_forward(ray.dir,normalize(dg.Ng));
+        dg.Ns = face_forward(ray.dir,normalize(dg.Ns));
+        materialID_stream[N] = materialID;
+
+        /*! Compute  simple volumetric effect. */
+        Vec3fa c = Vec3fa(1.0f);
+        const Vec3fa transmission = medium_stream[N].transmission;
+        if (ne(transmission,Vec3fa(1.0f)))
+          c = c * pow(transmission,ray.tfar);
+
+        /* calculate BRDF */
+        Material__preprocess(material_array,materialID,numMaterials,brdf_stream[N],wo,dg,medium_stream[N]);
+
+        /* sample BRDF at hit point */
+        c_stream[N] = c * Material__sample(material_array,materialID,numMaterials,brdf_stream[N],Lw_stream[N],wo,dg,wi_stream[N],medium_stream[N],RandomSampler_get2D(sampler_stream[N]));
+      }
+      N++;
+
+      /* trace one stream of shadow rays per light */
+      for (size_t l=0; l<g_ispc_scene->numLights; l++)
+      {
+        const Light* light = g_ispc_scene->lights[l];
+
+        /* setup a dense stream of shadow rays for all paths that sampled the light */
+        int M = 0;
+        N = -1;
+        for (int y=y0; y<y1; y++) for (int x=x0; x<x1; x++)
+        {
+          N++;
+          /* ISPC workaround for mask == 0 */
+          if (all(1 == 0)) continue;
+          if (valid_stream[N] == false) continue;
+
+          const DifferentialGeometry& dg = dg_stream[N];
+          Light_SampleRes ls = light->sample(light,dg,RandomSampler_get2D(sampler_stream[N]));
+          if (ls.pdf <= 0.0f) continue;
+
+          /* the light contribution gets weighted by the transparency of the shadow ray */
+          const Vec3fa wo = neg(ray_stream[N].dir);
+          Ls_stream[N] = Lw_stream[N]*ls.weight*Material__eval(material_array,materialID_stream[N],numMaterials,brdf_stream[N],wo,dg,ls.dir);
+          trace_stream[M] = RTCRay(dg.P,ls.dir,dg.tnear_eps,ls.dist,ray_stream[N].time);
+          trace_stream[M].transparency = Vec3fa(1.0f);
+          path_stream[M] = N;
+          M++;
+        }
+        N++;
+
+        /* trace stream of shadow rays */
+        rtcOccluded1M(g_scene,&context,(RTCRay*)&trace_stream,M,sizeof(RTCRay));
+
+        /* add light contribution */
+        for (int m=0; m<M; m++)
+        {
+          const int n = path_stream[m];
+          const Vec3fa transparency = trace_stream[m].transparency;
+          if (max(max(transparency.x,transparency.y),transparency.z) > 0.0f)
+            L_stream[n] = L_stream[n] + Ls_stream[n]*transparency;
+        }
+      }
+
+      /* generate stream of secondary rays */
+      numActive = 0;
+      N = -1;
+      for (int y=y0; y<y1; y++) for (int x=x0; x<x1; x++)
+      {
+        N++;
+        /* ISPC workaround for mask == 0 */
+        if (all(1 == 0)) continue;
+
+        /* rays of terminated paths do not get traced anymore */
+        if (valid_stream[N] == false) continue;
+        RTCRay& ray = ray_stream[N];
+        const float ray_time = ray.time;
+
+        const Sample3f wi1 = wi_stream[N];
+        if (wi1.pdf <= 1E-4f /* 0.0f */) { valid_stream[N] = false; continue; }
+        Lw_stream[N] = Lw_stream[N]*c_stream[N]/wi1.pdf;
+
+        /* terminate if contribution too low */
+        const Vec3fa Lw = Lw_stream[N];
+        if (max(Lw.x,max(Lw.y,Lw.z)) < 0.01f) { valid_stream[N] = false; continue; }
+
+        /* setup secondary ray */
+        DifferentialGeometry& dg = dg_stream[N];
+        float sign = dot(wi1.v,dg.Ng) < 0.0f ? -1.0f : 1.0f;
+        dg.P = dg.P + sign*dg.tnear_eps*dg.Ng;
+        ray = RTCRay(dg.P,normalize(wi1.v),dg.tnear_eps,inf,ray_time);
+        numActive++;
+      }
+      N++;
+    }
+
+    /* accumulate radiance of this sample */
+    N = 0;
+    for (int y=y0; y<y1; y++) for (int x=x0; x<x1; x++)
+    {
+      /* ISPC workaround for mask == 0 */
+      if (all(1 == 0)) continue;
+      color_stream[N] = color_stream[N] + L_stream[N];
+      N++;
+    }
+  }
+
+  /* write colors to framebuffer */
+  N = 0;
+  for (int y=y0; y<y1; y++) for (int x=x0; x<x1; x++)
+  {
+    /* ISPC workaround for mask == 0 */
+    if (all(1 == 0)) continue;
+    Vec3fa color = color_stream[N]*(1.0f/SAMPLES_PER_PIXEL);
+    N++;
+
+    Vec3fa accu_color = g_accu[y*width+x] + Vec3fa(color.x,color.y,color.z,1.0f); g_accu[y*width+x] = accu_color;
+    float f = rcp(max(0.001f,accu_color.w));
+    unsigned int r = (unsigned int) (255.0f * clamp(accu_color.x*f,0.0f,1.0f));
+    unsigned int g = (unsigned int) (255.0f * clamp(accu_color.y*f,0.0f,1.0f));
+    unsigned int b = (unsigned int) (255.0f * clamp(accu_color.z*f,0.0f,1.0f));
+    pixels[y*width+x] = (b << 16) + (g << 8) + r;
+  }
+}
+
 /* task that renders a single screen tile */
 void renderTileTask (int taskIndex, int* pixels,
                          const int width,
@@ -1662,7 +1943,9 @@ void renderTileTask (int taskIndex, int* pixels,
                          const int numTilesX,
                          const int numTilesY)
 {
+  beginTextureCacheTask();
   renderTile(taskIndex,pixels,width,height,time,camera,numTilesX,numTilesY);
+  endTextureCacheTask();
 }
 
 
@@ -1765,7 +2048,8 @@ extern "C" void device_init (char* cfg)
   rtcDeviceSetErrorFunction(g_device,error_handler);
 
   /* set start render mode */
-  renderTile = renderTileStandard;
+  if (g_mode == MODE_NORMAL) renderTile = renderTileStandard;
+  else                       renderTile = renderTileStandardStream;
   key_pressed_handler = device_key_pressed;
 
 #if ENABLE_FILTER_FUNCTION == 0
@@ -1826,8 +2110,11 @@ extern "C" void device_render (int* pixels,
   }
 
   /* render image */
-  const int numTilesX = (width +TILE_SIZE_X-1)/TILE_SIZE_X;
-  const int numTilesY = (height+TILE_SIZE_Y-1)/TILE_SIZE_Y;
+  const bool stream = renderTile == renderTileStandardStream;
+  const int tileSizeX = stream ? STREAM_TILE_SIZE_X : TILE_SIZE_X;
+  const int tileSizeY = stream ? STREAM_TILE_SIZE_Y : TILE_SIZE_Y;
+  const int numTilesX = (width +tileSizeX-1)/tileSizeX;
+  const int numTilesY = (height+tileSizeY-1)/tileSizeY;
   parallel_for(size_t(0),size_t(numTilesX*numTilesY),[&](const range<size_t>& range) {
     for (size_t i=range.begin(); i<range.end(); i++)
       renderTileTask(i,pixels,width,height,time,camera,numTilesX,numTilesY);